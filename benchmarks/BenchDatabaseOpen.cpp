@@ -0,0 +1,83 @@
+/**
+ * @file BenchDatabaseOpen.cpp
+ * @brief Mede a abertura do banco pelo DatabaseManager
+ *
+ * Uso: bench_database_open [músicas] [repetições]
+ *
+ * Compara a abertura de um banco que já está na versão mais recente, que
+ * só lê o PRAGMA user_version, com a abertura de um arquivo vazio, que
+ * aplica todas as migrações. O banco atual recebe uma biblioteca sintética
+ * com o número de músicas pedido.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-06
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "core/bd/DatabaseManager.hpp"
+
+#include "SyntheticLibrary.hpp"
+
+namespace {
+    /**
+     * @brief Mede a duração média de uma operação em milissegundos
+     */
+    double measure(int repetitions, const std::function<void()>& operation) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i)
+            operation();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repetitions;
+    }
+
+    void removeDatabase(const std::string& path) {
+        for (const char* suffix : {"", "-wal", "-shm"})
+            std::filesystem::remove(path + suffix);
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int songs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 50;
+
+    auto directory = std::filesystem::temp_directory_path();
+    auto current = (directory / "frankenstein_bench_open.db").string();
+    auto empty = (directory / "frankenstein_bench_open_empty.db").string();
+    removeDatabase(current);
+
+    {
+        core::DatabaseManager db_manager(current, "");
+        bench::LibrarySize size;
+        size.songs = static_cast<size_t>(songs);
+        bench::generateLibrary(*db_manager.getDatabase(), size);
+    }
+
+    double open_current = measure(repetitions, [&]() {
+        core::DatabaseManager db_manager(current, "");
+    });
+
+    double open_empty = measure(repetitions, [&]() {
+        removeDatabase(empty);
+        core::DatabaseManager db_manager(empty, "");
+    });
+
+    std::cout << songs << " músicas, " << repetitions << " aberturas (ms por abertura)\n"
+              << std::fixed << std::setprecision(3)
+              << std::left << std::setw(32) << "banco na versão atual" << std::right
+              << std::setw(12) << open_current << "\n"
+              << std::left << std::setw(32) << "arquivo vazio, todas as migrações"
+              << std::right << std::setw(12) << open_empty << "\n";
+
+    removeDatabase(current);
+    removeDatabase(empty);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file BenchDirectoryScan.cpp
+ * @brief Compara a varredura dos diretórios de entrada com
+ *        recursive_directory_iterator e com o DirectoryScanner
+ *
+ * Uso: bench_directory_scan [arquivos] [threads] [repetições]
+ *
+ * Gera uma árvore sintética no diretório temporário, no formato
+ * artista/álbum/faixa, com 10 faixas e uma capa por álbum e 10 álbuns por
+ * artista, e mede a listagem com e sem o stat() da impressão de cada
+ * arquivo, que é o que a importação incremental faz. Cada caso roda uma
+ * vez para aquecer o cache de diretórios e o menor tempo é mostrado.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-05
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/DirectoryScanner.hpp"
+#include "core/util/FileFingerprint.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const size_t TRACKS_PER_ALBUM = 10;
+    const size_t ALBUMS_PER_ARTIST = 10;
+
+    /**
+     * @brief Cria a árvore sintética
+     * @return Número de faixas criadas
+     */
+    size_t generateTree(const fs::path& root, size_t files) {
+        fs::remove_all(root);
+
+        size_t created = 0;
+        for (size_t artist = 0; created < files; ++artist) {
+            for (size_t album = 0; album < ALBUMS_PER_ARTIST && created < files; ++album) {
+                fs::path dir = root / ("Artista " + std::to_string(artist))
+                               / ("Album " + std::to_string(album));
+                fs::create_directories(dir);
+
+                for (size_t track = 0; track < TRACKS_PER_ALBUM && created < files; ++track) {
+                    std::ofstream(dir / ("Faixa " + std::to_string(track) + ".mp3")) << "ID3";
+                    created++;
+                }
+                std::ofstream(dir / "capa.jpg") << "JPG";
+            }
+        }
+
+        return created;
+    }
+
+    /**
+     * @brief Menor tempo, em milissegundos, entre as repetições
+     */
+    double measure(int repetitions, const std::function<size_t()>& operation, size_t& found) {
+        found = operation();
+
+        double best = 0.0;
+        for (int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            found = operation();
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    bool isMp3(const fs::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".mp3";
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t files = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+    int repetitions = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    fs::path root = fs::temp_directory_path() / "frankenstein_bench_scan";
+    auto start = std::chrono::steady_clock::now();
+    files = generateTree(root, files);
+    std::chrono::duration<double> generation = std::chrono::steady_clock::now() - start;
+    std::cerr << files << " faixas geradas em " << generation.count() << " s" << std::endl;
+
+    std::string rootPath = root.string();
+
+    // Como a importação listava o diretório: status() por entrada
+    auto iterator = [&](bool fingerprint) {
+        size_t count = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            if (!fs::is_regular_file(entry.status()) || !isMp3(entry.path()))
+                continue;
+            if (fingerprint && !core::FileFingerprint::stat(entry.path().string()))
+                continue;
+            count++;
+        }
+        return count;
+    };
+
+    auto scanner = [&](size_t scan_threads, bool fingerprint) {
+        core::DirectoryScanner directoryScanner({"mp3"}, scan_threads);
+        std::atomic<size_t> count(0);
+        directoryScanner.scan(rootPath, [&](const std::string& path) {
+            if (!fingerprint || core::FileFingerprint::stat(path))
+                count++;
+            return true;
+        });
+        return count.load();
+    };
+
+    struct Case {
+        std::string name;
+        std::function<size_t()> operation;
+    };
+    std::string parallel = "scanner " + std::to_string(threads) + "t";
+    std::vector<Case> cases = {
+        {"recursive_directory_iterator", [&]() { return iterator(false); }},
+        {"scanner 1t", [&]() { return scanner(1, false); }},
+    };
+    // Com uma thread os casos paralelos repetiriam os de 1t
+    if (threads > 1)
+        cases.push_back({parallel, [&]() { return scanner(threads, false); }});
+    cases.push_back({"iterator + stat", [&]() { return iterator(true); }});
+    cases.push_back({"scanner 1t + stat", [&]() { return scanner(1, true); }});
+    if (threads > 1)
+        cases.push_back({parallel + " + stat", [&]() { return scanner(threads, true); }});
+
+    std::cout << repetitions << " repetições, " << files << " faixas (menor tempo)\n"
+              << std::left << std::setw(34) << "caso" << std::right << std::setw(12)
+              << "ms" << std::setw(12) << "arquivos" << "\n"
+              << std::fixed << std::setprecision(1);
+
+    for (const auto& benchCase : cases) {
+        size_t found = 0;
+        double ms = measure(repetitions, benchCase.operation, found);
+        std::cout << std::left << std::setw(34) << benchCase.name << std::right
+                  << std::setw(12) << ms << std::setw(12) << found << "\n";
+    }
+
+    fs::remove_all(root);
+    return 0;
+}
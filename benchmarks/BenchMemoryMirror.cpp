@@ -0,0 +1,142 @@
+/**
+ * @file BenchMemoryMirror.cpp
+ * @brief Compara a latência das consultas com o banco em disco e com a
+ *        cópia em memória
+ *
+ * Uso: bench_memory_mirror [músicas] [repetições]
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/SummaryRepository.hpp"
+
+#include "SyntheticLibrary.hpp"
+
+namespace {
+    const int ARTISTS = 500;
+
+    /**
+     * @brief Mede a latência média de uma operação em microssegundos
+     */
+    double measure(int repetitions, const std::function<void(int)>& operation) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i)
+            operation(i);
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repetitions;
+    }
+
+    struct Result {
+        double by_ids;
+        double search;
+        double aggregate;
+        double write;
+        double flush;
+    };
+
+    Result run(const std::string& path, bool mirror, int songs, int repetitions) {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = mirror;
+        core::DatabaseManager db_manager(path, "", settings);
+
+        auto reader = db_manager.getReader();
+        core::SummaryRepository summaries(reader);
+        std::mt19937 random(42);
+        std::uniform_int_distribution<unsigned> any_song(1, static_cast<unsigned>(songs));
+
+        Result result {};
+        result.by_ids = measure(repetitions, [&](int) {
+            std::vector<unsigned> ids(64);
+            for (auto& id : ids)
+                id = any_song(random);
+            summaries.songsByIds(ids);
+        });
+
+        result.search = measure(repetitions, [&](int i) {
+            summaries.searchSongs(bench::songTitle(static_cast<size_t>(i % 100)), 1);
+        });
+
+        SQLite::Statement query(*reader,
+                                "SELECT COUNT(*), SUM(duration) FROM songs "
+                                "WHERE artist_id = ?;");
+        result.aggregate = measure(repetitions, [&](int i) {
+            query.reset();
+            query.bind(1, 1 + i % ARTISTS);
+            query.executeStep();
+        });
+
+        auto writer = db_manager.getDatabase();
+        SQLite::Statement update(*writer,
+                                 "UPDATE songs SET play_count = play_count + 1 "
+                                 "WHERE id = ?;");
+        result.write = measure(repetitions, [&](int i) {
+            update.reset();
+            update.bind(1, 1 + i % songs);
+            update.exec();
+        });
+
+        // Uma gravação só, que copia o banco inteiro para o arquivo
+        result.flush = measure(1, [&](int) { db_manager.flushMirror(); });
+        return result;
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int songs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 2000;
+
+    auto path = (std::filesystem::temp_directory_path()
+                 / "frankenstein_bench_mirror.db")
+                    .string();
+    for (const char* suffix : {"", "-wal", "-shm"})
+        std::filesystem::remove(path + suffix);
+
+    {
+        core::DatabaseManager db_manager(path, "");
+        bench::LibrarySize size;
+        size.songs = static_cast<size_t>(songs);
+        size.artists = ARTISTS;
+        size.albums = 2000;
+        size.history = 0;
+        size.playlists = 0;
+        bench::generateLibrary(*db_manager.getDatabase(), size);
+    }
+
+    Result disk = run(path, false, songs, repetitions);
+    Result memory = run(path, true, songs, repetitions);
+
+    std::cout << songs << " músicas, " << repetitions << " repetições (µs por operação)\n"
+              << std::left << std::setw(24) << "operação" << std::right
+              << std::setw(12) << "disco" << std::setw(12) << "memória" << "\n"
+              << std::fixed << std::setprecision(2);
+
+    auto row = [](const char* name, double a, double b) {
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::setw(12) << a << std::setw(12) << b << "\n";
+    };
+    row("songsByIds (64)", disk.by_ids, memory.by_ids);
+    row("searchSongs", disk.search, memory.search);
+    row("agregado por artista", disk.aggregate, memory.aggregate);
+    row("update play_count", disk.write, memory.write);
+    row("flushMirror", disk.flush, memory.flush);
+
+    for (const char* suffix : {"", "-wal", "-shm"})
+        std::filesystem::remove(path + suffix);
+    return 0;
+}
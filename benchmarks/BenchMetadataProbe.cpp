@@ -0,0 +1,168 @@
+/**
+ * @file BenchMetadataProbe.cpp
+ * @brief Compara a leitura dos metadados como era feita na importação
+ *        (duas aberturas com AudioProperties::Average) com a leitura
+ *        única em AudioProperties::Average e com a leitura única em
+ *        AudioProperties::Fast
+ *
+ * A coluna "1x Average" isola o ganho de abrir o arquivo uma só vez; a
+ * razão entre ela e "1x Fast" é o que sobra para o modo rápido.
+ *
+ * Uso: bench_metadata_probe diretório [repetições]
+ *
+ * O diretório é percorrido recursivamente; o resultado é separado por
+ * extensão para que MP3, FLAC e OGG possam ser comparados.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <taglib/fileref.h>
+#include <taglib/tag.h>
+
+namespace {
+    /**
+     * @brief Campos lidos por arquivo, acumulados para o compilador não
+     *        descartar a leitura
+     */
+    struct Probe {
+        uint64_t checksum = 0;
+        size_t readable = 0;
+    };
+
+    /**
+     * @brief Leitura anterior: um FileRef para testar o áudio e outro para
+     *        as tags, ambos com a precisão padrão
+     */
+    void twoOpensAverage(const std::string& path, Probe& probe) {
+        TagLib::FileRef test(path.c_str());
+        if (test.isNull() || !test.audioProperties())
+            return;
+
+        TagLib::FileRef file(path.c_str());
+        if (file.isNull() || !file.tag())
+            return;
+
+        probe.readable++;
+        probe.checksum += !file.tag()->title().isEmpty() + file.tag()->year()
+                          + static_cast<uint64_t>(file.audioProperties()->lengthInSeconds());
+    }
+
+    /**
+     * @brief Um único FileRef com a precisão padrão, para separar o efeito
+     *        da abertura única do efeito do modo rápido
+     */
+    void oneOpenAverage(const std::string& path, Probe& probe) {
+        TagLib::FileRef file(path.c_str());
+        if (file.isNull() || !file.audioProperties() || !file.tag())
+            return;
+
+        probe.readable++;
+        probe.checksum += !file.tag()->title().isEmpty() + file.tag()->year()
+                          + static_cast<uint64_t>(file.audioProperties()->lengthInSeconds());
+    }
+
+    /**
+     * @brief Leitura atual: um FileRef em modo rápido, com taxas e tamanho
+     */
+    void oneOpenFast(const std::string& path, Probe& probe) {
+        TagLib::FileRef file(path.c_str(), true, TagLib::AudioProperties::Fast);
+        if (file.isNull() || !file.audioProperties() || !file.tag())
+            return;
+
+        TagLib::AudioProperties* properties = file.audioProperties();
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(path, error);
+
+        probe.readable++;
+        probe.checksum += !file.tag()->title().isEmpty() + file.tag()->year()
+                          + static_cast<uint64_t>(properties->lengthInSeconds())
+                          + static_cast<uint64_t>(properties->bitrate())
+                          + static_cast<uint64_t>(properties->sampleRate())
+                          + (error ? 0 : size);
+    }
+
+    /**
+     * @brief Mede o tempo médio por arquivo em microssegundos
+     */
+    double measure(const std::vector<std::string>& files,
+                   int repetitions,
+                   const std::function<void(const std::string&, Probe&)>& read,
+                   Probe& probe) {
+        // Uma passada fora da medição, para todos os casos partirem do cache
+        // de páginas já preenchido
+        Probe warmup;
+        for (const auto& path : files)
+            read(path, warmup);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            for (const auto& path : files)
+                read(path, probe);
+        }
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (static_cast<double>(repetitions) * files.size());
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Uso: " << argv[0] << " diretório [repetições]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path root(argv[1]);
+    int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::map<std::string, std::vector<std::string>> by_extension;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file())
+            continue;
+
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        by_extension[extension].push_back(entry.path().string());
+    }
+
+    std::cout << repetitions << " repetições (µs por arquivo)\n"
+              << std::left << std::setw(10) << "extensão" << std::right
+              << std::setw(10) << "arquivos" << std::setw(16) << "2x Average"
+              << std::setw(16) << "1x Average" << std::setw(16) << "1x Fast"
+              << std::setw(10) << "Fast" << "\n"
+              << std::fixed << std::setprecision(1);
+
+    for (const auto& [extension, files] : by_extension) {
+        Probe before;
+        Probe single;
+        Probe after;
+        double old_us = measure(files, repetitions, twoOpensAverage, before);
+        double single_us = measure(files, repetitions, oneOpenAverage, single);
+        double new_us = measure(files, repetitions, oneOpenFast, after);
+        if (after.readable == 0)
+            continue;
+
+        // Ganho só do modo rápido, sobre a leitura que já abre uma vez
+        std::cout << std::left << std::setw(10) << extension << std::right
+                  << std::setw(10) << files.size() << std::setw(16) << old_us
+                  << std::setw(16) << single_us << std::setw(16) << new_us
+                  << std::setw(9) << (new_us > 0 ? single_us / new_us : 0.0) << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file BenchRunner.hpp
+ * @brief Medição dos casos de benchmark e saída em JSON
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace bench {
+
+    /**
+     * @brief Executa casos de benchmark e guarda a distribuição dos tempos
+     *
+     * Cada caso roda uma vez para aquecer caches e depois `iterations`
+     * vezes, medindo cada execução separadamente.
+     */
+    class Runner {
+    private:
+        std::string _filter; /*!< @brief Só executa casos cujo nome contém o filtro */
+        nlohmann::json _results = nlohmann::json::array();
+
+        static double percentile(const std::vector<int64_t>& sorted, double p) {
+            if (sorted.empty())
+                return 0.0;
+            size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]);
+        }
+
+    public:
+        explicit Runner(std::string filter = "") : _filter(std::move(filter)) {}
+
+        /**
+         * @brief Mede um caso
+         * @param name Nome estável do caso, usado para comparar versões
+         * @param iterations Número de execuções medidas
+         * @param operation Operação medida; recebe o número da execução
+         * @param rows Linhas gravadas por execução; se maior que zero, o
+         *        resultado inclui a vazão em linhas por segundo (pela mediana)
+         */
+        void run(const std::string& name,
+                 size_t iterations,
+                 const std::function<void(size_t)>& operation,
+                 size_t rows = 0) {
+            if (!_filter.empty() && name.find(_filter) == std::string::npos)
+                return;
+
+            iterations = std::max<size_t>(iterations, 1);
+            operation(0);
+
+            std::vector<int64_t> samples;
+            samples.reserve(iterations);
+            for (size_t i = 0; i < iterations; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                operation(i);
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                samples.push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+
+            std::sort(samples.begin(), samples.end());
+            double total = 0.0;
+            for (auto sample : samples)
+                total += static_cast<double>(sample);
+
+            nlohmann::json result = {
+                {"name", name},
+                {"iterations", iterations},
+                {"mean_ns", total / static_cast<double>(iterations)},
+                {"min_ns", samples.front()},
+                {"p50_ns", percentile(samples, 0.50)},
+                {"p95_ns", percentile(samples, 0.95)},
+                {"max_ns", samples.back()}};
+
+            double p50 = result["p50_ns"].get<double>();
+            if (rows > 0 && p50 > 0.0) {
+                result["rows"] = rows;
+                result["rows_per_s"] = static_cast<double>(rows) * 1e9 / p50;
+            }
+            _results.push_back(result);
+
+            std::cerr << name << ": " << p50 / 1000.0 << " µs (p50)";
+            if (result.contains("rows_per_s"))
+                std::cerr << ", " << static_cast<int64_t>(result["rows_per_s"].get<double>())
+                          << " linhas/s";
+            std::cerr << std::endl;
+        }
+
+        /**
+         * @brief Obtém os resultados medidos até agora
+         * @return Vetor JSON com um objeto por caso
+         */
+        const nlohmann::json& results() const { return _results; }
+    };
+
+}  // namespace bench
@@ -0,0 +1,189 @@
+/**
+ * @file SyntheticLibrary.cpp
+ * @brief Implementação da geração de bibliotecas sintéticas
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#include "SyntheticLibrary.hpp"
+
+#include "core/bd/PlaylistRepository.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace bench {
+    namespace {
+        const char* GENRES[] = {"Samba", "MPB", "Rock", "Jazz", "Forró", "Bossa Nova"};
+
+        // 2024-01-01 00:00:00 UTC
+        const std::time_t HISTORY_START = 1704067200;
+        const std::time_t HISTORY_SPAN = 365 * 86400;
+
+        /**
+         * @brief ID do usuário dono de uma música
+         */
+        int ownerOf(size_t song_index) {
+            return song_index % 10 == 9 ? 2 : 1;
+        }
+    }  // namespace
+
+    LibrarySize LibrarySize::preset(const std::string& name) {
+        LibrarySize size;
+        if (name == "small")
+            return size;
+
+        if (name == "medium") {
+            size.songs = 100000;
+            size.artists = 20000;
+            size.albums = 50000;
+            size.history = 500000;
+            return size;
+        }
+
+        if (name == "large") {
+            size.songs = 1000000;
+            size.artists = 20000;
+            size.albums = 50000;
+            size.history = 5000000;
+            return size;
+        }
+
+        throw std::invalid_argument("Tamanho desconhecido: " + name);
+    }
+
+    nlohmann::json LibrarySize::toJson() const {
+        return {{"songs", songs},
+                {"artists", artists},
+                {"albums", albums},
+                {"history", history},
+                {"playlists", playlists},
+                {"playlist_songs", playlist_songs}};
+    }
+
+    std::string artistName(size_t index) {
+        return "Artista " + std::to_string(index);
+    }
+
+    std::string songTitle(size_t index) {
+        return "Música " + std::to_string(index);
+    }
+
+    std::string albumTitle(size_t index) {
+        return "Álbum " + std::to_string(index);
+    }
+
+    void generateLibrary(SQLite::Database& db,
+                         const LibrarySize& size,
+                         unsigned seed) {
+        std::mt19937 random(seed);
+        size_t artists = std::max<size_t>(size.artists, 1);
+        size_t albums = std::max<size_t>(size.albums, 1);
+
+        SQLite::Transaction transaction(db);
+
+        db.exec("INSERT INTO users (id, username, uid, home_path, input_path) VALUES "
+                "(1, 'bench', '1000', '/tmp/bench', '/tmp/bench/input'), "
+                "(2, 'bench_outro', '1001', '/tmp/outro', '/tmp/outro/input');");
+
+        SQLite::Statement artist(db,
+                                 "INSERT INTO artists (id, name, user_id) "
+                                 "VALUES (?, ?, 1);");
+        for (size_t i = 1; i <= artists; ++i) {
+            artist.bind(1, static_cast<int64_t>(i));
+            artist.bind(2, artistName(i));
+            artist.exec();
+            artist.reset();
+        }
+
+        SQLite::Statement album(db,
+                                "INSERT INTO albums (id, title, release_year, genre, user_id) "
+                                "VALUES (?, ?, ?, ?, 1);");
+        SQLite::Statement album_artist(db,
+                                       "INSERT INTO album_artists "
+                                       "(album_id, artist_id, user_id, is_principal) "
+                                       "VALUES (?, ?, 1, 1);");
+        for (size_t i = 1; i <= albums; ++i) {
+            album.bind(1, static_cast<int64_t>(i));
+            album.bind(2, albumTitle(i));
+            album.bind(3, static_cast<int>(1960 + i % 65));
+            album.bind(4, GENRES[i % 6]);
+            album.exec();
+            album.reset();
+
+            album_artist.bind(1, static_cast<int64_t>(i));
+            album_artist.bind(2, static_cast<int64_t>(1 + i % artists));
+            album_artist.exec();
+            album_artist.reset();
+        }
+
+        SQLite::Statement song(db,
+                               "INSERT INTO songs (id, title, duration, track_number, "
+                               "album_id, artist_id, genre, user_id) "
+                               "VALUES (?, ?, ?, ?, ?, ?, ?, ?);");
+        std::uniform_int_distribution<int> duration(90, 480);
+        for (size_t i = 1; i <= size.songs; ++i) {
+            // As faixas de um álbum são consecutivas e do artista do álbum
+            size_t album_id = 1 + (i - 1) / 12 % albums;
+            song.bind(1, static_cast<int64_t>(i));
+            song.bind(2, songTitle(i));
+            song.bind(3, duration(random));
+            song.bind(4, static_cast<int>(1 + (i - 1) % 12));
+            song.bind(5, static_cast<int64_t>(album_id));
+            song.bind(6, static_cast<int64_t>(1 + album_id % artists));
+            song.bind(7, GENRES[album_id % 6]);
+            song.bind(8, ownerOf(i));
+            song.exec();
+            song.reset();
+        }
+
+        if (size.songs > 0) {
+            // Poucas músicas concentram a maior parte das reproduções
+            std::geometric_distribution<size_t> popular(
+                std::min(0.5, 8.0 / static_cast<double>(size.songs)));
+            std::uniform_int_distribution<std::time_t> when(0, HISTORY_SPAN);
+            SQLite::Statement history(db,
+                                      "INSERT INTO playback_history "
+                                      "(user_id, song_id, played_at, play_duration) "
+                                      "VALUES (?, ?, ?, ?);");
+            for (size_t i = 0; i < size.history; ++i) {
+                size_t song_index = 1 + popular(random) % size.songs;
+                history.bind(1, ownerOf(song_index));
+                history.bind(2, static_cast<int64_t>(song_index));
+                history.bind(3, static_cast<int64_t>(HISTORY_START + when(random)));
+                history.bind(4, duration(random));
+                history.exec();
+                history.reset();
+            }
+
+            SQLite::Statement playlist(db,
+                                       "INSERT INTO playlists (id, title, user_id) "
+                                       "VALUES (?, ?, 1);");
+            SQLite::Statement entry(db,
+                                    "INSERT OR IGNORE INTO playlist_songs "
+                                    "(playlist_id, song_id, position) VALUES (?, ?, ?);");
+            std::uniform_int_distribution<size_t> any_song(1, size.songs);
+            for (size_t p = 1; p <= size.playlists; ++p) {
+                playlist.bind(1, static_cast<int64_t>(p));
+                playlist.bind(2, "Playlist " + std::to_string(p));
+                playlist.exec();
+                playlist.reset();
+
+                for (size_t position = 0; position < size.playlist_songs; ++position) {
+                    entry.bind(1, static_cast<int64_t>(p));
+                    entry.bind(2, static_cast<int64_t>(any_song(random)));
+                    entry.bind(3, static_cast<int64_t>(position + 1) * PLAYLIST_POSITION_GAP);
+                    entry.exec();
+                    entry.reset();
+                }
+            }
+        }
+
+        transaction.commit();
+    }
+}  // namespace bench
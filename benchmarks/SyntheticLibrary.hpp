@@ -0,0 +1,74 @@
+/**
+ * @file SyntheticLibrary.hpp
+ * @brief Geração de bibliotecas sintéticas para os benchmarks
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <nlohmann/json.hpp>
+
+namespace bench {
+
+    /**
+     * @brief Tamanho de cada tabela da biblioteca gerada
+     */
+    struct LibrarySize {
+        size_t songs = 10000;
+        size_t artists = 1000;
+        size_t albums = 2500;
+        size_t history = 50000;
+        size_t playlists = 100;
+        size_t playlist_songs = 50; /*!< @brief Músicas por playlist */
+
+        /**
+         * @brief Obtém um tamanho pré-definido
+         * @param name "small", "medium" ou "large"
+         * @return Tamanho correspondente
+         * @throws std::invalid_argument se o nome for desconhecido
+         */
+        static LibrarySize preset(const std::string& name);
+
+        nlohmann::json toJson() const;
+    };
+
+    /**
+     * @brief Gera a biblioteca diretamente no banco, sem passar pelos
+     *        repositórios
+     *
+     * Os dados pertencem ao usuário de ID 1; um segundo usuário recebe um
+     * décimo das músicas para que os filtros por usuário tenham o que
+     * descartar. Os gatilhos do esquema (busca textual e estatísticas)
+     * continuam ativos, como em uma biblioteca real. A geração é
+     * determinística para uma mesma semente.
+     *
+     * @param db Conexão com um banco já migrado e vazio
+     * @param size Tamanho da biblioteca
+     * @param seed Semente do gerador pseudoaleatório
+     */
+    void generateLibrary(SQLite::Database& db,
+                         const LibrarySize& size,
+                         unsigned seed = 42);
+
+    /**
+     * @brief Nome do artista gerado com um índice
+     */
+    std::string artistName(size_t index);
+
+    /**
+     * @brief Título da música gerada com um índice
+     */
+    std::string songTitle(size_t index);
+
+    /**
+     * @brief Título do álbum gerado com um índice
+     */
+    std::string albumTitle(size_t index);
+
+}  // namespace bench
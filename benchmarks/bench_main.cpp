@@ -0,0 +1,302 @@
+/**
+ * @file bench_main.cpp
+ * @brief Benchmarks dos repositórios sobre uma biblioteca sintética
+ *
+ * Uso: frankenstein_bench [--preset small|medium|large] [--songs N]
+ *      [--artists N] [--albums N] [--history N] [--playlists N]
+ *      [--iterations N] [--filter texto] [--db caminho] [--output arquivo]
+ *
+ * O resultado é um JSON com o tamanho da biblioteca, a versão do SQLite e
+ * a distribuição dos tempos de cada caso, para comparação entre versões.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/HistoryPlayback.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "BenchRunner.hpp"
+#include "SyntheticLibrary.hpp"
+
+namespace {
+    struct Options {
+        bench::LibrarySize size;
+        size_t iterations = 1000;
+        std::string filter;
+        std::string db_path;
+        std::string output;
+    };
+
+    Options parseOptions(int argc, char* argv[]) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Valor ausente para " + arg);
+            std::string value = argv[++i];
+
+            if (arg == "--preset")
+                options.size = bench::LibrarySize::preset(value);
+            else if (arg == "--songs")
+                options.size.songs = std::stoul(value);
+            else if (arg == "--artists")
+                options.size.artists = std::stoul(value);
+            else if (arg == "--albums")
+                options.size.albums = std::stoul(value);
+            else if (arg == "--history")
+                options.size.history = std::stoul(value);
+            else if (arg == "--playlists")
+                options.size.playlists = std::stoul(value);
+            else if (arg == "--iterations")
+                options.iterations = std::stoul(value);
+            else if (arg == "--filter")
+                options.filter = value;
+            else if (arg == "--db")
+                options.db_path = value;
+            else if (arg == "--output")
+                options.output = value;
+            else
+                throw std::invalid_argument("Opção desconhecida: " + arg);
+        }
+        return options;
+    }
+
+    void removeDatabase(const std::string& path) {
+        for (const char* suffix : {"", "-wal", "-shm"})
+            std::filesystem::remove(path + suffix);
+    }
+
+    /**
+     * @brief Casos dos repositórios de músicas, álbuns e artistas
+     */
+    void benchCatalog(bench::Runner& runner,
+                      std::shared_ptr<SQLite::Database> db,
+                      const core::User& user,
+                      const Options& options) {
+        const auto& size = options.size;
+        size_t iterations = options.iterations;
+        // Consultas que leem a biblioteca inteira
+        size_t full_scans = std::max<size_t>(iterations / 100, 3);
+
+        std::mt19937 random(7);
+        std::uniform_int_distribution<size_t> any_song(1, std::max<size_t>(size.songs, 1));
+        std::uniform_int_distribution<size_t> any_artist(1, std::max<size_t>(size.artists, 1));
+        std::uniform_int_distribution<size_t> any_album(1, std::max<size_t>(size.albums, 1));
+
+        core::SongRepository songs(db);
+        runner.run("songs.findById", iterations, [&](size_t) {
+            songs.findById(static_cast<unsigned>(any_song(random)));
+        });
+        runner.run("songs.findByTitleAndUser", iterations, [&](size_t) {
+            songs.findByTitleAndUser(bench::songTitle(any_song(random)), user);
+        });
+        runner.run("songs.findByArtist", iterations, [&](size_t) {
+            size_t id = any_artist(random);
+            core::Artist artist(static_cast<unsigned>(id), bench::artistName(id), user);
+            songs.findByArtist(artist);
+        });
+        runner.run("songs.findByUser", full_scans, [&](size_t) { songs.findByUser(user); });
+        runner.run("songs.getAll", full_scans, [&](size_t) { songs.getAll(); });
+        runner.run("songs.count", iterations, [&](size_t) { songs.count(); });
+
+        core::AlbumRepository albums(db);
+        runner.run("albums.findById", iterations, [&](size_t) {
+            albums.findById(static_cast<unsigned>(any_album(random)));
+        });
+        runner.run("albums.findByTitleAndUser", iterations, [&](size_t) {
+            albums.findByTitleAndUser(bench::albumTitle(any_album(random)), user);
+        });
+        runner.run("albums.findByArtist", iterations, [&](size_t) {
+            albums.findByArtist(bench::artistName(any_artist(random)));
+        });
+        runner.run("albums.findByUser", full_scans, [&](size_t) { albums.findByUser(user); });
+        runner.run("albums.getAll", full_scans, [&](size_t) { albums.getAll(); });
+        runner.run("albums.count", iterations, [&](size_t) { albums.count(); });
+
+        core::ArtistRepository artists(db);
+        runner.run("artists.findById", iterations, [&](size_t) {
+            artists.findById(static_cast<unsigned>(any_artist(random)));
+        });
+        runner.run("artists.findByNameAndUser", iterations, [&](size_t) {
+            artists.findByNameAndUser(bench::artistName(any_artist(random)), user);
+        });
+        runner.run("artists.getAll", full_scans, [&](size_t) { artists.getAll(); });
+        runner.run("artists.count", iterations, [&](size_t) { artists.count(); });
+    }
+
+    /**
+     * @brief Casos dos repositórios de playlists e histórico
+     */
+    void benchPlaylistsAndHistory(bench::Runner& runner,
+                                  std::shared_ptr<SQLite::Database> db,
+                                  const core::User& user,
+                                  const Options& options) {
+        const auto& size = options.size;
+        size_t iterations = options.iterations;
+        size_t full_scans = std::max<size_t>(iterations / 100, 3);
+
+        std::mt19937 random(11);
+        std::uniform_int_distribution<size_t> any_song(1, std::max<size_t>(size.songs, 1));
+        std::uniform_int_distribution<size_t> any_playlist(1, std::max<size_t>(size.playlists, 1));
+
+        core::PlaylistRepository playlists(db);
+        if (size.playlists > 0) {
+            runner.run("playlists.load", iterations, [&](size_t) {
+                auto playlist = playlists.findById(static_cast<unsigned>(any_playlist(random)));
+                if (playlist)
+                    playlists.getSongs(*playlist);
+            });
+
+            runner.run("playlists.update", std::max<size_t>(iterations / 10, 1), [&](size_t) {
+                auto playlist = playlists.findById(static_cast<unsigned>(any_playlist(random)));
+                if (!playlist || playlist->getSongsCount() < 2)
+                    return;
+                playlist->moveSong(0, static_cast<unsigned>(playlist->getSongsCount() - 1));
+                playlists.save(*playlist);
+            });
+        }
+        runner.run("playlists.findByUser", iterations, [&](size_t) {
+            playlists.findByUser(user);
+        });
+        runner.run("playlists.count", iterations, [&](size_t) { playlists.count(); });
+
+        core::HistoryPlaybackRepository history(db);
+        core::SongRepository songs(db);
+        runner.run("history.countPlaybacksBySongAndUser", iterations, [&](size_t) {
+            auto song = songs.findById(static_cast<unsigned>(any_song(random)));
+            if (song)
+                history.countPlaybacksBySongAndUser(*song, user);
+        });
+        runner.run("history.findByUser", full_scans, [&](size_t) { history.findByUser(user); });
+        runner.run("history.count", iterations, [&](size_t) { history.count(); });
+    }
+
+    /**
+     * @brief Inserção em lote contra inserções avulsas
+     *
+     * Grava o mesmo lote de reproduções linha a linha, cada uma na sua
+     * própria transação, e com insertMany() / saveMany(), que usam uma
+     * transação só. Roda por último porque aumenta o histórico.
+     */
+    void benchBulkInsert(bench::Runner& runner,
+                         std::shared_ptr<SQLite::Database> db,
+                         core::User& user,
+                         const Options& options) {
+        const size_t batch_size = 500;
+        size_t batches = std::max<size_t>(options.iterations / 100, 3);
+
+        auto song = core::SongRepository(db).findById(1);
+        if (!song)
+            return;
+
+        std::vector<core::HistoryPlayback> batch;
+        batch.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i)
+            batch.emplace_back(user, *song, static_cast<std::time_t>(1700000000 + i));
+
+        auto reset = [&batch]() {
+            for (auto& entry : batch)
+                entry.setId(0);
+        };
+
+        core::HistoryPlaybackRepository history(db);
+        runner.run("history.insert x" + std::to_string(batch_size), batches, [&](size_t) {
+            reset();
+            for (auto& entry : batch)
+                history.save(entry);
+        }, batch_size);
+        runner.run("history.insertMany x" + std::to_string(batch_size), batches, [&](size_t) {
+            reset();
+            history.insertMany(batch);
+        }, batch_size);
+        runner.run("history.saveMany x" + std::to_string(batch_size), batches, [&](size_t) {
+            reset();
+            history.saveMany(batch);
+        }, batch_size);
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    bool temporary = options.db_path.empty();
+    if (temporary)
+        options.db_path = (std::filesystem::temp_directory_path()
+                           / "frankenstein_bench.db")
+                              .string();
+    removeDatabase(options.db_path);
+
+    nlohmann::json report;
+    try {
+        core::DatabaseManager db_manager(options.db_path, "");
+        auto db = db_manager.getDatabase();
+
+        auto start = std::chrono::steady_clock::now();
+        bench::generateLibrary(*db, options.size);
+        std::chrono::duration<double> generation = std::chrono::steady_clock::now() - start;
+        std::cerr << "Biblioteca gerada em " << generation.count() << " s" << std::endl;
+
+        auto user = core::UserRepository(db).findById(1);
+        if (!user)
+            throw std::runtime_error("Usuário da biblioteca sintética não encontrado");
+
+        bench::Runner runner(options.filter);
+        benchCatalog(runner, db, *user, options);
+        benchPlaylistsAndHistory(runner, db, *user, options);
+        benchBulkInsert(runner, db, *user, options);
+
+        report = {{"timestamp", static_cast<int64_t>(std::time(nullptr))},
+                  {"sqlite_version", sqlite3_libversion()},
+                  {"library", options.size.toJson()},
+                  {"generation_s", generation.count()},
+                  {"results", runner.results()}};
+    } catch (const std::exception& e) {
+        std::cerr << "Erro no benchmark: " << e.what() << std::endl;
+        if (temporary)
+            removeDatabase(options.db_path);
+        return 1;
+    }
+
+    if (temporary)
+        removeDatabase(options.db_path);
+
+    if (options.output.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream out(options.output);
+        out << report.dump(2) << std::endl;
+    }
+    return 0;
+}
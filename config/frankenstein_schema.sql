@@ -1,3 +1,7 @@
+-- Esquema de referência na versão mais recente (PRAGMA user_version = 5).
+-- O banco é criado e atualizado pelas migrações embutidas em
+-- src/core/bd/SchemaMigrations.cpp; mantenha os dois em sincronia.
+
 -- Tabela de usuários
 CREATE TABLE IF NOT EXISTS users (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -112,5 +116,431 @@ CREATE TABLE IF NOT EXISTS playback_history (
 CREATE INDEX IF NOT EXISTS idx_songs_artist ON songs(artist_id);
 CREATE INDEX IF NOT EXISTS idx_songs_album ON songs(album_id);
 CREATE INDEX IF NOT EXISTS idx_songs_title ON songs(title);
+CREATE INDEX IF NOT EXISTS idx_songs_user ON songs(user_id);
 CREATE INDEX IF NOT EXISTS idx_playlist_songs_position ON playlist_songs(playlist_id, position);
 CREATE INDEX IF NOT EXISTS idx_playback_history_user_date ON playback_history(user_id, played_at);
+
+-- Índice de busca textual (FTS5)
+-- O rowid codifica o tipo da entidade: id * 4 + (0 música, 1 artista,
+-- 2 álbum, 3 playlist), o que permite manter o índice por rowid
+CREATE VIRTUAL TABLE IF NOT EXISTS search_index USING fts5(
+    kind UNINDEXED,
+    entity_id UNINDEXED,
+    user_id UNINDEXED,
+    title,
+    artist,
+    album,
+    genre,
+    tokenize = 'unicode61 remove_diacritics 2',
+    prefix = '2 3'
+);
+
+CREATE TRIGGER IF NOT EXISTS songs_search_insert AFTER INSERT ON songs BEGIN
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title, artist, album, genre)
+    VALUES (new.id * 4, 'song', new.id, new.user_id, new.title,
+            (SELECT name FROM artists WHERE id = new.artist_id),
+            (SELECT title FROM albums WHERE id = new.album_id),
+            new.genre);
+END;
+
+CREATE TRIGGER IF NOT EXISTS songs_search_update
+AFTER UPDATE OF title, artist_id, album_id, genre, user_id ON songs BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4;
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title, artist, album, genre)
+    VALUES (new.id * 4, 'song', new.id, new.user_id, new.title,
+            (SELECT name FROM artists WHERE id = new.artist_id),
+            (SELECT title FROM albums WHERE id = new.album_id),
+            new.genre);
+END;
+
+CREATE TRIGGER IF NOT EXISTS songs_search_delete AFTER DELETE ON songs BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4;
+END;
+
+CREATE TRIGGER IF NOT EXISTS artists_search_insert AFTER INSERT ON artists BEGIN
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+    VALUES (new.id * 4 + 1, 'artist', new.id, new.user_id, new.name);
+END;
+
+CREATE TRIGGER IF NOT EXISTS artists_search_update
+AFTER UPDATE OF name, user_id ON artists BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 1;
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+    VALUES (new.id * 4 + 1, 'artist', new.id, new.user_id, new.name);
+    UPDATE search_index SET artist = new.name
+    WHERE rowid IN (SELECT id * 4 FROM songs WHERE artist_id = new.id);
+    UPDATE search_index SET artist = new.name
+    WHERE rowid IN (SELECT album_id * 4 + 2 FROM album_artists
+                    WHERE artist_id = new.id AND is_principal = 1);
+END;
+
+CREATE TRIGGER IF NOT EXISTS artists_search_delete AFTER DELETE ON artists BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 1;
+END;
+
+CREATE TRIGGER IF NOT EXISTS albums_search_insert AFTER INSERT ON albums BEGIN
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title, genre)
+    VALUES (new.id * 4 + 2, 'album', new.id, new.user_id, new.title, new.genre);
+END;
+
+CREATE TRIGGER IF NOT EXISTS albums_search_update
+AFTER UPDATE OF title, genre, user_id ON albums BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 2;
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title, artist, genre)
+    VALUES (new.id * 4 + 2, 'album', new.id, new.user_id, new.title,
+            (SELECT art.name FROM album_artists aa
+             JOIN artists art ON art.id = aa.artist_id
+             WHERE aa.album_id = new.id AND aa.is_principal = 1 LIMIT 1),
+            new.genre);
+    UPDATE search_index SET album = new.title
+    WHERE rowid IN (SELECT id * 4 FROM songs WHERE album_id = new.id);
+END;
+
+CREATE TRIGGER IF NOT EXISTS albums_search_delete AFTER DELETE ON albums BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 2;
+END;
+
+CREATE TRIGGER IF NOT EXISTS album_artists_search_insert
+AFTER INSERT ON album_artists WHEN new.is_principal BEGIN
+    UPDATE search_index
+    SET artist = (SELECT name FROM artists WHERE id = new.artist_id)
+    WHERE rowid = new.album_id * 4 + 2;
+END;
+
+CREATE TRIGGER IF NOT EXISTS album_artists_search_update
+AFTER UPDATE OF album_id, artist_id, is_principal ON album_artists BEGIN
+    UPDATE search_index
+    SET artist = (SELECT art.name FROM album_artists aa
+                  JOIN artists art ON art.id = aa.artist_id
+                  WHERE aa.album_id = search_index.entity_id AND aa.is_principal = 1
+                  LIMIT 1)
+    WHERE rowid IN (old.album_id * 4 + 2, new.album_id * 4 + 2);
+END;
+
+CREATE TRIGGER IF NOT EXISTS album_artists_search_delete
+AFTER DELETE ON album_artists WHEN old.is_principal BEGIN
+    UPDATE search_index
+    SET artist = (SELECT art.name FROM album_artists aa
+                  JOIN artists art ON art.id = aa.artist_id
+                  WHERE aa.album_id = old.album_id AND aa.is_principal = 1
+                  LIMIT 1)
+    WHERE rowid = old.album_id * 4 + 2;
+END;
+
+CREATE TRIGGER IF NOT EXISTS playlists_search_insert AFTER INSERT ON playlists BEGIN
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+    VALUES (new.id * 4 + 3, 'playlist', new.id, new.user_id, new.title);
+END;
+
+CREATE TRIGGER IF NOT EXISTS playlists_search_update
+AFTER UPDATE OF title, user_id ON playlists BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 3;
+    INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+    VALUES (new.id * 4 + 3, 'playlist', new.id, new.user_id, new.title);
+END;
+
+CREATE TRIGGER IF NOT EXISTS playlists_search_delete AFTER DELETE ON playlists BEGIN
+    DELETE FROM search_index WHERE rowid = old.id * 4 + 3;
+END;
+
+-- Indexa as linhas que existiam antes do índice de busca
+INSERT INTO search_index(rowid, kind, entity_id, user_id, title, artist, album, genre)
+SELECT s.id * 4, 'song', s.id, s.user_id, s.title, ar.name, al.title, s.genre
+FROM songs s
+LEFT JOIN artists ar ON ar.id = s.artist_id
+LEFT JOIN albums al ON al.id = s.album_id
+WHERE NOT EXISTS (SELECT 1 FROM search_index WHERE rowid = s.id * 4);
+
+INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+SELECT a.id * 4 + 1, 'artist', a.id, a.user_id, a.name
+FROM artists a
+WHERE NOT EXISTS (SELECT 1 FROM search_index WHERE rowid = a.id * 4 + 1);
+
+INSERT INTO search_index(rowid, kind, entity_id, user_id, title, artist, genre)
+SELECT al.id * 4 + 2, 'album', al.id, al.user_id, al.title,
+       (SELECT art.name FROM album_artists aa
+        JOIN artists art ON art.id = aa.artist_id
+        WHERE aa.album_id = al.id AND aa.is_principal = 1 LIMIT 1),
+       al.genre
+FROM albums al
+WHERE NOT EXISTS (SELECT 1 FROM search_index WHERE rowid = al.id * 4 + 2);
+
+INSERT INTO search_index(rowid, kind, entity_id, user_id, title)
+SELECT p.id * 4 + 3, 'playlist', p.id, p.user_id, p.title
+FROM playlists p
+WHERE NOT EXISTS (SELECT 1 FROM search_index WHERE rowid = p.id * 4 + 3);
+
+-- Estatísticas de reprodução materializadas
+-- Mantidas pelos triggers de playback_history; played_at é gravado em
+-- segundos desde a época e os dias são contados em UTC (played_at / 86400)
+CREATE TABLE IF NOT EXISTS play_stats_song (
+    user_id INTEGER NOT NULL,
+    song_id INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listen_seconds INTEGER NOT NULL DEFAULT 0,
+    last_played_at INTEGER,
+    PRIMARY KEY (user_id, song_id),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    FOREIGN KEY (song_id) REFERENCES songs(id) ON DELETE CASCADE
+) WITHOUT ROWID;
+
+CREATE TABLE IF NOT EXISTS play_stats_artist (
+    user_id INTEGER NOT NULL,
+    artist_id INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listen_seconds INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (user_id, artist_id),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    FOREIGN KEY (artist_id) REFERENCES artists(id) ON DELETE CASCADE
+) WITHOUT ROWID;
+
+CREATE TABLE IF NOT EXISTS play_stats_album (
+    user_id INTEGER NOT NULL,
+    album_id INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listen_seconds INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (user_id, album_id),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    FOREIGN KEY (album_id) REFERENCES albums(id) ON DELETE CASCADE
+) WITHOUT ROWID;
+
+CREATE TABLE IF NOT EXISTS play_stats_day (
+    user_id INTEGER NOT NULL,
+    day INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listen_seconds INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (user_id, day),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
+) WITHOUT ROWID;
+
+CREATE INDEX IF NOT EXISTS idx_play_stats_song_song ON play_stats_song(song_id);
+CREATE INDEX IF NOT EXISTS idx_play_stats_song_top ON play_stats_song(user_id, play_count DESC);
+CREATE INDEX IF NOT EXISTS idx_play_stats_artist_top ON play_stats_artist(user_id, play_count DESC);
+CREATE INDEX IF NOT EXISTS idx_play_stats_album_top ON play_stats_album(user_id, play_count DESC);
+
+CREATE TRIGGER IF NOT EXISTS playback_history_stats_insert AFTER INSERT ON playback_history BEGIN
+    INSERT INTO play_stats_song(user_id, song_id, play_count, listen_seconds, last_played_at)
+    VALUES (new.user_id, new.song_id, 1, COALESCE(new.play_duration, 0), new.played_at)
+    ON CONFLICT(user_id, song_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds,
+        last_played_at = MAX(COALESCE(last_played_at, 0), excluded.last_played_at);
+    INSERT INTO play_stats_artist(user_id, artist_id, play_count, listen_seconds)
+    SELECT new.user_id, s.artist_id, 1, COALESCE(new.play_duration, 0)
+    FROM songs s WHERE s.id = new.song_id
+    ON CONFLICT(user_id, artist_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    INSERT INTO play_stats_album(user_id, album_id, play_count, listen_seconds)
+    SELECT new.user_id, s.album_id, 1, COALESCE(new.play_duration, 0)
+    FROM songs s WHERE s.id = new.song_id AND s.album_id IS NOT NULL
+    ON CONFLICT(user_id, album_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    INSERT INTO play_stats_day(user_id, day, play_count, listen_seconds)
+    VALUES (new.user_id, new.played_at / 86400, 1, COALESCE(new.play_duration, 0))
+    ON CONFLICT(user_id, day) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    UPDATE songs SET play_count = COALESCE(play_count, 0) + 1 WHERE id = new.song_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS playback_history_stats_delete AFTER DELETE ON playback_history BEGIN
+    UPDATE play_stats_song
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id AND song_id = old.song_id;
+    UPDATE play_stats_artist
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id
+      AND artist_id = (SELECT artist_id FROM songs WHERE id = old.song_id);
+    UPDATE play_stats_album
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id
+      AND album_id = (SELECT album_id FROM songs WHERE id = old.song_id);
+    UPDATE play_stats_day
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id AND day = old.played_at / 86400;
+    UPDATE songs SET play_count = play_count - 1
+    WHERE id = old.song_id AND play_count > 0;
+    DELETE FROM play_stats_song
+    WHERE user_id = old.user_id AND song_id = old.song_id AND play_count <= 0;
+    DELETE FROM play_stats_artist
+    WHERE user_id = old.user_id AND play_count <= 0
+      AND artist_id = (SELECT artist_id FROM songs WHERE id = old.song_id);
+    DELETE FROM play_stats_album
+    WHERE user_id = old.user_id AND play_count <= 0
+      AND album_id = (SELECT album_id FROM songs WHERE id = old.song_id);
+    DELETE FROM play_stats_day
+    WHERE user_id = old.user_id AND day = old.played_at / 86400 AND play_count <= 0;
+END;
+
+-- Uma reprodução editada sai dos totais da linha antiga e entra nos da nova
+CREATE TRIGGER IF NOT EXISTS playback_history_stats_update
+AFTER UPDATE OF user_id, song_id, played_at, play_duration ON playback_history
+WHEN old.user_id IS NOT new.user_id OR old.song_id IS NOT new.song_id
+  OR old.played_at IS NOT new.played_at
+  OR old.play_duration IS NOT new.play_duration BEGIN
+    UPDATE play_stats_song
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0),
+        last_played_at = (SELECT MAX(ph.played_at) FROM playback_history ph
+                          WHERE ph.user_id = old.user_id AND ph.song_id = old.song_id)
+    WHERE user_id = old.user_id AND song_id = old.song_id;
+    UPDATE play_stats_artist
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id
+      AND artist_id = (SELECT artist_id FROM songs WHERE id = old.song_id);
+    UPDATE play_stats_album
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id
+      AND album_id = (SELECT album_id FROM songs WHERE id = old.song_id);
+    UPDATE play_stats_day
+    SET play_count = play_count - 1,
+        listen_seconds = listen_seconds - COALESCE(old.play_duration, 0)
+    WHERE user_id = old.user_id AND day = old.played_at / 86400;
+    UPDATE songs SET play_count = play_count - 1
+    WHERE id = old.song_id AND play_count > 0;
+    DELETE FROM play_stats_song
+    WHERE user_id = old.user_id AND song_id = old.song_id AND play_count <= 0;
+    DELETE FROM play_stats_artist
+    WHERE user_id = old.user_id AND play_count <= 0
+      AND artist_id = (SELECT artist_id FROM songs WHERE id = old.song_id);
+    DELETE FROM play_stats_album
+    WHERE user_id = old.user_id AND play_count <= 0
+      AND album_id = (SELECT album_id FROM songs WHERE id = old.song_id);
+    DELETE FROM play_stats_day
+    WHERE user_id = old.user_id AND day = old.played_at / 86400 AND play_count <= 0;
+
+    INSERT INTO play_stats_song(user_id, song_id, play_count, listen_seconds, last_played_at)
+    VALUES (new.user_id, new.song_id, 1, COALESCE(new.play_duration, 0), new.played_at)
+    ON CONFLICT(user_id, song_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds,
+        last_played_at = MAX(COALESCE(last_played_at, 0), excluded.last_played_at);
+    INSERT INTO play_stats_artist(user_id, artist_id, play_count, listen_seconds)
+    SELECT new.user_id, s.artist_id, 1, COALESCE(new.play_duration, 0)
+    FROM songs s WHERE s.id = new.song_id
+    ON CONFLICT(user_id, artist_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    INSERT INTO play_stats_album(user_id, album_id, play_count, listen_seconds)
+    SELECT new.user_id, s.album_id, 1, COALESCE(new.play_duration, 0)
+    FROM songs s WHERE s.id = new.song_id AND s.album_id IS NOT NULL
+    ON CONFLICT(user_id, album_id) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    INSERT INTO play_stats_day(user_id, day, play_count, listen_seconds)
+    VALUES (new.user_id, new.played_at / 86400, 1, COALESCE(new.play_duration, 0))
+    ON CONFLICT(user_id, day) DO UPDATE SET
+        play_count = play_count + 1,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+    UPDATE songs SET play_count = COALESCE(play_count, 0) + 1 WHERE id = new.song_id;
+END;
+
+-- Ao remover uma música, o histórico é apagado em cascata depois que a linha
+-- da música já não existe; por isso o artista e o álbum são descontados antes
+CREATE TRIGGER IF NOT EXISTS songs_stats_delete BEFORE DELETE ON songs BEGIN
+    UPDATE play_stats_artist
+    SET play_count = play_count - (SELECT ps.play_count FROM play_stats_song ps
+                                   WHERE ps.song_id = old.id AND ps.user_id = play_stats_artist.user_id),
+        listen_seconds = listen_seconds - (SELECT ps.listen_seconds FROM play_stats_song ps
+                                           WHERE ps.song_id = old.id AND ps.user_id = play_stats_artist.user_id)
+    WHERE artist_id = old.artist_id
+      AND user_id IN (SELECT user_id FROM play_stats_song WHERE song_id = old.id);
+    UPDATE play_stats_album
+    SET play_count = play_count - (SELECT ps.play_count FROM play_stats_song ps
+                                   WHERE ps.song_id = old.id AND ps.user_id = play_stats_album.user_id),
+        listen_seconds = listen_seconds - (SELECT ps.listen_seconds FROM play_stats_song ps
+                                           WHERE ps.song_id = old.id AND ps.user_id = play_stats_album.user_id)
+    WHERE album_id = old.album_id
+      AND user_id IN (SELECT user_id FROM play_stats_song WHERE song_id = old.id);
+    DELETE FROM play_stats_artist WHERE artist_id = old.artist_id AND play_count <= 0;
+    DELETE FROM play_stats_album WHERE album_id = old.album_id AND play_count <= 0;
+END;
+
+-- Move as reproduções quando a música muda de artista ou de álbum
+CREATE TRIGGER IF NOT EXISTS songs_stats_move_artist AFTER UPDATE OF artist_id ON songs
+WHEN old.artist_id IS NOT new.artist_id BEGIN
+    UPDATE play_stats_artist
+    SET play_count = play_count - (SELECT ps.play_count FROM play_stats_song ps
+                                   WHERE ps.song_id = old.id AND ps.user_id = play_stats_artist.user_id),
+        listen_seconds = listen_seconds - (SELECT ps.listen_seconds FROM play_stats_song ps
+                                           WHERE ps.song_id = old.id AND ps.user_id = play_stats_artist.user_id)
+    WHERE artist_id = old.artist_id
+      AND user_id IN (SELECT user_id FROM play_stats_song WHERE song_id = old.id);
+    DELETE FROM play_stats_artist WHERE artist_id = old.artist_id AND play_count <= 0;
+    INSERT INTO play_stats_artist(user_id, artist_id, play_count, listen_seconds)
+    SELECT ps.user_id, new.artist_id, ps.play_count, ps.listen_seconds
+    FROM play_stats_song ps WHERE ps.song_id = new.id
+    ON CONFLICT(user_id, artist_id) DO UPDATE SET
+        play_count = play_count + excluded.play_count,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+END;
+
+CREATE TRIGGER IF NOT EXISTS songs_stats_move_album AFTER UPDATE OF album_id ON songs
+WHEN old.album_id IS NOT new.album_id BEGIN
+    UPDATE play_stats_album
+    SET play_count = play_count - (SELECT ps.play_count FROM play_stats_song ps
+                                   WHERE ps.song_id = old.id AND ps.user_id = play_stats_album.user_id),
+        listen_seconds = listen_seconds - (SELECT ps.listen_seconds FROM play_stats_song ps
+                                           WHERE ps.song_id = old.id AND ps.user_id = play_stats_album.user_id)
+    WHERE album_id = old.album_id
+      AND user_id IN (SELECT user_id FROM play_stats_song WHERE song_id = old.id);
+    DELETE FROM play_stats_album WHERE album_id = old.album_id AND play_count <= 0;
+    INSERT INTO play_stats_album(user_id, album_id, play_count, listen_seconds)
+    SELECT ps.user_id, new.album_id, ps.play_count, ps.listen_seconds
+    FROM play_stats_song ps WHERE ps.song_id = new.id AND new.album_id IS NOT NULL
+    ON CONFLICT(user_id, album_id) DO UPDATE SET
+        play_count = play_count + excluded.play_count,
+        listen_seconds = listen_seconds + excluded.listen_seconds;
+END;
+
+-- Contabiliza o histórico gravado antes das tabelas de estatísticas
+INSERT OR IGNORE INTO play_stats_song(user_id, song_id, play_count, listen_seconds, last_played_at)
+SELECT user_id, song_id, COUNT(*), COALESCE(SUM(play_duration), 0), MAX(played_at)
+FROM playback_history
+GROUP BY user_id, song_id;
+
+INSERT OR IGNORE INTO play_stats_artist(user_id, artist_id, play_count, listen_seconds)
+SELECT ph.user_id, s.artist_id, COUNT(*), COALESCE(SUM(ph.play_duration), 0)
+FROM playback_history ph
+JOIN songs s ON s.id = ph.song_id
+GROUP BY ph.user_id, s.artist_id;
+
+INSERT OR IGNORE INTO play_stats_album(user_id, album_id, play_count, listen_seconds)
+SELECT ph.user_id, s.album_id, COUNT(*), COALESCE(SUM(ph.play_duration), 0)
+FROM playback_history ph
+JOIN songs s ON s.id = ph.song_id
+WHERE s.album_id IS NOT NULL
+GROUP BY ph.user_id, s.album_id;
+
+INSERT OR IGNORE INTO play_stats_day(user_id, day, play_count, listen_seconds)
+SELECT user_id, played_at / 86400, COUNT(*), COALESCE(SUM(play_duration), 0)
+FROM playback_history
+GROUP BY user_id, played_at / 86400;
+
+UPDATE songs
+SET play_count = (SELECT COUNT(*) FROM playback_history ph WHERE ph.song_id = songs.id);
+
+-- Arquivos já vistos pela importação
+-- Permite pular com um único stat() os arquivos que não mudaram. Só os
+-- que não foram importados, e por isso continuam no diretório de entrada,
+-- ficam na tabela: 'rejected' sem áudio ou sem tags, 'failed' com erro ao
+-- importar. A linha de um arquivo importado é apagada ao movê-lo
+CREATE TABLE IF NOT EXISTS scanned_files (
+    path TEXT PRIMARY KEY,
+    user_id INTEGER NOT NULL,
+    size INTEGER NOT NULL,
+    mtime INTEGER NOT NULL,
+    inode INTEGER NOT NULL,
+    hash_prefix INTEGER NOT NULL,
+    status TEXT NOT NULL DEFAULT 'rejected' CHECK (status IN ('rejected', 'failed')),
+    scanned_at INTEGER NOT NULL,
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
+) WITHOUT ROWID;
@@ -14,13 +14,16 @@
 #include <memory>
 #include <sstream>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 
 #include <nlohmann/json.hpp>
+#include "core/bd/DatabaseExecutor.hpp"
 #include "core/bd/DatabaseManager.hpp"
 #include "core/services/ConfigManager.hpp"
 #include "core/entities/User.hpp"
 #include "core/services/FilesManager.hpp"
+#include "core/services/HistoryWriter.hpp"
 #include "core/services/Player.hpp"
 #include "core/entities/Playlist.hpp"
 #include "core/entities/Album.hpp"
@@ -28,6 +31,7 @@
 #include "core/bd/SongRepository.hpp"
 #include "core/bd/RepositoryFactory.hpp"
 #include "core/services/Library.hpp"
+#include "core/services/LibraryWatcher.hpp"
 #include "core/services/UsersManager.hpp"
 
 namespace cli
@@ -47,6 +51,9 @@ namespace cli
     core::DatabaseManager _db_manager;
     std::shared_ptr<core::UsersManager> _usersManager;
     std::shared_ptr<core::FilesManager> _manager;
+    std::shared_ptr<core::DatabaseExecutor> _db_executor;
+    std::shared_ptr<core::HistoryWriter> _history_writer; /*!< @brief Único gravador do histórico, com conexão própria */
+    std::unique_ptr<core::LibraryWatcher> _watcher; /*!< @brief Destruído antes de _manager */
 
     /**
      * @brief toca um IPlayable ou um IPlayableObject
@@ -211,15 +218,41 @@ namespace cli
     /**
      * @brief Mostra as informações atuais do player como: volume, progresso da musica atual, prxima musica da lista, etc.
      *
+     * Os artistas são buscados em lote no executor e o status aparece entre os
+     * comandos do prompt.
      */
     void showStatus() const;
 
     /**
      * @brief Mostra as informações da fila de musicas.
      *
+     * Os artistas são buscados em lote no executor e a fila aparece entre os
+     * comandos do prompt.
      */
     void showQueue() const;
 
+    /**
+     * @brief Adiciona todas as músicas do usuário à fila de reprodução.
+     *
+     * As músicas são lidas do banco uma a uma até a fila encher.
+     */
+    void addLibraryToQueue();
+
+    /**
+     * @brief Lista todas as músicas do usuário.
+     *
+     * Cada música é exibida assim que é lida do banco, sem carregar a
+     * biblioteca inteira em memória.
+     */
+    void listSongs() const;
+
+    /**
+     * @brief Mostra as consultas SQL mais caras desde o início da sessão.
+     *
+     * Exige `database.profile` habilitado na configuração.
+     */
+    void showDatabaseStats() const;
+
     /**
      * @brief Adiociona uma música na fila.
      * @param playabel Objeto IPlayable a ser adicionado a fil.
@@ -239,6 +272,19 @@ namespace cli
      */
     void loop(const std::string &command);
 
+    /**
+     * @brief Executa uma busca no executor e mostra o resultado no console
+     *
+     * O texto é montado na thread do executor e mostrado entre os comandos
+     * do prompt, junto das demais mensagens em segundo plano. Buscas com a
+     * mesma chave ainda na fila são executadas e mostradas uma vez só.
+     *
+     * @param key Tipo da busca, usuário e termo buscado
+     * @param search Função que faz a busca e devolve o texto a mostrar
+     */
+    void postSearch(const std::string &key,
+                    std::function<std::string(core::RepositoryFactory &)> search) const;
+
     /**
      * @brief Procura pelas playlists do usuário.
      * @param query string de busca.
@@ -277,6 +323,15 @@ namespace cli
      */
     void updateSongs();
 
+    /**
+     * @brief Liga ou desliga a importação automática dos diretórios de entrada
+     *
+     * Sem argumento, mostra se os diretórios estão sendo observados.
+     *
+     * @param mode "on", "off" ou vazio
+     */
+    void watch(const std::string &mode);
+
     /**
      * @brief Mostra a ajuda com os comandos disponíveis.
      *
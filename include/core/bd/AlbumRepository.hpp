@@ -18,6 +18,8 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/SQLiteRepositoryBase.hpp"
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/UserRepository.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/EntitiesFWD.hpp" 
 #include "core/entities/Song.hpp"
@@ -28,9 +30,15 @@ namespace core {
     /**
      * @brief Repositorio de albuns
      * Repositorio para gerenciar operacoes de CRUD para a entidade Album.
+     *
+     * @details
+     * As buscas do repositório leem o álbum, o artista principal e a
+     * contagem de músicas em uma única consulta com JOIN.
      */
     class AlbumRepository : public SQLiteRepositoryBase<Album>{
     protected:
+        std::shared_ptr<UserRepository> _user_repo; /*!< @brief Fonte dos usuários compartilhados da conexão */
+
         /**
          * @brief Insere um novo album no repositório
          * @copydoc IRepository::insert
@@ -56,6 +64,51 @@ namespace core {
         virtual std::shared_ptr<Album>
         mapRowToEntity(SQLite::Statement &query) const override;
 
+        /**
+         * @brief Mapeia uma linha da consulta com JOIN do álbum
+         *
+         * A linha já traz o artista principal e a contagem de músicas, então
+         * nenhuma consulta adicional é feita.
+         *
+         * @param query Declaração SQL posicionada em uma linha da consulta
+         * @return Ponteiro compartilhado para o album mapeado
+         */
+        std::shared_ptr<Album> mapEagerRow(SQLite::Statement &query) const;
+
+        /**
+         * @brief Usa a consulta com JOIN do álbum em findByIds
+         * @copydoc SQLiteRepositoryBase::idsSelectPrefix
+         */
+        std::string_view idsSelectPrefix() const override;
+
+        /**
+         * @brief Mapeia todas as linhas da consulta com JOIN do álbum
+         *
+         * Álbuns já presentes no mapa de identidade são reaproveitados.
+         *
+         * @param query Declaração SQL com o resultado da consulta
+         * @return Vetor com os albuns mapeados
+         */
+        std::vector<std::shared_ptr<Album>>
+        mapAlbums(SQLite::Statement &query) const;
+
+        /**
+         * @brief Cria o álbum e seus loaders a partir dos dados já lidos
+         * @param id ID do album
+         * @param title Título do album
+         * @param year Ano de lançamento
+         * @param genre Gênero do album
+         * @param user_ptr Usuário dono do album
+         * @param artist_ptr Artista principal, ou nullptr se não houver
+         * @return Ponteiro compartilhado para o album criado
+         */
+        std::shared_ptr<Album> buildAlbum(unsigned id,
+                                          const std::string &title,
+                                          int year,
+                                          const std::string &genre,
+                                          std::shared_ptr<const User> user_ptr,
+                                          std::shared_ptr<Artist> artist_ptr) const;
+
     public:
         AlbumRepository(std::shared_ptr<SQLite::Database> db);
         ~AlbumRepository() override = default;
@@ -85,6 +138,22 @@ namespace core {
         std::vector<std::shared_ptr<Album>>
         findByTitleAndUser(const std::string &title,const User &user) const;
 
+        /**
+         * @brief Busca albuns do usuário no índice de busca textual
+         *
+         * Os resultados são ordenados por relevância (BM25). Se a consulta
+         * não tiver termos indexáveis, recorre a findByTitleAndUser().
+         *
+         * @param query Texto digitado pelo usuário
+         * @param user Usuário cujos albuns serão buscados
+         * @param limit Número máximo de resultados
+         * @return Vetor com os albuns encontrados, do mais relevante ao menos
+         */
+        std::vector<std::shared_ptr<Album>>
+        search(const std::string& query,
+               const User& user,
+               size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
         /**
          * @brief Busca albuns pelo usuário
          * @param user Usuário cujos albuns serão buscados
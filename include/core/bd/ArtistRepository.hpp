@@ -18,6 +18,8 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/SQLiteRepositoryBase.hpp"
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/UserRepository.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/Artist.hpp"
 #include "core/entities/EntitiesFWD.hpp"
@@ -32,6 +34,8 @@ namespace core {
      */
     class ArtistRepository : public SQLiteRepositoryBase<Artist> {
     protected:
+        std::shared_ptr<UserRepository> _user_repo; /*!< @brief Fonte dos usuários compartilhados da conexão */
+
         /**
          * @brief Insere um novo artista no repositório
          * @copydoc IRepository::insert
@@ -57,6 +61,17 @@ namespace core {
         virtual std::shared_ptr<Artist>
         mapRowToEntity(SQLite::Statement& query) const override;
 
+        /**
+         * @brief Cria um artista com seus loaders a partir de colunas já lidas
+         * @param id ID do artista
+         * @param name Nome do artista
+         * @param user_id ID do usuário dono do artista
+         * @return Ponteiro compartilhado para o artista criado
+         */
+        std::shared_ptr<Artist> buildArtist(unsigned id,
+                                            const std::string& name,
+                                            unsigned user_id) const;
+
     public:
         ArtistRepository(std::shared_ptr<SQLite::Database> db);
         ~ArtistRepository() override = default;
@@ -77,6 +92,22 @@ namespace core {
          */
         bool remove(unsigned id) override;
 
+        /**
+         * @brief Obtém um artista lido junto com outra entidade
+         *
+         * Usado por consultas com JOIN que já trazem as colunas do artista:
+         * devolve a instância do mapa de identidade, se houver, ou registra
+         * uma nova sem consultar o banco.
+         *
+         * @param id ID do artista
+         * @param name Nome do artista
+         * @param user_id ID do usuário dono do artista
+         * @return Ponteiro compartilhado para o artista
+         */
+        std::shared_ptr<Artist> findOrMap(unsigned id,
+                                          const std::string& name,
+                                          unsigned user_id) const;
+
         /**
          * @brief Busca artistas pelo nome e usuário
          * @param name Nome do artista a ser buscado
@@ -86,6 +117,22 @@ namespace core {
         std::vector<std::shared_ptr<Artist>>
         findByNameAndUser(const std::string& name,const User& user) const;
 
+        /**
+         * @brief Busca artistas do usuário no índice de busca textual
+         *
+         * Os resultados são ordenados por relevância (BM25). Se a consulta
+         * não tiver termos indexáveis, recorre a findByNameAndUser().
+         *
+         * @param query Texto digitado pelo usuário
+         * @param user Usuário cujos artistas serão buscados
+         * @param limit Número máximo de resultados
+         * @return Vetor com os artistas encontrados, do mais relevante ao menos
+         */
+        std::vector<std::shared_ptr<Artist>>
+        search(const std::string& query,
+               const User& user,
+               size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
         /**
          * @brief Busca artistas pelo nome
          * @param name Nome do artista a ser buscado
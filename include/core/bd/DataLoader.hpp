@@ -0,0 +1,159 @@
+/**
+ * @file DataLoader.hpp
+ * @brief Carregamento em lote das relações das músicas
+ * @ingroup bd
+ *
+ * Os loaders instalados por SongRepository buscam artista, álbum e
+ * colaboradores de uma música por vez. Dentro do escopo de um DataLoader,
+ * esses pedidos são reunidos e resolvidos com uma consulta `IN (...)` por
+ * tipo de entidade.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/entities/EntitiesFWD.hpp"
+
+namespace core {
+
+    /**
+     * @brief Reúne as cargas de relações de músicas em consultas por lote
+     *
+     * @details
+     * As músicas passadas a prime(), e as mapeadas por SongRepository
+     * enquanto o escopo está aberto, têm seus IDs de artista, álbum e
+     * colaboradores registrados como pendentes. Quando o primeiro deles é
+     * pedido, todos os pendentes do mesmo tipo são lidos de uma vez e
+     * preenchidos nas músicas registradas.
+     *
+     * O DataLoader não é thread-safe: deve ser usado na thread que abriu o
+     * escopo. Ele mantém as entidades carregadas vivas até ser destruído.
+     *
+     * Exemplo:
+     * @code
+     * DataLoader loader(db);
+     * DataLoader::Scope scope(loader);
+     * loader.prime(songs);
+     * for (const auto& song : songs)
+     *     std::cout << song->getArtist()->getName();  // uma consulta no total
+     * @endcode
+     */
+    class DataLoader {
+    public:
+        /**
+         * @brief Torna o DataLoader ativo na thread enquanto existir
+         *
+         * Escopos podem ser aninhados; vale o mais interno.
+         */
+        class Scope {
+        private:
+            DataLoader& _loader;
+
+        public:
+            explicit Scope(DataLoader& loader);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+    private:
+        std::shared_ptr<SQLite::Database> _db; /*!< @brief Conexão usada nas consultas em lote */
+        std::vector<std::weak_ptr<Song>> _songs; /*!< @brief Músicas a preencher */
+        std::unordered_set<unsigned> _pending_artists;
+        std::unordered_set<unsigned> _pending_albums;
+        std::unordered_set<unsigned> _pending_featuring; /*!< @brief IDs de músicas */
+        std::unordered_map<unsigned, std::shared_ptr<Artist>> _artists;
+        std::unordered_map<unsigned, std::shared_ptr<Album>> _albums;
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>> _featuring;
+        size_t _batches; /*!< @brief Consultas em lote executadas */
+
+        /**
+         * @brief Lê todos os artistas pendentes e os preenche nas músicas
+         */
+        void dispatchArtists();
+
+        /**
+         * @brief Lê todos os álbuns pendentes e os preenche nas músicas
+         */
+        void dispatchAlbums();
+
+        /**
+         * @brief Lê os colaboradores de todas as músicas pendentes
+         */
+        void dispatchFeaturing();
+
+        /**
+         * @brief Verifica se duas conexões acessam o mesmo banco
+         */
+        static bool sameDatabase(const std::shared_ptr<SQLite::Database>& a,
+                                 const std::shared_ptr<SQLite::Database>& b);
+
+    public:
+        /**
+         * @brief Cria um DataLoader sem pendências
+         * @param db Conexão usada nas consultas em lote
+         */
+        explicit DataLoader(std::shared_ptr<SQLite::Database> db);
+
+        DataLoader(const DataLoader&) = delete;
+        DataLoader& operator=(const DataLoader&) = delete;
+
+        /**
+         * @brief Registra as relações de uma música como pendentes
+         * @param song Música cujo artista, álbum e colaboradores serão lidos em lote
+         */
+        void prime(const std::shared_ptr<Song>& song);
+
+        /**
+         * @brief Registra as relações de várias músicas como pendentes
+         * @param songs Músicas a registrar
+         */
+        void prime(const std::vector<std::shared_ptr<Song>>& songs);
+
+        /**
+         * @brief Obtém um artista, lendo junto todos os artistas pendentes
+         * @param id ID do artista
+         * @return Artista, ou nullptr se não existir
+         */
+        std::shared_ptr<Artist> loadArtist(unsigned id);
+
+        /**
+         * @brief Obtém um álbum, lendo junto todos os álbuns pendentes
+         * @param id ID do álbum
+         * @return Álbum, ou nullptr se não existir
+         */
+        std::shared_ptr<Album> loadAlbum(unsigned id);
+
+        /**
+         * @brief Obtém os colaboradores de uma música, lendo junto os das pendentes
+         * @param song_id ID da música
+         * @return Artistas colaboradores da música
+         */
+        std::vector<std::shared_ptr<Artist>> loadFeaturingArtists(unsigned song_id);
+
+        /**
+         * @brief Obtém o número de consultas em lote já executadas
+         * @return Número de lotes resolvidos
+         */
+        size_t getBatchCount() const;
+
+        /**
+         * @brief Obtém o DataLoader ativo na thread para a conexão
+         * @param db Conexão de quem pede a carga
+         * @return Escopo mais interno sobre o mesmo banco, ou nullptr
+         */
+        static DataLoader* current(const std::shared_ptr<SQLite::Database>& db);
+    };
+
+}  // namespace core
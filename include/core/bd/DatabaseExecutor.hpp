@@ -0,0 +1,229 @@
+/**
+ * @file DatabaseExecutor.hpp
+ * @brief Acesso assíncrono aos repositórios por uma thread dedicada
+ * @ingroup bd
+ *
+ * Fachada sobre a RepositoryFactory em que todas as operações com o banco
+ * são enfileiradas e executadas, uma de cada vez, pela thread do executor.
+ * Quem chama recebe um `std::future` ou um callback e não fica bloqueado
+ * pelo SQLite.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/RepositoryFactory.hpp"
+
+namespace core {
+
+    /**
+     * @brief Erro entregue às requisições canceladas antes de executar
+     */
+    class OperationCancelled : public std::runtime_error {
+    public:
+        OperationCancelled();
+    };
+
+    /**
+     * @brief Sinal de cancelamento compartilhado entre quem pede e o executor
+     *
+     * Cópias do token compartilham o mesmo estado. Uma requisição cancelada
+     * antes de começar não é executada; a que já começou pode consultar
+     * isCancelled() para interromper laços longos.
+     */
+    class CancellationToken {
+    private:
+        std::shared_ptr<std::atomic<bool>> _cancelled;
+
+    public:
+        CancellationToken();
+
+        /**
+         * @brief Cancela todas as requisições associadas ao token
+         */
+        void cancel();
+
+        /**
+         * @brief Verifica se o token foi cancelado
+         * @return true se cancel() já foi chamado
+         */
+        bool isCancelled() const;
+    };
+
+    /**
+     * @brief Executor das operações com o banco de dados
+     *
+     * @details
+     * As requisições recebem a RepositoryFactory da conexão do executor e
+     * são executadas na ordem em que chegam. Requisições feitas de dentro da
+     * própria thread do executor, ou depois que stop() encerrou a thread,
+     * são executadas imediatamente na thread de quem chama, uma de cada vez.
+     * Enquanto stop() espera a thread, as requisições continuam na fila.
+     *
+     * Entidades devolvidas continuam com seus carregadores tardios, que
+     * rodam na thread que os acionar; para telas de listagem prefira
+     * devolver resumos do SummaryRepository.
+     */
+    class DatabaseExecutor {
+    public:
+        /**
+         * @brief Tipo devolvido por uma operação que recebe a fábrica
+         */
+        template <typename Work>
+        using ResultOf = std::invoke_result_t<std::decay_t<Work>&, RepositoryFactory&>;
+
+    private:
+        /**
+         * @brief Requisição enfileirada
+         */
+        struct Request {
+            std::function<void(RepositoryFactory&)> run; /*!< @brief Executa a operação e entrega o resultado */
+            std::function<void(std::exception_ptr)> abort; /*!< @brief Entrega um erro sem executar */
+            CancellationToken token;
+            std::string key; /*!< @brief Chave de agrupamento; vazia se não agrupada */
+        };
+
+        /**
+         * @brief Resultado compartilhado por requisições agrupadas
+         */
+        struct Coalesced {
+            std::type_index type;
+            std::shared_ptr<void> future;
+        };
+
+        RepositoryFactory _factory;
+        std::deque<Request> _queue;
+        std::unordered_map<std::string, Coalesced> _coalesced; /*!< @brief Requisições agrupadas ainda na fila */
+        bool _stopping;
+        bool _stopped; /*!< @brief Indica que a thread do executor terminou */
+        mutable std::mutex _mutex;
+        std::mutex _inline_mutex; /*!< @brief Serializa as requisições executadas após stop() */
+        std::condition_variable _wake;
+        std::thread _worker;
+        std::thread::id _worker_id;
+
+        /**
+         * @brief Laço da thread do executor
+         */
+        void run();
+
+        /**
+         * @brief Executa uma requisição, a menos que tenha sido cancelada
+         * @param request Requisição a ser executada
+         */
+        void execute(Request& request);
+
+        /**
+         * @brief Executa uma requisição fora da fila
+         * @param request Requisição a ser executada
+         */
+        void executeInline(Request& request);
+
+        /**
+         * @brief Enfileira uma requisição ou a executa imediatamente
+         * @param request Requisição
+         */
+        void enqueue(Request request);
+
+        /**
+         * @brief Indica se as requisições devem rodar na thread de quem chama
+         *
+         * Deve ser chamado com o mutex travado.
+         */
+        bool runsInline() const;
+
+        /**
+         * @brief Monta a requisição que cumpre uma promessa
+         */
+        template <typename Work>
+        static Request makeRequest(std::shared_ptr<std::promise<ResultOf<Work>>> promise,
+                                   Work&& work,
+                                   CancellationToken token);
+
+    public:
+        /**
+         * @brief Construtor do executor
+         * @param db Conexão usada por todas as requisições
+         */
+        explicit DatabaseExecutor(std::shared_ptr<SQLite::Database> db);
+        ~DatabaseExecutor();
+
+        DatabaseExecutor(const DatabaseExecutor&) = delete;
+        DatabaseExecutor& operator=(const DatabaseExecutor&) = delete;
+
+        /**
+         * @brief Enfileira uma operação
+         * @param work Função que recebe a RepositoryFactory&
+         * @param token Token para cancelar a operação antes de executar
+         * @return Futuro com o resultado da operação, ou com a exceção
+         *         lançada por ela ou OperationCancelled
+         */
+        template <typename Work>
+        std::future<ResultOf<Work>> submit(Work&& work,
+                                           CancellationToken token = CancellationToken());
+
+        /**
+         * @brief Enfileira uma operação agrupando pedidos repetidos
+         *
+         * Enquanto uma operação com a mesma chave ainda estiver na fila, os
+         * novos pedidos recebem o mesmo resultado em vez de repetir a
+         * consulta. A chave deve identificar a consulta e seus parâmetros.
+         *
+         * @param key Chave da operação
+         * @param work Função que recebe a RepositoryFactory&
+         * @return Futuro compartilhado com o resultado
+         */
+        template <typename Work>
+        std::shared_future<ResultOf<Work>> submitCoalesced(const std::string& key,
+                                                           Work&& work);
+
+        /**
+         * @brief Enfileira uma operação e entrega o resultado a um callback
+         *
+         * O callback roda na thread do executor e não é chamado se a
+         * operação for cancelada ou falhar; falhas são registradas em stderr.
+         *
+         * @param work Função que recebe a RepositoryFactory&
+         * @param on_done Função que recebe o resultado
+         * @param token Token para cancelar a operação antes de executar
+         */
+        template <typename Work, typename Callback>
+        void post(Work&& work,
+                  Callback&& on_done,
+                  CancellationToken token = CancellationToken());
+
+        /**
+         * @brief Executa o que estiver na fila e encerra a thread
+         */
+        void stop();
+
+        /**
+         * @brief Obtém o número de requisições na fila
+         * @return Quantidade de requisições ainda não iniciadas
+         */
+        size_t pending() const;
+    };
+
+}  // namespace core
+
+#include "core/bd/DatabaseExecutor.tpp"
@@ -0,0 +1,118 @@
+/**
+ * @file DatabaseExecutor.tpp
+ * @brief Implementação das operações genéricas do executor do banco
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#ifndef DATABASE_EXECUTOR_TPP
+#define DATABASE_EXECUTOR_TPP
+
+#include <iostream>
+#include <utility>
+
+namespace core {
+    template <typename Work>
+    DatabaseExecutor::Request
+    DatabaseExecutor::makeRequest(std::shared_ptr<std::promise<ResultOf<Work>>> promise,
+                                  Work&& work,
+                                  CancellationToken token) {
+        using Result = ResultOf<Work>;
+        auto fn = std::make_shared<std::decay_t<Work>>(std::forward<Work>(work));
+
+        Request request;
+        request.run = [promise, fn](RepositoryFactory& factory) {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    (*fn)(factory);
+                    promise->set_value();
+                } else {
+                    promise->set_value((*fn)(factory));
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+        request.abort = [promise](std::exception_ptr error) {
+            promise->set_exception(error);
+        };
+        request.token = std::move(token);
+        return request;
+    }
+
+    template <typename Work>
+    std::future<DatabaseExecutor::ResultOf<Work>>
+    DatabaseExecutor::submit(Work&& work, CancellationToken token) {
+        auto promise = std::make_shared<std::promise<ResultOf<Work>>>();
+        auto future = promise->get_future();
+        enqueue(makeRequest(promise, std::forward<Work>(work), std::move(token)));
+        return future;
+    }
+
+    template <typename Work>
+    std::shared_future<DatabaseExecutor::ResultOf<Work>>
+    DatabaseExecutor::submitCoalesced(const std::string& key, Work&& work) {
+        using Result = ResultOf<Work>;
+        using Future = std::shared_future<Result>;
+
+        auto promise = std::make_shared<std::promise<Result>>();
+        Future future = promise->get_future().share();
+        Request request = makeRequest(promise, std::forward<Work>(work),
+                                      CancellationToken());
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (runsInline()) {
+            lock.unlock();
+            executeInline(request);
+            return future;
+        }
+
+        auto found = _coalesced.find(key);
+        if (found != _coalesced.end()) {
+            if (found->second.type != std::type_index(typeid(Result)))
+                throw std::runtime_error("Chave de requisição reutilizada com outro tipo: "
+                                         + key);
+            return *std::static_pointer_cast<Future>(found->second.future);
+        }
+
+        request.key = key;
+        _coalesced.emplace(key, Coalesced {std::type_index(typeid(Result)),
+                                           std::make_shared<Future>(future)});
+        _queue.push_back(std::move(request));
+        _wake.notify_one();
+        return future;
+    }
+
+    template <typename Work, typename Callback>
+    void DatabaseExecutor::post(Work&& work,
+                                Callback&& on_done,
+                                CancellationToken token) {
+        using Result = ResultOf<Work>;
+        auto fn = std::make_shared<std::decay_t<Work>>(std::forward<Work>(work));
+        auto callback =
+            std::make_shared<std::decay_t<Callback>>(std::forward<Callback>(on_done));
+
+        Request request;
+        request.run = [fn, callback](RepositoryFactory& factory) {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    (*fn)(factory);
+                    (*callback)();
+                } else {
+                    (*callback)((*fn)(factory));
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Erro na operação com o banco de dados: "
+                          << e.what() << std::endl;
+            }
+        };
+        request.abort = [](std::exception_ptr) {};
+        request.token = std::move(token);
+        enqueue(std::move(request));
+    }
+}  // namespace core
+
+#endif  // DATABASE_EXECUTOR_TPP
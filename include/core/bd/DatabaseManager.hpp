@@ -11,23 +11,119 @@
 #pragma once
 
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <SQLiteCpp/SQLiteCpp.h>
 #include <string>
+#include <vector>
+
+#include "core/bd/IdentityMap.hpp"
+
+#define DATABASE_SYNCHRONOUS_DEFAULT "NORMAL"
+#define DATABASE_CACHE_SIZE_DEFAULT -16000
+#define DATABASE_MMAP_SIZE_DEFAULT 268435456
+#define DATABASE_BUSY_TIMEOUT_MS_DEFAULT 5000
+#define DATABASE_READER_POOL_SIZE_DEFAULT 4
+#define DATABASE_PROFILE_DEFAULT false
+#define DATABASE_SLOW_QUERY_MS_DEFAULT 100
+#define DATABASE_MEMORY_MIRROR_DEFAULT false
+#define DATABASE_MIRROR_FLUSH_MS_DEFAULT 1000
 
 namespace core {
 
+    /**
+     * @brief Parâmetros de ajuste das conexões com o banco de dados
+     */
+    struct DatabaseSettings {
+        bool wal = true; /*!< @brief Usa journal_mode=WAL */
+        std::string synchronous = DATABASE_SYNCHRONOUS_DEFAULT; /*!< @brief Valor de PRAGMA synchronous */
+        long long cache_size = DATABASE_CACHE_SIZE_DEFAULT; /*!< @brief Valor de PRAGMA cache_size (negativo em KiB) */
+        long long mmap_size = DATABASE_MMAP_SIZE_DEFAULT; /*!< @brief Valor de PRAGMA mmap_size em bytes */
+        int busy_timeout_ms = DATABASE_BUSY_TIMEOUT_MS_DEFAULT; /*!< @brief Espera máxima por um lock */
+        size_t reader_pool_size = DATABASE_READER_POOL_SIZE_DEFAULT; /*!< @brief Conexões de leitura mantidas abertas */
+        bool profile = DATABASE_PROFILE_DEFAULT; /*!< @brief Mede as consultas com o QueryProfiler */
+        int slow_query_ms = DATABASE_SLOW_QUERY_MS_DEFAULT; /*!< @brief Duração a partir da qual uma consulta é lenta */
+        std::string slow_query_log; /*!< @brief Arquivo do log de consultas lentas; vazio mantém só em memória */
+        bool memory_mirror = DATABASE_MEMORY_MIRROR_DEFAULT; /*!< @brief Serve o banco a partir de uma cópia em memória */
+        int mirror_flush_ms = DATABASE_MIRROR_FLUSH_MS_DEFAULT; /*!< @brief Intervalo de gravação da cópia em disco; 0 grava só em flushMirror() e ao fechar */
+        size_t identity_map_entries = IDENTITY_MAP_ENTRIES_DEFAULT; /*!< @brief Capacidade dos mapas de identidade de cada conexão entregue; 0 os desativa */
+    };
+
     /**
      * @brief Gerenciador de banco de dados
      *
      * A classe DatabaseManager é responsável por gerenciar a conexão com o banco de dados SQLite.
+     *
+     * @details
+     * O banco é aberto em modo WAL com uma única conexão de escrita, obtida
+     * por getDatabase(). Consultas podem usar conexões somente leitura
+     * obtidas por getReader(), que nunca esperam pela conexão de escrita.
+     * As conexões de leitura liberadas voltam para um pool e são reutilizadas.
+     *
+     * Threads que gravam em segundo plano usam uma conexão própria, obtida
+     * por openConnection(), para que as suas transações não se misturem com
+     * as da conexão principal.
+     *
+     * Com `memory_mirror`, o arquivo é copiado para um banco em memória na
+     * abertura e todas as conexões devolvidas apontam para essa cópia. Os
+     * gerenciadores abertos para o mesmo arquivo no processo compartilham
+     * a mesma cópia. As alterações confirmadas voltam para o arquivo em
+     * segundo plano, a cada `mirror_flush_ms`, em flushMirror() e quando o
+     * último gerenciador ou conexão que usa a cópia é liberado. A cópia não
+     * tem WAL: uma transação de escrita aberta faz as leituras de outras
+     * conexões esperarem até `busy_timeout_ms`.
+     *
+     * O modo exige que o processo seja o único a usar o arquivo. Cada
+     * gravação copia o banco inteiro sobre o arquivo, inclusive quando só o
+     * histórico mudou. Se outra conexão ou outro processo alterar o arquivo
+     * depois da criação da cópia, as gravações são recusadas, flushMirror()
+     * lança exceção e a cópia passa a aceitar só leituras; as alterações
+     * feitas na cópia até então não chegam ao arquivo.
      */
     class DatabaseManager {
     private:
+        /**
+         * @brief Conexões de leitura ociosas
+         *
+         * Fica fora do gerenciador para que conexões emprestadas possam voltar
+         * ao pool mesmo depois que o gerenciador for destruído.
+         */
+        struct ReaderPool {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<SQLite::Database>> idle;
+        };
+
         std::shared_ptr<SQLite::Database> _db; /*!< @brief Conexão com o banco de dados SQLite */
         std::string _db_path; /*!< @brief Caminho para o arquivo do banco de dados SQLite */
-        std::string _schema_path; /*!< @brief Caminho para o arquivo de esquema do banco de dados SQLite */
+        std::string _schema_path; /*!< @brief Caminho do esquema de referência; o esquema aplicado vem de SchemaMigrations */
+        DatabaseSettings _settings; /*!< @brief Parâmetros de ajuste das conexões */
+        std::shared_ptr<ReaderPool> _readers; /*!< @brief Pool de conexões de leitura */
+
+        class MemoryMirror;
+        std::shared_ptr<MemoryMirror> _mirror; /*!< @brief Cópia em memória, se habilitada */
+
+        /**
+         * @brief Aplica os PRAGMAs comuns a todas as conexões
+         * @param db Conexão a ser configurada
+         */
+        void configureConnection(SQLite::Database& db) const;
+
+        /**
+         * @brief Abre uma nova conexão somente leitura
+         * @return Conexão configurada
+         */
+        std::unique_ptr<SQLite::Database> openReader() const;
 
+        /**
+         * @brief Indica se o banco é apenas em memória
+         *
+         * Bancos em memória não podem ser compartilhados entre conexões,
+         * então as leituras usam a própria conexão de escrita.
+         *
+         * @return true se o banco não estiver em um arquivo
+         */
+        bool isInMemory() const;
 
     public:
         /**
@@ -37,21 +133,89 @@ namespace core {
 
         /**
          * @brief Construtor do gerenciador de banco de dados
+         *
+         * Aplica as migrações pendentes do esquema. Um banco já atualizado
+         * é aberto sem executar nenhum comando de esquema.
+         *
+         * @param db_path Caminho do arquivo do banco de dados
+         * @param schema_path Caminho do arquivo de esquema de referência
+         * @param settings Parâmetros de ajuste das conexões
          */
-        DatabaseManager(std::string db_path, std::string schema_path);
+        DatabaseManager(std::string db_path,
+                        std::string schema_path,
+                        DatabaseSettings settings = DatabaseSettings());
         virtual ~DatabaseManager();
 
         /**
          * @brief Obtém a conexão com o banco de dados
+         *
+         * Esta é a única conexão de escrita do gerenciador.
+         *
          * @return Ponteiro compartilhado para a conexão com o banco de dados SQLite
          */
         std::shared_ptr<SQLite::Database> getDatabase();
 
+        /**
+         * @brief Abre uma conexão de escrita separada da principal
+         *
+         * A conexão tem as suas próprias transações e é destinada a uma única
+         * thread. As gravações das conexões são serializadas pelo SQLite,
+         * que espera até `busy_timeout_ms` pelo lock. Em um banco apenas em
+         * memória devolve a conexão principal.
+         *
+         * @return Ponteiro compartilhado para a nova conexão
+         */
+        std::shared_ptr<SQLite::Database> openConnection();
+
+        /**
+         * @brief Obtém uma conexão somente leitura do pool
+         *
+         * A conexão volta ao pool quando o último ponteiro para ela é
+         * liberado. Se o pool estiver vazio, uma nova conexão é aberta.
+         *
+         * @return Ponteiro compartilhado para uma conexão de leitura
+         */
+        std::shared_ptr<SQLite::Database> getReader();
+
+        /**
+         * @brief Grava no arquivo as alterações feitas na cópia em memória
+         *
+         * Não faz nada se a cópia em memória estiver desabilitada ou sem
+         * alterações desde a última gravação.
+         *
+         * Se outra conexão alterou o arquivo desde a criação da cópia, nada é
+         * gravado e a cópia, com todas as conexões abertas para ela, passa a
+         * aceitar só leituras: escritas posteriores falham em vez de serem
+         * descartadas. As alterações ainda não gravadas ficam só na cópia.
+         *
+         * @return false se uma transação aberta adiou a gravação
+         * @throws std::runtime_error se o arquivo foi alterado por outra conexão
+         */
+        bool flushMirror();
+
+        /**
+         * @brief Indica se o banco é servido por uma cópia em memória
+         * @return true se `memory_mirror` estiver em uso
+         */
+        bool isMirrored() const;
+
+        /**
+         * @brief Obtém a versão do esquema do banco
+         * @return Valor de `PRAGMA user_version`
+         */
+        int getSchemaVersion() const;
+
         /**
          * @brief Obtém o caminho do arquivo do banco de dados SQLite
          * @return Caminho do arquivo do banco de dados SQLite
          */
         std::string getDatabasePath() const;
+
+        /**
+         * @brief Obtém os parâmetros de ajuste das conexões
+         * @return Parâmetros em uso
+         */
+        const DatabaseSettings& getSettings() const;
     };
 
 }
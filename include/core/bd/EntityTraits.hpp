@@ -0,0 +1,321 @@
+/**
+ * @file EntityTraits.hpp
+ * @brief Descrição em tempo de compilação das tabelas das entidades
+ * @ingroup bd
+ *
+ * Cada entidade persistida declara sua tabela, as colunas lidas pelo
+ * repositório (com ordinal e tipo C++) e as colunas gravadas em INSERT e
+ * UPDATE. A partir disso o SQL é gerado em tempo de compilação e o
+ * mapeamento das linhas acessa as colunas pelo índice, sem procurá-las
+ * pelo nome.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-01
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/entities/EntitiesFWD.hpp"
+
+#define SQL_TEXT_CAPACITY 512
+
+namespace core {
+
+    /**
+     * @brief Texto SQL montado em tempo de compilação
+     *
+     * Usado em variáveis `static constexpr`, o texto fica nos dados
+     * estáticos do programa e nenhuma consulta aloca memória para montar o
+     * SQL. Ultrapassar SQL_TEXT_CAPACITY é um erro de compilação.
+     */
+    class SqlText {
+    private:
+        char _data[SQL_TEXT_CAPACITY] {};
+        size_t _size = 0;
+
+    public:
+        constexpr SqlText() = default;
+
+        constexpr SqlText(std::string_view text) {
+            append(text);
+        }
+
+        constexpr SqlText(const char* text) : SqlText(std::string_view(text)) {}
+
+        /**
+         * @brief Acrescenta um trecho ao final do texto
+         * @param text Trecho a acrescentar
+         * @return Referência para este texto
+         */
+        constexpr SqlText& append(std::string_view text) {
+            if (_size + text.size() >= SQL_TEXT_CAPACITY)
+                throw std::length_error("SQL maior que SQL_TEXT_CAPACITY");
+
+            for (char c : text)
+                _data[_size++] = c;
+            _data[_size] = '\0';
+            return *this;
+        }
+
+        constexpr SqlText operator+(std::string_view text) const {
+            SqlText result = *this;
+            result.append(text);
+            return result;
+        }
+
+        constexpr const char* c_str() const {
+            return _data;
+        }
+
+        constexpr size_t size() const {
+            return _size;
+        }
+
+        constexpr std::string_view view() const {
+            return std::string_view(_data, _size);
+        }
+
+        constexpr operator std::string_view() const {
+            return view();
+        }
+    };
+
+    /**
+     * @brief Descrição da tabela de uma entidade
+     * @tparam T Tipo da entidade
+     *
+     * Cada especialização define:
+     * - `table`: nome da tabela;
+     * - `Column`: enum com o ordinal de cada coluna lida e `ColumnCount`;
+     * - `columns`: nome das colunas na ordem do enum;
+     * - `Types`: tupla com o tipo C++ de cada coluna;
+     * - `insert_columns` e `update_columns`: colunas gravadas, na ordem dos
+     *   parâmetros das declarações geradas.
+     */
+    template <typename T>
+    struct EntityTraits;
+
+    /**
+     * @brief Operações comuns às descrições de tabela
+     * @tparam Traits Especialização de EntityTraits que herda desta classe
+     */
+    template <typename Traits>
+    struct EntityColumns {
+        /**
+         * @brief Lê uma coluna da linha atual pelo ordinal
+         * @tparam C Ordinal da coluna
+         * @param query Declaração posicionada em uma linha
+         * @return Valor convertido para o tipo declarado em Types
+         */
+        template <int C>
+        static auto read(SQLite::Statement& query) {
+            using Type = std::tuple_element_t<C, typename Traits::Types>;
+            const SQLite::Column value = query.getColumn(C);
+
+            if constexpr (std::is_same_v<Type, std::string>)
+                return value.getString();
+            else if constexpr (sizeof(Type) > sizeof(int))
+                return static_cast<Type>(value.getInt64());
+            else if constexpr (std::is_unsigned_v<Type>)
+                return static_cast<Type>(value.getUInt());
+            else
+                return static_cast<Type>(value.getInt());
+        }
+
+        /**
+         * @brief Lista das colunas lidas, separadas por vírgula
+         * @param alias Apelido da tabela na consulta, ou vazio
+         * @return Ex.: "a.id, a.name, a.user_id"
+         */
+        static constexpr SqlText columnList(std::string_view alias = {}) {
+            SqlText text;
+            for (size_t i = 0; i < Traits::columns.size(); ++i) {
+                if (i > 0)
+                    text.append(", ");
+                if (!alias.empty())
+                    text.append(alias).append(".");
+                text.append(Traits::columns[i]);
+            }
+            return text;
+        }
+
+        /**
+         * @brief SELECT das colunas lidas, sem filtro
+         * @return Ex.: "SELECT id, name, user_id FROM artists"
+         */
+        static constexpr SqlText select() {
+            return SqlText("SELECT ") + columnList() + " FROM " + Traits::table;
+        }
+
+        /**
+         * @brief INSERT com um parâmetro para cada coluna de insert_columns
+         */
+        static constexpr SqlText insert() {
+            SqlText text = SqlText("INSERT INTO ") + Traits::table + " (";
+            for (size_t i = 0; i < Traits::insert_columns.size(); ++i) {
+                if (i > 0)
+                    text.append(", ");
+                text.append(Traits::columns[Traits::insert_columns[i]]);
+            }
+
+            text.append(") VALUES (");
+            for (size_t i = 0; i < Traits::insert_columns.size(); ++i)
+                text.append(i > 0 ? ", ?" : "?");
+            return text + ");";
+        }
+
+        /**
+         * @brief UPDATE por ID; o último parâmetro é o ID
+         */
+        static constexpr SqlText update() {
+            SqlText text = SqlText("UPDATE ") + Traits::table + " SET ";
+            for (size_t i = 0; i < Traits::update_columns.size(); ++i) {
+                if (i > 0)
+                    text.append(", ");
+                text.append(Traits::columns[Traits::update_columns[i]])
+                    .append(" = ?");
+            }
+            return text + " WHERE id = ?;";
+        }
+    };
+
+    template <>
+    struct EntityTraits<User> : EntityColumns<EntityTraits<User>> {
+        static constexpr std::string_view table = "users";
+
+        enum Column : int { Id, Username, Uid, HomePath, InputPath, ColumnCount };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "username", "uid", "home_path", "input_path"};
+
+        // uid é TEXT no banco; a conversão para userid depende da plataforma
+        using Types = std::tuple<unsigned, std::string, std::string,
+                                 std::string, std::string>;
+
+        static constexpr std::array<Column, 4> insert_columns {
+            Username, HomePath, InputPath, Uid};
+        static constexpr std::array<Column, 4> update_columns {
+            Username, HomePath, InputPath, Uid};
+    };
+
+    template <>
+    struct EntityTraits<Artist> : EntityColumns<EntityTraits<Artist>> {
+        static constexpr std::string_view table = "artists";
+
+        enum Column : int { Id, Name, UserId, ColumnCount };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "name", "user_id"};
+
+        using Types = std::tuple<unsigned, std::string, unsigned>;
+
+        static constexpr std::array<Column, 2> insert_columns {Name, UserId};
+        static constexpr std::array<Column, 2> update_columns {Name, UserId};
+    };
+
+    template <>
+    struct EntityTraits<Album> : EntityColumns<EntityTraits<Album>> {
+        static constexpr std::string_view table = "albums";
+
+        enum Column : int { Id, Title, ReleaseYear, Genre, UserId, ColumnCount };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "title", "release_year", "genre", "user_id"};
+
+        using Types = std::tuple<unsigned, std::string, int, std::string, unsigned>;
+
+        static constexpr std::array<Column, 4> insert_columns {
+            Title, ReleaseYear, Genre, UserId};
+        static constexpr std::array<Column, 3> update_columns {
+            Title, ReleaseYear, Genre};
+    };
+
+    template <>
+    struct EntityTraits<Song> : EntityColumns<EntityTraits<Song>> {
+        static constexpr std::string_view table = "songs";
+
+        enum Column : int {
+            Id,
+            Title,
+            Duration,
+            TrackNumber,
+            ArtistId,
+            AlbumId,
+            UserId,
+            ReleaseYear,
+            FileSize,
+            Bitrate,
+            SampleRate,
+            ColumnCount
+        };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "title", "duration", "track_number",
+            "artist_id", "album_id", "user_id", "release_year",
+            "file_size", "bitrate", "sample_rate"};
+
+        using Types = std::tuple<unsigned, std::string, unsigned, unsigned,
+                                 unsigned, unsigned, unsigned, int,
+                                 uint64_t, unsigned, unsigned>;
+
+        static constexpr std::array<Column, 10> insert_columns {
+            Title, Duration, TrackNumber, ArtistId, AlbumId, UserId, ReleaseYear,
+            FileSize, Bitrate, SampleRate};
+        // Duração e propriedades do áudio vêm do arquivo e não mudam depois
+        // da importação
+        static constexpr std::array<Column, 3> update_columns {
+            Title, ArtistId, UserId};
+    };
+
+    template <>
+    struct EntityTraits<Playlist> : EntityColumns<EntityTraits<Playlist>> {
+        static constexpr std::string_view table = "playlists";
+
+        enum Column : int { Id, Title, UserId, ColumnCount };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "title", "user_id"};
+
+        using Types = std::tuple<unsigned, std::string, unsigned>;
+
+        static constexpr std::array<Column, 2> insert_columns {Title, UserId};
+        static constexpr std::array<Column, 2> update_columns {Title, UserId};
+    };
+
+    template <>
+    struct EntityTraits<HistoryPlayback>
+        : EntityColumns<EntityTraits<HistoryPlayback>> {
+        static constexpr std::string_view table = "playback_history";
+
+        enum Column : int {
+            Id,
+            UserId,
+            SongId,
+            PlayedAt,
+            PlayDuration,
+            ColumnCount
+        };
+
+        static constexpr std::array<std::string_view, ColumnCount> columns {
+            "id", "user_id", "song_id", "played_at", "play_duration"};
+
+        using Types = std::tuple<unsigned, unsigned, unsigned, int64_t, unsigned>;
+
+        static constexpr std::array<Column, 4> insert_columns {
+            UserId, SongId, PlayedAt, PlayDuration};
+        static constexpr std::array<Column, 4> update_columns {
+            UserId, SongId, PlayedAt, PlayDuration};
+    };
+
+}  // namespace core
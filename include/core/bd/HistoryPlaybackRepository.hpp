@@ -17,6 +17,7 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/SQLiteRepositoryBase.hpp"
+#include "core/bd/UserRepository.hpp"
 #include "core/entities/HistoryPlayback.hpp"
 #include "core/entities/User.hpp"
 
@@ -30,6 +31,8 @@ namespace core {
     class HistoryPlaybackRepository
         : public SQLiteRepositoryBase<HistoryPlayback> {
     protected:
+        std::shared_ptr<UserRepository> _user_repo; /*!< @brief Fonte dos usuários compartilhados da conexão */
+
         /**
          * @brief Insere um novo historico de reproducao no repositório
          * @copydoc IRepository::insert
@@ -85,6 +88,9 @@ namespace core {
 
         /**
          * @brief Insere multiplos historicos de reproducoes no repositório
+         *
+         * Todas as inserções acontecem em uma única transação.
+         *
          * @param entities Vetor contendo os historicos de reproducoes a serem
          * inseridos
          * @return true se a operação foi bem-sucedida, false caso contrário
@@ -93,14 +99,21 @@ namespace core {
         insertMultipleHistoryPlaybacks(std::vector<HistoryPlayback>& entities);
 
         /**
-         * @brief Conta o número de reproduções de uma música
-         * @param user Usuário cujas reproduções serão contadas
+         * @brief Conta o número de reproduções de uma música pelo seu dono
+         *
+         * Lê o total mantido em `play_stats_song`, sem percorrer o histórico.
+         *
+         * @param song Música cujas reproduções serão contadas
          * @return Número de reproduções da música pelo usuário
          */
         unsigned countPlaybacksBySongAndUser(const Song& song) const;
 
         /**
          * @brief Conta o número de reproduções de uma música
+         *
+         * Lê o total mantido em `play_stats_song`, sem percorrer o histórico.
+         *
+         * @param song Música cujas reproduções serão contadas
          * @param user Usuário cujas reproduções serão contadas
          * @return Número de reproduções da música pelo usuário
          */
@@ -0,0 +1,232 @@
+/**
+ * @file IdentityMap.hpp
+ * @brief Mapa de identidade de entidades por conexão
+ * @ingroup bd
+ *
+ * Garante que uma mesma linha do banco seja materializada uma única vez por
+ * conexão, compartilhando a mesma instância entre todos os repositórios.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-21
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#define IDENTITY_MAP_ENTRIES_DEFAULT 2048
+
+namespace core {
+
+    /**
+     * @brief Capacidade dos mapas de identidade de cada conexão
+     *
+     * O DatabaseManager registra a capacidade configurada para as conexões
+     * que entrega e forDatabase() a aplica aos mapas que cria. Conexões não
+     * registradas usam IDENTITY_MAP_ENTRIES_DEFAULT.
+     */
+    class IdentityMapCapacity {
+    private:
+        struct Entry {
+            std::weak_ptr<SQLite::Database> connection; /*!< @brief Evita reaproveitar o valor de uma conexão já fechada no mesmo endereço */
+            size_t capacity;
+        };
+
+        static std::mutex& mutex() {
+            static std::mutex registry_mutex;
+            return registry_mutex;
+        }
+
+        static std::unordered_map<const SQLite::Database*, Entry>& registry() {
+            static std::unordered_map<const SQLite::Database*, Entry> capacities;
+            return capacities;
+        }
+
+    public:
+        /**
+         * @brief Define a capacidade dos mapas criados para uma conexão
+         * @param db Conexão com o banco de dados SQLite
+         * @param capacity Número máximo de entidades por mapa, 0 desativa
+         */
+        static void set(const std::shared_ptr<SQLite::Database>& db, size_t capacity) {
+            if (!db)
+                return;
+
+            std::lock_guard<std::mutex> lock(mutex());
+            auto& capacities = registry();
+            for (auto it = capacities.begin(); it != capacities.end();) {
+                if (it->second.connection.expired())
+                    it = capacities.erase(it);
+                else
+                    ++it;
+            }
+            capacities[db.get()] = Entry {db, capacity};
+        }
+
+        /**
+         * @brief Obtém a capacidade registrada para uma conexão
+         * @param db Conexão com o banco de dados SQLite
+         * @return Capacidade registrada, ou IDENTITY_MAP_ENTRIES_DEFAULT
+         */
+        static size_t get(const SQLite::Database* db) {
+            std::lock_guard<std::mutex> lock(mutex());
+            auto found = registry().find(db);
+            if (found == registry().end() || found->second.connection.expired())
+                return IDENTITY_MAP_ENTRIES_DEFAULT;
+            return found->second.capacity;
+        }
+    };
+
+    /**
+     * @brief Mapa de identidade de uma conexão
+     * @tparam T Tipo da entidade mantida
+     *
+     * @details
+     * As entidades são indexadas pelo ID. Os repositórios consultam o mapa
+     * antes de ir ao banco e devem invalidar a entrada sempre que a linha
+     * correspondente for alterada ou removida. O mapa guarda no máximo
+     * `capacity` entidades, descartando as usadas há mais tempo; com
+     * capacidade zero ele fica desativado.
+     *
+     * O mapa é de uma única conexão: entidades lidas dentro de uma transação
+     * ainda não confirmada, ou de um snapshot antigo do WAL, não chegam às
+     * outras conexões. As alterações confirmadas por outras conexões são
+     * percebidas por sync(), que esvazia o mapa quando o `PRAGMA
+     * data_version` da conexão muda. Por isso um acerto no mapa ainda faz
+     * uma consulta ao SQLite, o `PRAGMA data_version`, embora não leia a
+     * linha da entidade.
+     */
+    template <typename T>
+    class IdentityMap {
+    public:
+        using Pointer = std::shared_ptr<T>;
+
+        /**
+         * @brief Contadores de uso do mapa
+         */
+        struct Stats {
+            size_t hits = 0;      /*!< @brief Entidades servidas pelo mapa */
+            size_t misses = 0;    /*!< @brief Buscas que precisaram ir ao banco */
+            size_t evictions = 0; /*!< @brief Entidades descartadas pelo LRU */
+            size_t size = 0;      /*!< @brief Entidades atualmente no mapa */
+        };
+
+    private:
+        using LruList = std::list<unsigned>;
+
+        /**
+         * @brief Entrada do mapa
+         */
+        struct Entry {
+            Pointer entity;
+            LruList::iterator position;
+        };
+
+        size_t _capacity; /*!< @brief Número máximo de entidades mantidas */
+        LruList _lru;     /*!< @brief IDs da entidade mais recente para a mais antiga */
+        std::unordered_map<unsigned, Entry> _entries;
+        int64_t _data_version; /*!< @brief data_version da conexão no último sync() */
+        mutable std::mutex _mutex;
+        Stats _stats;
+
+        /**
+         * @brief Descarta as entidades mais antigas até caber no limite
+         */
+        void evict();
+
+    public:
+        /**
+         * @brief Construtor do mapa
+         * @param capacity Número máximo de entidades mantidas
+         */
+        explicit IdentityMap(size_t capacity = IDENTITY_MAP_ENTRIES_DEFAULT);
+
+        IdentityMap(const IdentityMap&) = delete;
+        IdentityMap& operator=(const IdentityMap&) = delete;
+
+        /**
+         * @brief Obtém o mapa compartilhado de uma conexão
+         *
+         * Todos os repositórios criados sobre a mesma conexão usam o mesmo
+         * mapa, que existe enquanto algum deles existir. O mapa é criado com
+         * a capacidade de IdentityMapCapacity para a conexão.
+         *
+         * @param db Conexão com o banco de dados SQLite
+         * @return Mapa da conexão, ou nullptr se db for nulo
+         */
+        static std::shared_ptr<IdentityMap<T>>
+        forDatabase(const std::shared_ptr<SQLite::Database>& db);
+
+        /**
+         * @brief Busca uma entidade já materializada
+         * @param id ID da entidade
+         * @return Instância compartilhada, ou nullptr se não estiver no mapa
+         */
+        Pointer find(unsigned id);
+
+        /**
+         * @brief Registra uma entidade no mapa
+         *
+         * Se outra instância com o mesmo ID já tiver sido registrada, ela é
+         * mantida e retornada para que todos compartilhem o mesmo objeto.
+         *
+         * @param id ID da entidade
+         * @param entity Instância a ser registrada
+         * @return Instância mantida pelo mapa, ou a própria entity se o mapa
+         *         estiver desativado
+         */
+        Pointer insert(unsigned id, Pointer entity);
+
+        /**
+         * @brief Remove uma entidade do mapa
+         * @param id ID da entidade
+         */
+        void invalidate(unsigned id);
+
+        /**
+         * @brief Esvazia o mapa se outra conexão alterou o banco
+         * @param data_version Valor atual do `PRAGMA data_version` da conexão
+         * @return true se o mapa foi esvaziado
+         */
+        bool sync(int64_t data_version);
+
+        /**
+         * @brief Remove todas as entidades do mapa
+         */
+        void clear();
+
+        /**
+         * @brief Obtém o número de entidades mantidas
+         * @return Quantidade de entradas
+         */
+        size_t size() const;
+
+        /**
+         * @brief Obtém a capacidade do mapa
+         * @return Número máximo de entidades
+         */
+        size_t getCapacity() const;
+
+        /**
+         * @brief Define a capacidade do mapa
+         * @param capacity Número máximo de entidades, 0 desativa o mapa
+         */
+        void setCapacity(size_t capacity);
+
+        /**
+         * @brief Obtém os contadores de acertos e falhas
+         * @return Estatísticas do mapa
+         */
+        Stats getStats() const;
+    };
+
+}  // namespace core
+
+#include "core/bd/IdentityMap.tpp"
@@ -0,0 +1,158 @@
+/**
+ * @file IdentityMap.tpp
+ * @brief Implementação do mapa de identidade de entidades
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-21
+ */
+
+#ifndef IDENTITY_MAP_TPP
+#define IDENTITY_MAP_TPP
+
+namespace core {
+    template <typename T>
+    IdentityMap<T>::IdentityMap(size_t capacity)
+        : _capacity(capacity), _data_version(-1) {}
+
+    template <typename T>
+    std::shared_ptr<IdentityMap<T>>
+    IdentityMap<T>::forDatabase(const std::shared_ptr<SQLite::Database>& db) {
+        if (!db)
+            return nullptr;
+
+        static std::mutex registry_mutex;
+        static std::unordered_map<const SQLite::Database*,
+                                  std::weak_ptr<IdentityMap<T>>>
+            registry;
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+
+        auto found = registry.find(db.get());
+        if (found != registry.end()) {
+            auto map = found->second.lock();
+            if (map)
+                return map;
+        }
+
+        auto map = std::make_shared<IdentityMap<T>>(IdentityMapCapacity::get(db.get()));
+        registry[db.get()] = map;
+        return map;
+    }
+
+    template <typename T>
+    typename IdentityMap<T>::Pointer IdentityMap<T>::find(unsigned id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto found = _entries.find(id);
+        if (found == _entries.end()) {
+            _stats.misses++;
+            return nullptr;
+        }
+
+        _lru.splice(_lru.begin(), _lru, found->second.position);
+        _stats.hits++;
+        return found->second.entity;
+    }
+
+    template <typename T>
+    typename IdentityMap<T>::Pointer IdentityMap<T>::insert(unsigned id,
+                                                            Pointer entity) {
+        if (!entity)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_capacity == 0)
+            return entity;
+
+        auto found = _entries.find(id);
+        if (found != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, found->second.position);
+            return found->second.entity;
+        }
+
+        _lru.push_front(id);
+        _entries[id] = Entry {entity, _lru.begin()};
+        evict();
+
+        return entity;
+    }
+
+    template <typename T>
+    void IdentityMap<T>::evict() {
+        while (_entries.size() > _capacity && !_lru.empty()) {
+            _entries.erase(_lru.back());
+            _lru.pop_back();
+            _stats.evictions++;
+        }
+    }
+
+    template <typename T>
+    void IdentityMap<T>::invalidate(unsigned id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto found = _entries.find(id);
+        if (found == _entries.end())
+            return;
+
+        _lru.erase(found->second.position);
+        _entries.erase(found);
+    }
+
+    template <typename T>
+    bool IdentityMap<T>::sync(int64_t data_version) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (data_version == _data_version)
+            return false;
+
+        _data_version = data_version;
+        _entries.clear();
+        _lru.clear();
+        return true;
+    }
+
+    template <typename T>
+    void IdentityMap<T>::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+        _lru.clear();
+    }
+
+    template <typename T>
+    size_t IdentityMap<T>::size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    template <typename T>
+    size_t IdentityMap<T>::getCapacity() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _capacity;
+    }
+
+    template <typename T>
+    void IdentityMap<T>::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+        evict();
+    }
+
+    template <typename T>
+    typename IdentityMap<T>::Stats IdentityMap<T>::getStats() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Stats stats = _stats;
+        stats.size = _entries.size();
+        return stats;
+    }
+}  // namespace core
+
+#endif  // IDENTITY_MAP_TPP
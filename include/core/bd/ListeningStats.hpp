@@ -0,0 +1,146 @@
+/**
+ * @file ListeningStats.hpp
+ * @brief Consulta às estatísticas de reprodução da biblioteca
+ * @ingroup bd
+ *
+ * As estatísticas ficam nas tabelas `play_stats_song`, `play_stats_artist`,
+ * `play_stats_album` e `play_stats_day`, mantidas por triggers definidos em
+ * SchemaMigrations a cada reprodução gravada em `playback_history`.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-25
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/StatementCache.hpp"
+
+#define STATS_TOP_LIMIT_DEFAULT 10
+#define STATS_SECONDS_PER_DAY 86400
+
+namespace core {
+
+    /**
+     * @brief Estatísticas de reprodução de um usuário
+     *
+     * @details
+     * Todas as consultas leem as tabelas agregadas, então o custo depende
+     * apenas do tamanho do resultado e não do tamanho do histórico. Os dias
+     * são contados em UTC a partir de `played_at`.
+     */
+    class ListeningStats {
+    public:
+        /**
+         * @brief Total de reproduções de uma música, artista ou álbum
+         */
+        struct Entry {
+            unsigned id; /*!< @brief ID da entidade */
+            unsigned play_count; /*!< @brief Número de reproduções */
+            unsigned long long listen_seconds; /*!< @brief Tempo total ouvido em segundos */
+        };
+
+        /**
+         * @brief Total de reproduções de um dia
+         */
+        struct DayTotal {
+            std::time_t day; /*!< @brief Início do dia (UTC) */
+            unsigned play_count; /*!< @brief Número de reproduções */
+            unsigned long long listen_seconds; /*!< @brief Tempo total ouvido em segundos */
+        };
+
+    private:
+        std::shared_ptr<StatementCache> _statements; /*!< @brief Cache de declarações da conexão */
+
+        /**
+         * @brief Executa uma consulta de ranking de uma tabela agregada
+         * @param table Tabela agregada
+         * @param id_column Coluna com o ID da entidade
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Entidades da mais ouvida para a menos ouvida
+         */
+        std::vector<Entry> top(const char* table,
+                               const char* id_column,
+                               unsigned user_id,
+                               size_t limit) const;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param db Conexão com o banco de dados SQLite
+         */
+        explicit ListeningStats(std::shared_ptr<SQLite::Database> db);
+
+        /**
+         * @brief Obtém o número de reproduções de uma música
+         * @param user_id ID do usuário
+         * @param song_id ID da música
+         * @return Número de reproduções da música pelo usuário
+         */
+        unsigned playCount(unsigned user_id, unsigned song_id) const;
+
+        /**
+         * @brief Obtém as músicas mais ouvidas
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Músicas da mais ouvida para a menos ouvida
+         */
+        std::vector<Entry> topSongs(unsigned user_id,
+                                    size_t limit = STATS_TOP_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Obtém os artistas mais ouvidos
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Artistas do mais ouvido para o menos ouvido
+         */
+        std::vector<Entry> topArtists(unsigned user_id,
+                                      size_t limit = STATS_TOP_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Obtém os álbuns mais ouvidos
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Álbuns do mais ouvido para o menos ouvido
+         */
+        std::vector<Entry> topAlbums(unsigned user_id,
+                                     size_t limit = STATS_TOP_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Obtém os totais diários de um período
+         *
+         * O período é arredondado para dias inteiros: entram todos os dias
+         * que tenham algum instante em [from, to).
+         *
+         * @param user_id ID do usuário
+         * @param from Início do período
+         * @param to Fim do período (exclusivo)
+         * @return Dias com reproduções, em ordem cronológica
+         */
+        std::vector<DayTotal> listeningByDay(unsigned user_id,
+                                             std::time_t from,
+                                             std::time_t to) const;
+
+        /**
+         * @brief Obtém o tempo total ouvido em um período
+         *
+         * O período é arredondado para dias inteiros, como em listeningByDay().
+         *
+         * @param user_id ID do usuário
+         * @param from Início do período
+         * @param to Fim do período (exclusivo)
+         * @return Tempo ouvido em segundos
+         */
+        unsigned long long listeningTime(unsigned user_id,
+                                         std::time_t from,
+                                         std::time_t to) const;
+    };
+
+}  // namespace core
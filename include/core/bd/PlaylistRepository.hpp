@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 #include <string>
@@ -20,10 +21,20 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/SQLiteRepositoryBase.hpp"
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/UserRepository.hpp"
 #include "core/entities/Playlist.hpp"
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
 
+/**
+ * @brief Distância entre as posições de músicas consecutivas de uma playlist
+ *
+ * As posições são espaçadas para que mover ou inserir uma música só
+ * grave a própria linha, com uma posição entre as das vizinhas.
+ */
+#define PLAYLIST_POSITION_GAP 1024
+
 namespace core {
 
     /**
@@ -32,6 +43,8 @@ namespace core {
      */
     class PlaylistRepository : public SQLiteRepositoryBase<Playlist> {
     protected:
+        std::shared_ptr<UserRepository> _user_repo; /*!< @brief Fonte dos usuários compartilhados da conexão */
+
         /**
          * @brief Insere uma nova playlist no repositório
          * @copydoc IRepository::insert
@@ -43,19 +56,38 @@ namespace core {
         /**
          * @brief Atualiza uma playlist existente no repositório
          * @copydoc IRepository::update
+         *
+         * Se as músicas foram alteradas desde a carga, só as linhas
+         * inseridas, removidas ou movidas são gravadas, na mesma
+         * transação que o título.
+         *
          * @param entity Playlist a ser atualizada
          * @return true se a operação foi bem-sucedida, false caso contrário
          */
         bool update(const Playlist& entity) override;
 
+        /**
+         * @brief Grava a diferença entre as músicas da playlist e as do banco
+         *
+         * As músicas cuja ordem relativa não mudou (a maior subsequência
+         * crescente das posições gravadas) mantêm a posição; as demais
+         * recebem posições entre as das vizinhas. Quando não há espaço
+         * entre duas posições, a playlist inteira é renumerada.
+         *
+         * @param playlist Playlist com as músicas na ordem desejada
+         * @return true se a operação foi bem-sucedida, false caso contrário
+         */
+        bool saveSongChanges(const Playlist& playlist);
+
 
         /**
          * @brief Adiciona uma música a uma playlist
          * @param playlist Playlist onde a música será adicionada
-         * @param song Música a ser adicionada
+         * @param position Posição gravada da música
+         * @param song_id ID da música a ser adicionada
          * @return true se a operação foi bem-sucedida, false caso contrário
          */
-        bool addSongToPlaylist(const Playlist& playlist, size_t pos, const Song& song);
+        bool addSongToPlaylist(const Playlist& playlist, int64_t position, unsigned song_id);
 
         /**
          * @brief Mapeia uma linha do resultado para uma playlist
@@ -77,6 +109,22 @@ namespace core {
          */
         std::vector<std::shared_ptr<Playlist>> findByTitleAndUser(const std::string& title, const User& user) const;
 
+        /**
+         * @brief Busca playlists do usuário no índice de busca textual
+         *
+         * Os resultados são ordenados por relevância (BM25). Se a consulta
+         * não tiver termos indexáveis, recorre a findByTitleAndUser().
+         *
+         * @param query Texto digitado pelo usuário
+         * @param user Usuário cujas playlists serão buscadas
+         * @param limit Número máximo de resultados
+         * @return Vetor com as playlists encontradas, da mais relevante à menos
+         */
+        std::vector<std::shared_ptr<Playlist>>
+        search(const std::string& query,
+               const User& user,
+               size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
         /**
          * @brief Busca playlists pelo usuário
          * @param user Usuário dono das playlists
@@ -85,7 +133,7 @@ namespace core {
         std::vector<std::shared_ptr<Playlist>> findByUser(const User& user) const;
 
         /**
-         * @brief Obtém as músicas de uma playlist
+         * @brief Obtém as músicas de uma playlist, na ordem da playlist
          * @param playlist Playlist cujas músicas serão obtidas
          * @return Vetor contendo as músicas da playlist
          */
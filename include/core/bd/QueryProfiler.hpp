@@ -0,0 +1,196 @@
+/**
+ * @file QueryProfiler.hpp
+ * @brief Medição das consultas SQL e registro de consultas lentas
+ * @ingroup bd
+ *
+ * As conexões anexadas ao perfilador reportam, pelo `sqlite3_trace_v2`, o
+ * tempo de cada execução e cada linha produzida. Os números são agregados
+ * por texto SQL; execuções acima do limite vão para o log de consultas
+ * lentas junto com o `EXPLAIN QUERY PLAN` da consulta.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+struct sqlite3_stmt;
+
+#define QUERY_PROFILER_SLOW_MS_DEFAULT 100
+#define QUERY_PROFILER_BUCKETS 6
+#define QUERY_PROFILER_PENDING_MAX 256
+#define QUERY_PROFILER_REPORT_LIMIT_DEFAULT 15
+
+namespace core {
+
+    /**
+     * @brief Estatísticas das consultas executadas nas conexões anexadas
+     *
+     * @details
+     * Há uma única instância por processo, compartilhada por todas as
+     * conexões. O plano das consultas lentas não é obtido dentro do callback
+     * do SQLite: ele fica pendente até a próxima vez que uma declaração for
+     * preparada pelo StatementCache, que chama capturePending() só se
+     * enabled() indicar que alguma conexão foi anexada.
+     */
+    class QueryProfiler {
+    public:
+        /**
+         * @brief Números agregados de um texto SQL
+         */
+        struct SqlStats {
+            std::string sql; /*!< @brief Texto SQL, com os parâmetros não substituídos */
+            uint64_t calls = 0; /*!< @brief Número de execuções */
+            uint64_t total_ns = 0; /*!< @brief Tempo total em nanossegundos */
+            uint64_t max_ns = 0; /*!< @brief Execução mais lenta em nanossegundos */
+            uint64_t rows = 0; /*!< @brief Linhas produzidas em todas as execuções */
+            uint64_t fullscan_steps = 0; /*!< @brief Passos em varreduras completas de tabela */
+            uint64_t slow_calls = 0; /*!< @brief Execuções acima do limite */
+            std::array<uint64_t, QUERY_PROFILER_BUCKETS> histogram {}; /*!< @brief Execuções por faixa de tempo, ver bucketLabel() */
+            std::string plan; /*!< @brief Resultado de EXPLAIN QUERY PLAN, se a consulta já foi lenta */
+        };
+
+    private:
+        /**
+         * @brief Execução lenta aguardando a captura do plano e o log
+         */
+        struct SlowQuery {
+            std::string sql;
+            uint64_t elapsed_ns;
+            uint64_t rows;
+            std::time_t at;
+        };
+
+        mutable std::mutex _mutex;
+        std::unordered_map<sqlite3_stmt*, uint64_t> _rows; /*!< @brief Linhas da execução em andamento de cada declaração */
+        std::unordered_map<std::string, SqlStats> _stats; /*!< @brief Estatísticas por texto SQL */
+        std::deque<SlowQuery> _pending; /*!< @brief Execuções lentas ainda não registradas */
+        std::atomic<bool> _has_pending {false};
+        std::atomic<int64_t> _slow_ns {QUERY_PROFILER_SLOW_MS_DEFAULT * 1000000LL};
+        std::string _log_path; /*!< @brief Arquivo do log de consultas lentas; vazio desativa o arquivo */
+        inline static std::atomic<bool> _enabled {false}; /*!< @brief Alguma conexão já foi anexada */
+
+        QueryProfiler() = default;
+
+        /**
+         * @brief Callback registrado com sqlite3_trace_v2
+         */
+        static int traceCallback(unsigned type, void* context, void* p, void* x);
+
+        /**
+         * @brief Conta uma linha produzida por uma declaração
+         * @param statement Declaração em execução
+         */
+        void onRow(sqlite3_stmt* statement);
+
+        /**
+         * @brief Registra o fim de uma execução
+         * @param statement Declaração executada
+         * @param elapsed_ns Duração da execução em nanossegundos
+         */
+        void onProfile(sqlite3_stmt* statement, int64_t elapsed_ns);
+
+        /**
+         * @brief Obtém o plano de execução de uma consulta
+         * @param db Conexão usada para o EXPLAIN
+         * @param sql Texto SQL
+         * @return Plano em árvore indentada, ou string vazia se indisponível
+         */
+        static std::string explain(SQLite::Database& db, const std::string& sql);
+
+    public:
+        QueryProfiler(const QueryProfiler&) = delete;
+        QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+        /**
+         * @brief Obtém a instância do processo
+         * @return Perfilador compartilhado
+         */
+        static QueryProfiler& instance();
+
+        /**
+         * @brief Indica se o perfilador está em uso no processo
+         *
+         * Leitura atômica sem criar a instância, para que o caminho quente
+         * não pague nada com o perfilador desligado (o padrão).
+         *
+         * @return true depois que alguma conexão foi anexada por attach()
+         */
+        static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Passa a medir as consultas de uma conexão
+         * @param db Conexão a ser medida
+         */
+        void attach(SQLite::Database& db);
+
+        /**
+         * @brief Define a duração a partir da qual uma execução é lenta
+         * @param threshold Limite de tempo
+         */
+        void setSlowThreshold(std::chrono::milliseconds threshold);
+
+        /**
+         * @brief Obtém a duração a partir da qual uma execução é lenta
+         * @return Limite de tempo
+         */
+        std::chrono::milliseconds getSlowThreshold() const;
+
+        /**
+         * @brief Define o arquivo do log de consultas lentas
+         * @param path Caminho do arquivo; vazio mantém o log apenas em memória
+         */
+        void setSlowQueryLog(const std::string& path);
+
+        /**
+         * @brief Captura o plano e grava no log as execuções lentas pendentes
+         *
+         * Não faz nada se não houver pendências. Não deve ser chamado de
+         * dentro de um callback do SQLite.
+         *
+         * @param db Conexão usada para o EXPLAIN QUERY PLAN
+         */
+        void capturePending(SQLite::Database& db);
+
+        /**
+         * @brief Obtém as estatísticas, da consulta com maior tempo total
+         * para a menor
+         * @return Cópia das estatísticas
+         */
+        std::vector<SqlStats> snapshot() const;
+
+        /**
+         * @brief Monta um resumo legível das consultas mais caras
+         * @param limit Número máximo de consultas listadas
+         * @return Texto do resumo
+         */
+        std::string report(size_t limit = QUERY_PROFILER_REPORT_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Descarta todas as estatísticas e pendências
+         */
+        void reset();
+
+        /**
+         * @brief Obtém o rótulo de uma faixa do histograma
+         * @param bucket Índice da faixa
+         * @return Rótulo, por exemplo "<1ms"
+         */
+        static const char* bucketLabel(size_t bucket);
+    };
+
+}  // namespace core
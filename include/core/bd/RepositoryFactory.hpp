@@ -14,11 +14,15 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DataLoader.hpp"
 #include "core/bd/AlbumRepository.hpp"
 #include "core/bd/SongRepository.hpp"
 #include "core/bd/PlaylistRepository.hpp"
 #include "core/bd/HistoryPlaybackRepository.hpp"
 #include "core/bd/UserRepository.hpp"
+#include "core/bd/ScannedFileRepository.hpp"
+#include "core/bd/SummaryRepository.hpp"
+#include "core/bd/UnitOfWork.hpp"
 
 
 namespace core {
@@ -77,6 +81,30 @@ namespace core {
          * @return Ponteiro para o repositório de usuários
          */
         virtual std::unique_ptr<UserRepository> createUserRepository();
+
+        /**
+         * @brief Cria o repositório de resumos para listagens
+         * @return Ponteiro para o repositório de resumos
+         */
+        virtual std::unique_ptr<SummaryRepository> createSummaryRepository();
+
+        /**
+         * @brief Cria o repositório das impressões dos arquivos importados
+         * @return Ponteiro para o repositório de impressões
+         */
+        virtual std::unique_ptr<ScannedFileRepository> createScannedFileRepository();
+
+        /**
+         * @brief Abre uma transação que abrange os repositórios da fábrica
+         * @return Unidade de trabalho aberta na conexão da fábrica
+         */
+        std::unique_ptr<UnitOfWork> createUnitOfWork();
+
+        /**
+         * @brief Cria um DataLoader para as relações das músicas
+         * @return DataLoader que consulta a conexão da fábrica
+         */
+        std::unique_ptr<DataLoader> createDataLoader();
     };
 
 }
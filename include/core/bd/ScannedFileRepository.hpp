@@ -0,0 +1,79 @@
+/**
+ * @file ScannedFileRepository.hpp
+ * @brief Impressões dos arquivos já vistos pela importação
+ * @ingroup bd
+ *
+ * Permite que uma nova varredura dos diretórios de entrada pule, com um
+ * único stat(), os arquivos que não mudaram desde a anterior.
+ *
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/StatementCache.hpp"
+#include "core/util/FileFingerprint.hpp"
+
+namespace core {
+
+    /**
+     * @brief Acesso à tabela `scanned_files`
+     *
+     * @details
+     * A chave é o caminho do arquivo. Só os arquivos que continuam no
+     * diretório de entrada têm linha: os rejeitados (sem áudio ou sem tags)
+     * e os que falharam ao importar, que só voltam a ser lidos quando
+     * mudarem. A linha de um arquivo importado é apagada quando ele é movido
+     * para a biblioteca.
+     */
+    class ScannedFileRepository {
+    private:
+        std::shared_ptr<StatementCache> _statements; /*!< @brief Cache de declarações da conexão */
+
+    public:
+        /**
+         * @brief Construtor
+         * @param db Conexão com o banco de dados SQLite
+         */
+        explicit ScannedFileRepository(std::shared_ptr<SQLite::Database> db);
+
+        /**
+         * @brief Obtém a impressão de um arquivo
+         * @param path Caminho do arquivo
+         * @return Impressão gravada, ou std::nullopt se o arquivo nunca foi visto
+         */
+        std::optional<FileFingerprint> find(const std::string& path) const;
+
+        /**
+         * @brief Obtém as impressões dos arquivos dentro de um diretório
+         * @param directory Diretório, incluindo subdiretórios
+         * @return Impressões indexadas pelo caminho
+         */
+        std::unordered_map<std::string, FileFingerprint>
+        findUnder(const std::string& directory) const;
+
+        /**
+         * @brief Grava ou substitui a impressão de um arquivo
+         * @param fingerprint Impressão com o caminho e a situação da importação
+         * @param user_id Dono do arquivo
+         * @return true se a linha foi gravada
+         */
+        bool save(const FileFingerprint& fingerprint, unsigned user_id) const;
+
+        /**
+         * @brief Esquece um arquivo
+         * @param path Caminho do arquivo
+         * @return true se havia impressão para o caminho
+         */
+        bool remove(const std::string& path) const;
+    };
+
+}  // namespace core
@@ -0,0 +1,71 @@
+/**
+ * @file SchemaMigrations.hpp
+ * @brief Versionamento do esquema do banco de dados
+ * @ingroup bd
+ *
+ * A versão do esquema é guardada em `PRAGMA user_version`. As migrações são
+ * embutidas no executável e aplicadas em ordem, cada uma em sua transação.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-24
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+namespace core {
+
+    /**
+     * @brief Migração do esquema para uma versão
+     */
+    struct SchemaMigration {
+        int version;             /*!< @brief Versão do esquema após a migração */
+        const char* description; /*!< @brief Descrição da mudança */
+        const char* sql;         /*!< @brief Comandos SQL da migração */
+    };
+
+    /**
+     * @brief Migrações do esquema do banco de dados
+     *
+     * @details
+     * Um banco já atualizado é aberto com uma única leitura de
+     * `PRAGMA user_version`. Para alterar o esquema, acrescente uma nova
+     * migração ao final de all() e atualize config/frankenstein_schema.sql.
+     */
+    class SchemaMigrations {
+    public:
+        /**
+         * @brief Obtém todas as migrações em ordem crescente de versão
+         * @return Lista de migrações
+         */
+        static const std::vector<SchemaMigration>& all();
+
+        /**
+         * @brief Obtém a versão do esquema que esta versão do programa espera
+         * @return Versão da última migração
+         */
+        static int latestVersion();
+
+        /**
+         * @brief Obtém a versão do esquema de um banco
+         * @param db Conexão com o banco de dados SQLite
+         * @return Valor de `PRAGMA user_version`
+         */
+        static int currentVersion(SQLite::Database& db);
+
+        /**
+         * @brief Aplica as migrações pendentes
+         *
+         * Lança std::runtime_error se o banco tiver uma versão mais nova do
+         * que a suportada.
+         *
+         * @param db Conexão de escrita com o banco de dados SQLite
+         * @return Número de migrações aplicadas
+         */
+        static int migrate(SQLite::Database& db);
+    };
+
+}  // namespace core
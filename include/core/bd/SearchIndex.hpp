@@ -0,0 +1,109 @@
+/**
+ * @file SearchIndex.hpp
+ * @brief Consulta ao índice de busca textual da biblioteca
+ * @ingroup bd
+ *
+ * O índice é a tabela FTS5 `search_index`, mantida por triggers definidos em
+ * SchemaMigrations sobre músicas, artistas, álbuns e playlists.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-23
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/StatementCache.hpp"
+
+#define SEARCH_LIMIT_DEFAULT 50
+
+namespace core {
+
+    /**
+     * @brief Busca ranqueada sobre o índice FTS5 da biblioteca
+     *
+     * @details
+     * Cada termo da consulta é tratado como prefixo e todos precisam estar
+     * presentes. Os resultados vêm ordenados por BM25, com peso maior para o
+     * título, depois artista, álbum e gênero.
+     */
+    class SearchIndex {
+    public:
+        /**
+         * @brief Tipo de entidade indexada
+         */
+        enum class Kind {
+            Song,
+            Artist,
+            Album,
+            Playlist
+        };
+
+        /**
+         * @brief Resultado da busca
+         */
+        struct Hit {
+            unsigned id; /*!< @brief ID da entidade encontrada */
+            double rank; /*!< @brief Pontuação BM25 (menor é mais relevante) */
+        };
+
+    private:
+        std::shared_ptr<StatementCache> _statements; /*!< @brief Cache de declarações da conexão */
+
+        /**
+         * @brief Obtém o nome do tipo como gravado na coluna `kind`
+         * @param kind Tipo de entidade
+         * @return Nome do tipo
+         */
+        static const char* kindName(Kind kind);
+
+    public:
+        /**
+         * @brief Construtor
+         * @param db Conexão com o banco de dados SQLite
+         */
+        explicit SearchIndex(std::shared_ptr<SQLite::Database> db);
+
+        /**
+         * @brief Converte o texto digitado em uma expressão MATCH do FTS5
+         *
+         * Os termos são separados por espaços, as aspas são removidas e cada
+         * termo vira uma busca por prefixo entre aspas, de modo que nenhum
+         * caractere do usuário seja interpretado como operador do FTS5.
+         *
+         * @param query Texto digitado pelo usuário
+         * @return Expressão MATCH, ou string vazia se não houver termos
+         */
+        static std::string toMatchExpression(const std::string& query);
+
+        /**
+         * @brief Obtém a expressão de ranqueamento BM25 do índice
+         *
+         * Para consultas que fazem JOIN com `search_index` e precisam da
+         * mesma ordenação de search().
+         *
+         * @return Expressão SQL; valores menores são mais relevantes
+         */
+        static const char* rankExpression();
+
+        /**
+         * @brief Busca entidades de um usuário no índice
+         * @param query Texto digitado pelo usuário
+         * @param kind Tipo de entidade buscada
+         * @param user_id ID do usuário dono das entidades
+         * @param limit Número máximo de resultados
+         * @return Resultados do mais relevante para o menos relevante
+         */
+        std::vector<Hit> search(const std::string& query,
+                                Kind kind,
+                                unsigned user_id,
+                                size_t limit = SEARCH_LIMIT_DEFAULT) const;
+    };
+
+}  // namespace core
@@ -13,11 +13,14 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
 #include "core/bd/SQLiteRepositoryBase.hpp"
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/UserRepository.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/Artist.hpp"
 #include "core/entities/EntitiesFWD.hpp"
@@ -32,6 +35,8 @@ namespace core {
      */
     class SongRepository : public SQLiteRepositoryBase<Song>{
     protected:
+        std::shared_ptr<UserRepository> _user_repo; /*!< @brief Fonte dos usuários compartilhados da conexão */
+
         /**
          * @brief Insere uma nova musica no repositório
          * @copydoc IRepository::insert
@@ -88,6 +93,22 @@ namespace core {
         std::vector<std::shared_ptr<Song>>
         findByTitleAndUser(const std::string &title, const User &user) const;
 
+        /**
+         * @brief Busca musicas do usuário no índice de busca textual
+         *
+         * Os resultados são ordenados por relevância (BM25). Se a consulta
+         * não tiver termos indexáveis, recorre a findByTitleAndUser().
+         *
+         * @param query Texto digitado pelo usuário
+         * @param user Usuário cujas musicas serão buscadas
+         * @param limit Número máximo de resultados
+         * @return Vetor com as musicas encontradas, da mais relevante à menos
+         */
+        std::vector<std::shared_ptr<Song>>
+        search(const std::string& query,
+               const User& user,
+               size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
         /**
          * @brief Busca musicas pelo usuário
          * @param user Usuário dono das musicas a serem buscadas
@@ -95,6 +116,25 @@ namespace core {
          */
         std::vector<std::shared_ptr<Song>> findByUser(const User &user) const;
 
+        /**
+         * @brief Busca uma página das musicas do usuário por paginação por chave
+         * @param user Usuário dono das musicas
+         * @param after_id Apenas musicas com ID maior que este são retornadas
+         * @param limit Número máximo de musicas
+         * @return Musicas em ordem crescente de ID
+         */
+        std::vector<std::shared_ptr<Song>>
+        findByUser(const User &user, unsigned after_id, size_t limit) const;
+
+        /**
+         * @brief Percorre as musicas do usuário, uma por vez, em ordem de título
+         * @param user Usuário dono das musicas
+         * @param callback Função chamada para cada musica; retornar false
+         *        interrompe a leitura
+         * @return Número de musicas entregues ao callback
+         */
+        size_t forEachByUser(const User &user, const RowCallback &callback) const;
+
         /**
          * @brief Busca musicas pelo artista
          * @param artist Artista da musica a ser buscada
@@ -104,6 +144,16 @@ namespace core {
         std::vector<std::shared_ptr<Song>>
         findByArtist(const Artist &artist) const;
 
+        /**
+         * @brief Percorre as musicas do artista, uma por vez, em ordem de título
+         * @param artist Artista das musicas
+         * @param callback Função chamada para cada musica; retornar false
+         *        interrompe a leitura
+         * @return Número de musicas entregues ao callback
+         */
+        size_t forEachByArtist(const Artist &artist,
+                               const RowCallback &callback) const;
+
         /**
          * @brief Busca musicas pelo album
          * @param album Album da musica a ser buscada
@@ -112,6 +162,16 @@ namespace core {
         std::vector<std::shared_ptr<Song>>
         findByAlbum(const Album &album) const;
 
+        /**
+         * @brief Percorre as musicas do album, uma por vez, em ordem de título
+         * @param album Album das musicas
+         * @param callback Função chamada para cada musica; retornar false
+         *        interrompe a leitura
+         * @return Número de musicas entregues ao callback
+         */
+        size_t forEachByAlbum(const Album &album,
+                              const RowCallback &callback) const;
+
         /**
          * @brief Busca uma musica pelo ID
          * @param id ID da musica a ser buscada
@@ -142,6 +202,17 @@ namespace core {
         std::vector<std::shared_ptr<Artist>>
         getFeaturingArtists(const Song &song) const;
 
+        /**
+         * @brief Obtém os artistas colaboradores de várias musicas
+         *
+         * Usa `WHERE song_id IN (...)` em vez de uma consulta por musica.
+         *
+         * @param song_ids IDs distintos das musicas
+         * @return Artistas colaboradores de cada musica que tiver algum
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+        getFeaturingArtists(const std::vector<unsigned> &song_ids) const;
+
         /**
          * @brief Conta o número total de musicas no repositório
          * @return Número total de musicas
@@ -0,0 +1,197 @@
+/**
+ * @file StatementCache.hpp
+ * @brief Cache de declarações SQL preparadas
+ * @ingroup bd
+ *
+ * Mantém, por conexão, as declarações SQL já preparadas para que consultas
+ * repetidas não precisem ser analisadas e planejadas novamente pelo SQLite.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#define STATEMENT_CACHE_SIZE_DEFAULT 64
+#define STATEMENT_CACHE_IDS_PER_QUERY 512
+
+namespace core {
+
+    /**
+     * @brief Cache LRU de declarações preparadas de uma conexão
+     *
+     * @details
+     * As declarações são indexadas pelo texto SQL. Ao serem devolvidas ao
+     * cache (quando o ponteiro obtido em acquire() é liberado) elas passam por
+     * reset() e clearBindings(), ficando prontas para reuso. Se a mesma
+     * consulta for pedida enquanto a declaração em cache ainda estiver em uso
+     * (consultas aninhadas), uma declaração avulsa é criada.
+     *
+     * O ponteiro emprestado não mantém o cache vivo. Ao destruir o cache
+     * todas as declarações, inclusive as ainda emprestadas, são finalizadas
+     * antes que a conexão possa ser fechada; o ponteiro deixa de ser
+     * utilizável, mas liberá-lo depois disso continua seguro.
+     */
+    class StatementCache {
+    public:
+        using StatementPtr = std::shared_ptr<SQLite::Statement>;
+
+        /**
+         * @brief Contadores de uso do cache
+         */
+        struct Stats {
+            size_t hits = 0;      /*!< @brief Declarações reaproveitadas */
+            size_t misses = 0;    /*!< @brief Declarações preparadas */
+            size_t evictions = 0; /*!< @brief Declarações descartadas pelo LRU */
+            size_t size = 0;      /*!< @brief Declarações atualmente em cache */
+        };
+
+    private:
+        /**
+         * @brief Entrada do cache
+         */
+        struct Entry {
+            std::string sql;
+            std::unique_ptr<SQLite::Statement> statement;
+            std::atomic<bool> in_use {false};
+            std::mutex mutex; /*!< @brief Protege statement entre a devolução e o destrutor do cache */
+        };
+
+        using EntryPtr = std::shared_ptr<Entry>;
+        using LruList = std::list<EntryPtr>;
+
+        std::shared_ptr<SQLite::Database> _db; /*!< @brief Conexão dona das declarações */
+        size_t _capacity; /*!< @brief Número máximo de declarações em cache */
+        LruList _lru;     /*!< @brief Entradas da mais recente para a mais antiga */
+        std::unordered_map<std::string_view, LruList::iterator> _index; /*!< @brief Chaves apontam para Entry::sql */
+        std::vector<std::weak_ptr<Entry>> _detached; /*!< @brief Declarações avulsas emprestadas */
+        mutable std::mutex _mutex;
+        Stats _stats;
+
+        /**
+         * @brief Descarta entradas antigas que não estão em uso até caber no limite
+         */
+        void evict();
+
+        /**
+         * @brief Cria o ponteiro entregue ao chamador para uma entrada
+         *
+         * O ponteiro guarda só uma referência fraca à entrada, que pertence
+         * ao cache: se o cache já foi destruído, liberar o ponteiro não faz
+         * nada.
+         *
+         * @param entry Entrada do cache
+         * @return Ponteiro que devolve a declaração ao cache ao ser liberado
+         */
+        static StatementPtr lease(const EntryPtr& entry);
+
+        /**
+         * @brief Cria o ponteiro de uma declaração avulsa
+         * @param entry Entrada fora do LRU, registrada em _detached
+         * @return Ponteiro que finaliza a declaração ao ser liberado
+         */
+        static StatementPtr leaseDetached(const EntryPtr& entry);
+
+        /**
+         * @brief Finaliza a declaração de uma entrada
+         * @param entry Entrada do cache
+         */
+        static void finalize(Entry& entry);
+
+    public:
+        /**
+         * @brief Construtor do cache
+         * @param db Conexão com o banco de dados SQLite
+         * @param capacity Número máximo de declarações mantidas
+         */
+        StatementCache(std::shared_ptr<SQLite::Database> db,
+                       size_t capacity = STATEMENT_CACHE_SIZE_DEFAULT);
+        ~StatementCache();
+
+        StatementCache(const StatementCache&) = delete;
+        StatementCache& operator=(const StatementCache&) = delete;
+
+        /**
+         * @brief Obtém o cache compartilhado de uma conexão
+         *
+         * Todos os repositórios criados sobre a mesma conexão usam o mesmo
+         * cache, que existe enquanto algum deles existir.
+         *
+         * @param db Conexão com o banco de dados SQLite
+         * @return Cache da conexão, ou nullptr se db for nulo
+         */
+        static std::shared_ptr<StatementCache>
+        forDatabase(const std::shared_ptr<SQLite::Database>& db);
+
+        /**
+         * @brief Obtém uma declaração preparada para o SQL informado
+         *
+         * Buscar uma declaração já em cache não aloca memória, de modo que
+         * SQL constante (como o gerado por EntityTraits) não custa nada além
+         * do hash.
+         *
+         * @param sql Consulta SQL
+         * @return Declaração pronta para receber parâmetros
+         */
+        StatementPtr acquire(std::string_view sql);
+
+        /**
+         * @brief Executa uma consulta `IN (...)` em lotes de IDs
+         *
+         * O número de marcadores é arredondado para uma potência de dois,
+         * até STATEMENT_CACHE_IDS_PER_QUERY, para que o cache guarde poucas
+         * variações da consulta; lotes incompletos repetem o último ID.
+         *
+         * @param ids IDs distintos a consultar
+         * @param prefix SQL terminado em "IN ("
+         * @param suffix SQL acrescentado depois do ")" que fecha a lista
+         * @param row Função chamada para cada linha do resultado
+         */
+        void forEachIdBatch(const std::vector<unsigned>& ids,
+                            std::string_view prefix,
+                            std::string_view suffix,
+                            const std::function<void(SQLite::Statement&)>& row);
+
+        /**
+         * @brief Descarta todas as declarações que não estão em uso
+         */
+        void clear();
+
+        /**
+         * @brief Obtém a capacidade do cache
+         * @return Número máximo de declarações
+         */
+        size_t getCapacity() const;
+
+        /**
+         * @brief Define a capacidade do cache
+         * @param capacity Número máximo de declarações
+         */
+        void setCapacity(size_t capacity);
+
+        /**
+         * @brief Obtém os contadores de acertos e falhas
+         * @return Estatísticas do cache
+         */
+        Stats getStats() const;
+
+        /**
+         * @brief Zera os contadores de acertos, falhas e descartes
+         */
+        void resetStats();
+    };
+
+}  // namespace core
@@ -0,0 +1,121 @@
+/**
+ * @file SummaryRepository.hpp
+ * @brief Consultas de projeção para telas de listagem
+ * @ingroup bd
+ *
+ * Alternativa somente leitura aos repositórios de entidades: cada consulta
+ * faz um único JOIN e devolve resumos em um vetor contíguo, sem criar
+ * entidades, loaders ou cópias do usuário.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/StatementCache.hpp"
+#include "core/entities/Summaries.hpp"
+
+namespace core {
+
+    /**
+     * @brief Consultas que devolvem resumos de músicas, álbuns e artistas
+     *
+     * @details
+     * As buscas textuais usam o mesmo índice FTS5 e a mesma ordenação por
+     * relevância dos repositórios de entidades. Sem termos indexáveis, caem
+     * para uma busca por LIKE no título ou nome.
+     */
+    class SummaryRepository {
+    private:
+        std::shared_ptr<StatementCache> _statements; /*!< @brief Cache de declarações da conexão */
+
+        /**
+         * @brief Lê a linha atual de uma consulta de músicas
+         * @param query Declaração com id, title, artist, album e duration
+         * @return Resumo da música
+         */
+        static SongSummary readSong(SQLite::Statement& query);
+
+        /**
+         * @brief Lê a linha atual de uma consulta de álbuns
+         * @param query Declaração com id, title, artist, year e songs_count
+         * @return Resumo do álbum
+         */
+        static AlbumSummary readAlbum(SQLite::Statement& query);
+
+        /**
+         * @brief Lê a linha atual de uma consulta de artistas
+         * @param query Declaração com id, name e songs_count
+         * @return Resumo do artista
+         */
+        static ArtistSummary readArtist(SQLite::Statement& query);
+
+    public:
+        /**
+         * @brief Construtor
+         * @param db Conexão com o banco de dados SQLite
+         */
+        explicit SummaryRepository(std::shared_ptr<SQLite::Database> db);
+
+        /**
+         * @brief Busca músicas do usuário
+         * @param query Texto digitado pelo usuário
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Resumos do mais relevante para o menos relevante
+         */
+        std::vector<SongSummary> searchSongs(const std::string& query,
+                                             unsigned user_id,
+                                             size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Busca álbuns do usuário
+         * @param query Texto digitado pelo usuário
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Resumos do mais relevante para o menos relevante
+         */
+        std::vector<AlbumSummary> searchAlbums(const std::string& query,
+                                               unsigned user_id,
+                                               size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Busca artistas do usuário
+         * @param query Texto digitado pelo usuário
+         * @param user_id ID do usuário
+         * @param limit Número máximo de resultados
+         * @return Resumos do mais relevante para o menos relevante
+         */
+        std::vector<ArtistSummary> searchArtists(const std::string& query,
+                                                 unsigned user_id,
+                                                 size_t limit = SEARCH_LIMIT_DEFAULT) const;
+
+        /**
+         * @brief Obtém os resumos de uma lista de músicas
+         *
+         * As consultas agrupam até STATEMENT_CACHE_IDS_PER_QUERY IDs por vez. IDs
+         * repetidos são permitidos e IDs inexistentes são ignorados.
+         *
+         * @param ids IDs das músicas
+         * @return Resumos na mesma ordem dos IDs
+         */
+        std::vector<SongSummary> songsByIds(const std::vector<unsigned>& ids) const;
+
+        /**
+         * @brief Obtém os resumos das músicas de uma playlist
+         * @param playlist_id ID da playlist
+         * @return Resumos na ordem da playlist
+         */
+        std::vector<SongSummary> playlistSongs(unsigned playlist_id) const;
+    };
+
+}  // namespace core
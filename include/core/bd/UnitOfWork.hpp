@@ -0,0 +1,89 @@
+/**
+ * @file UnitOfWork.hpp
+ * @brief Transação com escopo que abrange vários repositórios
+ * @ingroup bd
+ *
+ * Os repositórios criados pela mesma RepositoryFactory compartilham a
+ * conexão; uma UnitOfWork aberta nessa conexão agrupa as escritas de todos
+ * eles em uma única transação, confirmada ou desfeita como um todo.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-30
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+namespace core {
+
+    /**
+     * @brief Transação RAII com aninhamento por savepoints
+     *
+     * Aberta fora de uma transação, inicia uma com `BEGIN IMMEDIATE`, que
+     * reserva a escrita desde o início. Aberta dentro de outra, cria um
+     * savepoint: desfazê-la descarta só as próprias escritas, e confirmá-la
+     * as entrega à transação de fora.
+     *
+     * Se não for confirmada, a unidade é desfeita no destrutor, inclusive
+     * quando uma exceção a interrompe. Ao desfazer, os mapas de identidade
+     * da conexão são esvaziados, pois podem guardar linhas descartadas.
+     * Entidades inseridas na unidade desfeita mantêm o ID atribuído e devem
+     * ser descartadas.
+     */
+    class UnitOfWork {
+    private:
+        std::shared_ptr<SQLite::Database> _db; /*!< @brief Conexão compartilhada pelos repositórios */
+        std::string _savepoint; /*!< @brief Nome do savepoint; vazio na unidade de fora */
+        bool _active; /*!< @brief Ainda não confirmada nem desfeita */
+
+        /**
+         * @brief Esvazia os mapas de identidade da conexão
+         */
+        void clearIdentityMaps();
+
+    public:
+        /**
+         * @brief Abre a unidade na conexão
+         * @param db Conexão usada pelos repositórios
+         * @throws SQLite::Exception se não for possível iniciar a transação
+         */
+        explicit UnitOfWork(std::shared_ptr<SQLite::Database> db);
+
+        UnitOfWork(const UnitOfWork&) = delete;
+        UnitOfWork& operator=(const UnitOfWork&) = delete;
+
+        /**
+         * @brief Desfaz a unidade se ela não foi confirmada
+         */
+        ~UnitOfWork();
+
+        /**
+         * @brief Confirma as escritas da unidade
+         * @throws std::runtime_error se a unidade já foi encerrada
+         */
+        void commit();
+
+        /**
+         * @brief Desfaz as escritas da unidade
+         * @throws std::runtime_error se a unidade já foi encerrada
+         */
+        void rollback();
+
+        /**
+         * @brief Verifica se a unidade está dentro de outra transação
+         * @return true se a unidade for um savepoint
+         */
+        bool isNested() const;
+
+        /**
+         * @brief Verifica se a unidade ainda pode ser confirmada ou desfeita
+         * @return true se a unidade estiver aberta
+         */
+        bool isActive() const;
+    };
+
+}  // namespace core
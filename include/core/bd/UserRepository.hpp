@@ -13,6 +13,7 @@
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "core/bd/IdentityMap.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 // #include "core/entities/User.hpp"
 #include "core/entities/EntitiesFWD.hpp" // TODO incluir usuario
@@ -26,6 +27,8 @@ namespace core {
      */
     class UserRepository : public SQLiteRepositoryBase<User> {
     protected:
+        std::shared_ptr<IdentityMap<const User>> _shared_users; /*!< @brief Usuários já carregados nesta conexão */
+
         /**
          * @brief Insere um novo usuario no repositório
          * @copydoc IRepository::insert
@@ -63,6 +66,34 @@ namespace core {
          */
         bool save(User& entity) override;
 
+        /**
+         * @brief Remove um usuario pelo ID
+         * @copydoc IRepository::remove
+         * @param id ID do usuario a ser removido
+         * @return true se a operação foi bem-sucedida, false caso contrário
+         */
+        bool remove(unsigned id) override;
+
+        /**
+         * @brief Remove todos os usuarios
+         * @copydoc IRepository::removeAll
+         * @return true se a operação foi bem-sucedida, false caso contrário
+         */
+        bool removeAll() override;
+
+        /**
+         * @brief Busca um usuario compartilhado pelo ID
+         *
+         * O usuario é carregado uma única vez por conexão e a mesma instância,
+         * imutável, é entregue a todas as entidades que pertencem a ele. O
+         * cache é esvaziado quando outra conexão altera o banco e quando uma
+         * UnitOfWork é desfeita, como os mapas de identidade das entidades.
+         *
+         * @param id ID do usuario
+         * @return Usuario compartilhado, ou nullptr se não encontrado
+         */
+        std::shared_ptr<const User> findSharedById(unsigned id) const;
+
         /**
          * @brief Busca usuarios pelo nome de usuário
          * @param username Nome de usuário a ser buscado
@@ -46,7 +46,7 @@ namespace core {
         std::string _title;
 #endif // _WIN32
 
-        std::shared_ptr<User> _user;
+        std::shared_ptr<const User> _user;
         std::string _genre;
         int _year;
         // unsigned _user_id;
@@ -57,6 +57,8 @@ namespace core {
         mutable std::unordered_set<unsigned int> _song_ids;
 
         mutable bool _songsLoaded = false;
+        bool _songs_count_known = false;
+        size_t _songs_count = 0;
 
         std::function<std::vector<std::shared_ptr<Song>>()> songsLoader;
         std::function<std::shared_ptr<Artist>()> artistLoader;
@@ -187,6 +189,10 @@ namespace core {
 
         /**
          * @brief Obtém a quantidade de músicas no álbum
+         *
+         * Se as músicas ainda não foram carregadas e a contagem foi informada
+         * por setSongsCount(), ela é usada sem carregar as músicas.
+         *
          * @return Número total de músicas
          */
         size_t getSongsCount() const override;
@@ -229,12 +235,24 @@ namespace core {
          */
         void setYear(int year);
 
+        /**
+         * @brief Informa a quantidade de músicas lida junto com o álbum
+         * @param count Número de músicas do álbum
+         */
+        void setSongsCount(size_t count);
+
         /**
          * @brief Define o usuário associado ao álbum
          * @param user Ponteiro compartilhado para o usuário
          */
         void setUser(const User& user);
 
+        /**
+         * @brief Define o usuário associado ao álbum, compartilhando a instância
+         * @param user Ponteiro compartilhado para o usuário
+         */
+        void setUser(std::shared_ptr<const User> user);
+
         /**
          * @brief Define a função para carregar o artista do álbum
          * @param loader Função que retorna um ponteiro compartilhado para o
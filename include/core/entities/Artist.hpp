@@ -50,7 +50,7 @@ namespace core {
         mutable std::vector<std::shared_ptr<Album>> _albums;
         mutable std::unordered_set<unsigned int> _album_ids;
         mutable bool _albumsLoaded = false;
-        std::shared_ptr<User> _user;
+        std::shared_ptr<const User> _user;
         unsigned _user_id;
         std::function<std::vector<std::shared_ptr<Song>>()> songsLoader;
         std::function<std::vector<std::shared_ptr<Album>>()> albumsLoader;
@@ -97,6 +97,16 @@ namespace core {
                std::string name,
                const User &user);
 
+        /**
+         * @brief Construtor da classe Artist que compartilha o usuário
+         * @param id ID do artista
+         * @param name Nome do artista
+         * @param user Usuário compartilhado associado ao artista
+         */
+        Artist(unsigned id,
+               std::string name,
+               std::shared_ptr<const User> user);
+
         /**
          * @brief Construtor da classe Artist
          * @param name Nome do artista
@@ -209,6 +219,12 @@ namespace core {
          */
         void setUser(const User &user);
 
+        /**
+         * @brief Define o usuário associado ao artista, compartilhando a instância
+         * @param user Ponteiro compartilhado para o usuário
+         */
+        void setUser(std::shared_ptr<const User> user);
+
         /**
          * @brief Adiciona uma música ao artista
          * @param song Música a ser adicionada
@@ -29,9 +29,10 @@ namespace core {
      */
     class HistoryPlayback : public Entity {
     private:
-        std::shared_ptr<User> _user;  // Associação com a entidade User
+        std::shared_ptr<const User> _user;  // Associação com a entidade User
         std::shared_ptr<Song> _song;  // Associação com a entidade Song
         std::time_t _played_at;
+        unsigned _play_duration = 0;  // Segundos efetivamente reproduzidos
 
     public:
         HistoryPlayback();
@@ -43,6 +44,10 @@ namespace core {
                         User& user,
                         Song& song,
                         std::time_t played_at);
+        HistoryPlayback(unsigned id,
+                        std::shared_ptr<const User> user,
+                        Song& song,
+                        std::time_t played_at);
         HistoryPlayback(User& user,
                         Song& song,
                         std::time_t played_at);
@@ -60,6 +65,12 @@ namespace core {
          */
         void setUser(const User& user);
 
+        /**
+         * @brief Define o usuário, compartilhando a instância
+         * @param user Ponteiro compartilhado para o usuário
+         */
+        void setUser(std::shared_ptr<const User> user);
+
         /**
          * @brief Obtém a música associada ao histórico de reprodução
          * @return Ponteiro compartilhado para a música
@@ -84,6 +95,18 @@ namespace core {
          */
         void setPlayedAt(std::time_t played_at);
 
+        /**
+         * @brief Obtém por quanto tempo a música foi reproduzida
+         * @return Duração da reprodução em segundos
+         */
+        unsigned getPlayDuration() const;
+
+        /**
+         * @brief Define por quanto tempo a música foi reproduzida
+         * @param play_duration Duração da reprodução em segundos
+         */
+        void setPlayDuration(unsigned play_duration);
+
         /**
          * @brief Obtém uma representação em string do histórico de reprodução
          * @return String representando o histórico de reprodução
@@ -39,11 +39,12 @@ namespace core {
                      public IPlayable {
     private:
         std::string _title;
-        std::shared_ptr<User> _user;
+        std::shared_ptr<const User> _user;
         mutable std::vector<std::shared_ptr<Song>> _songs;
         mutable std::unordered_set<unsigned int> _song_ids;
         std::function<std::vector<std::shared_ptr<Song>>()> _loader;
         mutable bool _songsLoaded = false;
+        mutable bool _songsChanged = false; /*!< @brief Músicas alteradas desde a carga ou a última gravação */
 
         std::vector<std::shared_ptr<Song>> loadSongs() const;
 
@@ -265,6 +266,13 @@ namespace core {
          */
         void setUser(const User& user);
 
+        /**
+         * @brief Define o usuário da playlist, compartilhando a instância
+         *
+         * @param user usuário compartilhado
+         */
+        void setUser(std::shared_ptr<const User> user);
+
         /**
          * @brief Verifica se a playlist contém uma música com o ID especificado
          * @param songId ID da música a ser verificada
@@ -405,5 +413,22 @@ namespace core {
          * @param toIndex índice para o qual a música será movida
          */
         void moveSong(unsigned fromIndex, unsigned toIndex);
+
+        /**
+         * @brief Verifica se as músicas da playlist foram alteradas desde
+         * a carga ou a última gravação
+         *
+         * Uma playlist cujas músicas nunca foram carregadas não tem
+         * alterações pendentes.
+         *
+         * @return true se houver inserções, remoções ou movimentações pendentes
+         */
+        bool hasSongChanges() const;
+
+        /**
+         * @brief Marca as músicas como gravadas
+         * @note Chamado pelo repositório após persistir as alterações
+         */
+        void clearSongChanges() const;
     };
 }  // namespace core
@@ -15,6 +15,7 @@
 #include "core/entities/User.hpp"
 #include "core/interfaces/IPlayable.hpp"
 #include "core/interfaces/IPlayableObject.hpp"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <miniaudio.h>
@@ -47,7 +48,7 @@ namespace core {
 #else
         std::string _title;
 #endif // _WIN32
-        std::shared_ptr<User> _user;
+        std::shared_ptr<const User> _user;
         unsigned _artist_id;
         mutable std::weak_ptr<Artist> _artist;
         mutable std::vector<unsigned> _featuring_artists_ids;
@@ -57,6 +58,9 @@ namespace core {
         std::string _genre;
         int _year;
         unsigned _track_number;
+        unsigned _bitrate = 0;      /*!< @brief Taxa de bits em kb/s; 0 se desconhecida */
+        unsigned _sample_rate = 0;  /*!< @brief Taxa de amostragem em Hz; 0 se desconhecida */
+        uint64_t _file_size = 0;    /*!< @brief Tamanho do arquivo em bytes; 0 se desconhecido */
 
         bool _artistLoaded = false;
         bool _albumLoaded = false;
@@ -217,6 +221,21 @@ namespace core {
          * @return Ano de lançamento
          */
         int getYear() const;
+        /**
+         * @brief Obtém a taxa de bits do arquivo de áudio
+         * @return Taxa de bits em kb/s, ou 0 se desconhecida
+         */
+        unsigned getBitrate() const;
+        /**
+         * @brief Obtém a taxa de amostragem do arquivo de áudio
+         * @return Taxa de amostragem em Hz, ou 0 se desconhecida
+         */
+        unsigned getSampleRate() const;
+        /**
+         * @brief Obtém o tamanho do arquivo de áudio
+         * @return Tamanho em bytes, ou 0 se desconhecido
+         */
+        uint64_t getFileSize() const;
         /**
          * @brief Obtém o usuário dono da música
          * @return Usuário dono da música
@@ -228,6 +247,12 @@ namespace core {
          * @param user Novo usuário
          */
         void setUser(const User& user);
+
+        /**
+         * @brief Define o usuário dono da música, compartilhando a instância
+         * @param user Usuário compartilhado
+         */
+        void setUser(std::shared_ptr<const User> user);
         /**
          * @brief Define o título da música
          * @param title Novo título
@@ -292,6 +317,24 @@ namespace core {
          */
         void setDuration(int sec);
 
+        /**
+         * @brief Define a taxa de bits lida do arquivo
+         * @param bitrate Taxa de bits em kb/s
+         */
+        void setBitrate(unsigned bitrate);
+
+        /**
+         * @brief Define a taxa de amostragem lida do arquivo
+         * @param sample_rate Taxa de amostragem em Hz
+         */
+        void setSampleRate(unsigned sample_rate);
+
+        /**
+         * @brief Define o tamanho do arquivo
+         * @param file_size Tamanho em bytes
+         */
+        void setFileSize(uint64_t file_size);
+
         /**
          * @brief Define id de um album para contexto de test
          * @param int id
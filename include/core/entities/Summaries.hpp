@@ -0,0 +1,50 @@
+/**
+ * @file Summaries.hpp
+ * @brief Projeções somente leitura para listagens
+ *
+ * Resumos de músicas, álbuns e artistas com apenas o que as telas de
+ * listagem exibem. São valores simples, sem loaders nem usuário, montados
+ * pelo SummaryRepository a partir de uma única consulta.
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <string>
+
+namespace core {
+
+    /**
+     * @brief Resumo de uma música para listagens
+     */
+    struct SongSummary {
+        unsigned id = 0; /*!< @brief ID da música */
+        std::string title; /*!< @brief Título da música */
+        std::string artist; /*!< @brief Nome do artista principal */
+        std::string album; /*!< @brief Título do álbum, vazio se não houver */
+        unsigned duration = 0; /*!< @brief Duração em segundos */
+    };
+
+    /**
+     * @brief Resumo de um álbum para listagens
+     */
+    struct AlbumSummary {
+        unsigned id = 0; /*!< @brief ID do álbum */
+        std::string title; /*!< @brief Título do álbum */
+        std::string artist; /*!< @brief Nome do artista principal, vazio se não houver */
+        int year = 0; /*!< @brief Ano de lançamento */
+        unsigned songs_count = 0; /*!< @brief Número de músicas do álbum */
+    };
+
+    /**
+     * @brief Resumo de um artista para listagens
+     */
+    struct ArtistSummary {
+        unsigned id = 0; /*!< @brief ID do artista */
+        std::string name; /*!< @brief Nome do artista */
+        unsigned songs_count = 0; /*!< @brief Número de músicas do artista */
+    };
+
+}  // namespace core
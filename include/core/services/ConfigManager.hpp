@@ -12,8 +12,15 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
 
+#include "core/bd/DatabaseManager.hpp"
+#include "core/services/LibraryWatcher.hpp"
+
+#define INGEST_THREADS_DEFAULT 0
+#define INGEST_QUEUE_SIZE_DEFAULT 64
+
 namespace core {
 
     /**
@@ -82,6 +89,91 @@ namespace core {
          */
         std::string databaseSchemaPath() const;
 
+        /**
+         * @brief Obtém quantas músicas, álbuns e artistas o mapa de identidade
+         *        mantém em memória por tipo de entidade
+         *
+         * O limite é uma contagem de entidades, não de bytes (chave
+         * `identity_map_entries`; `identity_map_size` é aceita como nome antigo).
+         *
+         * @return Número máximo de entidades; 0 desativa o cache
+         */
+        size_t databaseIdentityMapEntries() const;
+
+        /**
+         * @brief Obtém os parâmetros de ajuste das conexões com o banco
+         *
+         * Lê as chaves `wal`, `synchronous`, `cache_size`, `mmap_size`,
+         * `busy_timeout_ms`, `reader_pool_size`, `profile`, `slow_query_ms`,
+         * `slow_query_log`, `memory_mirror` e `mirror_flush_ms` da seção
+         * `database`.
+         *
+         * `memory_mirror` só deve ser habilitada quando o aplicativo for o
+         * único a usar o arquivo do banco: cada gravação da cópia substitui
+         * o arquivo inteiro, e a cópia deixa de ser gravada se outro
+         * processo alterar o arquivo.
+         *
+         * @return Parâmetros das conexões, com os valores padrão para as
+         *         chaves ausentes
+         */
+        DatabaseSettings databaseSettings() const;
+
+        /**
+         * @brief Obtém quantas threads leem os metadados na importação
+         *
+         * Chave `threads` da seção `ingest`.
+         *
+         * @return Número de threads; 0 usa o número de núcleos e 1 importa
+         *         na thread de quem chama
+         */
+        size_t ingestThreads() const;
+
+        /**
+         * @brief Obtém quantos arquivos lidos podem aguardar a gravação
+         *
+         * Chave `queue_size` da seção `ingest`.
+         *
+         * @return Capacidade da fila entre as threads de leitura e a de gravação
+         */
+        size_t ingestQueueSize() const;
+
+        /**
+         * @brief Obtém as extensões dos arquivos lidos na importação
+         *
+         * Chave `extensions` da seção `ingest`. Arquivos com outras extensões
+         * são ignorados pela varredura sem serem abertos.
+         *
+         * @return Extensões sem o ponto; vazia aceita qualquer arquivo
+         */
+        std::vector<std::string> ingestExtensions() const;
+
+        /**
+         * @brief Indica se os diretórios de entrada são observados ao iniciar
+         *
+         * Chave `enabled` da seção `watch`.
+         *
+         * @return true para importar automaticamente os arquivos que chegarem
+         */
+        bool watchEnabled() const;
+
+        /**
+         * @brief Obtém o tempo sem eventos que fecha um lote do observador
+         *
+         * Chave `debounce_ms` da seção `watch`.
+         *
+         * @return Intervalo em milissegundos
+         */
+        size_t watchDebounceMs() const;
+
+        /**
+         * @brief Obtém o número de arquivos que fecha um lote do observador
+         *
+         * Chave `max_batch` da seção `watch`.
+         *
+         * @return Número máximo de arquivos por lote
+         */
+        size_t watchMaxBatch() const;
+
         /**
          * @brief Obtém o diretório de músicas de usuário a partir das configuracoes
          * @return Diretório de músicas de usuário
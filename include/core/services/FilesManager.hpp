@@ -15,12 +15,17 @@
 #include "core/bd/SongRepository.hpp"
 #include "core/bd/ArtistRepository.hpp"
 #include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ScannedFileRepository.hpp"
 #include "core/services/ConfigManager.hpp"
 #include "core/services/UsersManager.hpp"
+#include "core/util/FileFingerprint.hpp"
 
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #ifdef _WIN32
     #include <taglib/tag.h>
@@ -30,6 +35,7 @@
     #include <taglib/fileref.h>
 #endif
 #include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -42,8 +48,33 @@ namespace core {
         std::shared_ptr<ArtistRepository> _artistRepo;
         std::shared_ptr<AlbumRepository> _albumRepo;
         std::shared_ptr<UserRepository> _userRepo;
+        std::shared_ptr<ScannedFileRepository> _scannedRepo;
+        std::shared_ptr<SQLite::Database> _db; /*!< @brief Conexão compartilhada pelos repositórios */
         core::UsersManager _usersManager;
+        mutable std::mutex _mutex; /*!< @brief Serializa as varreduras e importações */
 
+        /**
+         * @brief Metadados lidos de um arquivo, ainda sem acesso ao banco
+         *
+         * Produzido pelas threads de leitura e consumido pela de gravação.
+         */
+        struct TrackMetadata {
+            std::string sourceFilePath;
+            std::string title;
+            std::string genre;
+            int year = 1900;
+            unsigned track = 1;
+            unsigned duration = 0;
+            unsigned bitrate = 0;     /*!< @brief kb/s */
+            unsigned sampleRate = 0;  /*!< @brief Hz */
+            uint64_t fileSize = 0;    /*!< @brief Bytes */
+            std::vector<std::string> artistNames; /*!< @brief O primeiro é o principal */
+            std::string albumTitle;
+            std::string error; /*!< @brief Motivo da falha na leitura, se houver */
+            bool audio = true; /*!< @brief false se o arquivo não é um áudio suportado */
+            FileFingerprint fingerprint; /*!< @brief Impressão do arquivo; path vazio se não lida */
+            bool refreshOnly = false; /*!< @brief Conteúdo igual ao já visto: só a impressão é gravada */
+        };
 
         /**
          * @brief Move um arquivo de um diretório para o outro
@@ -57,13 +88,107 @@ namespace core {
         /**
          * @brief Lê os metadados do arquivo
          *
-         * Lê todos os metadados do arquivo e trata todas as informações segundo as regras
-         * de negócio (nomeação de diretórios com base em nome de artistas)
+         * Abre o arquivo uma única vez, lendo as tags e as propriedades do
+         * áudio no modo rápido do TagLib (duração estimada pelo cabeçalho,
+         * sem percorrer os quadros), e separa a lista de artistas. Não
+         * acessa o banco, por isso pode ser chamado por várias threads ao
+         * mesmo tempo.
+         *
+         * @param filePath Caminho do arquivo de áudio
+         * @return Metadados do arquivo, ou std::nullopt se não for um áudio
+         * @throws std::invalid_argument se o arquivo não tiver tags
+         */
+        std::optional<TrackMetadata> readMetadata(const std::string& filePath);
+
+        /**
+         * @brief Importa um arquivo a partir dos metadados lidos
+         *
+         * Trata todas as informações segundo as regras de negócio (nomeação
+         * de diretórios com base em nome de artistas), resolve artistas e
+         * álbum e move o arquivo para a biblioteca do usuário.
+         *
+         * Artistas, álbum e música são gravados em uma única UnitOfWork,
+         * confirmada depois que o arquivo é movido: uma falha no meio não
+         * deixa a música importada pela metade. Dentro de uma UnitOfWork de
+         * quem chama, o arquivo passa a fazer parte dela.
          *
          * @return Retorna uma instância do objeto com os dados de título, artista e path tratados
          *
          */
-        std::shared_ptr<Song> readMetadata(TagLib::FileRef file, User &user,const std::string& sourceFilePath);
+        std::shared_ptr<Song> importTrack(const TrackMetadata& metadata, User &user);
+
+        /**
+         * @brief Obtém o número de threads de leitura da importação
+         * @return ConfigManager::ingestThreads(), com 0 trocado pelo número de núcleos
+         */
+        size_t ingestThreadCount() const;
+
+        /**
+         * @brief Lê as tags e a impressão de um arquivo de entrada
+         *
+         * Erros de leitura ficam em TrackMetadata::error. Não acessa o banco.
+         *
+         * @param filePath Caminho do arquivo
+         * @return Metadados do arquivo
+         */
+        TrackMetadata readTrack(const std::string& filePath);
+
+        /**
+         * @brief Importa um arquivo lido ou registra a sua rejeição
+         * @param metadata Resultado de readTrack()
+         * @param user Dono do arquivo
+         */
+        void importRead(const TrackMetadata& metadata, User& user);
+
+        /**
+         * @brief Importa uma lista de arquivos de entrada de um usuário
+         *
+         * Com mais de uma thread configurada (ConfigManager::ingestThreads),
+         * as leituras das tags são feitas em paralelo e os resultados passam
+         * por uma fila limitada para a thread de quem chama, a única que
+         * grava no banco e move arquivos.
+         *
+         * @param files Caminhos dos arquivos de entrada
+         * @param user Dono dos arquivos
+         */
+        void ingest(const std::vector<std::string>& files, User& user);
+
+        /**
+         * @brief Varre o diretório de entrada de um usuário e importa o que mudou
+         *
+         * O diretório é percorrido recursivamente pelo DirectoryScanner:
+         * cada arquivo com extensão aceita é comparado com a impressão da
+         * varredura anterior (tamanho, data e inode; com o mesmo tamanho, o
+         * hash do início) e, se for novo ou modificado, entregue às threads
+         * de leitura das tags assim que encontrado, como em ingest(). A thread
+         * de quem chama grava no banco e move os arquivos enquanto a
+         * varredura continua. Impressões de arquivos que saíram do diretório
+         * são apagadas no final.
+         *
+         * @param inputDir Diretório de entrada do usuário
+         * @param user Dono do diretório
+         */
+        void ingestDirectory(const std::string& inputDir, User& user);
+
+        /**
+         * @brief Compara um arquivo com a impressão gravada e conta o resultado
+         *
+         * Com o mesmo tamanho e data ou inode diferentes, calcula o hash do
+         * início; se o conteúdo não mudou, grava a nova impressão e o arquivo
+         * conta como inalterado.
+         *
+         * @param current Impressão atual, sem o hash
+         * @param stored Impressão da varredura anterior, ou nullptr se nunca visto
+         * @param user Dono do arquivo
+         * @return true se o arquivo é novo ou foi modificado
+         */
+        bool hasChanged(FileFingerprint& current, const FileFingerprint* stored, User& user);
+
+        /**
+         * @brief Lista os usuários cujos diretórios de entrada são importados
+         * @return Usuários do banco, ou o atual e o público se não houver nenhum
+         */
+        std::vector<std::shared_ptr<User>> scanUsers();
 
         /**
          * @brief Verifica ou cria o diretório antes de salvar uma música
@@ -78,6 +203,20 @@ namespace core {
          */
         std::string cleanString(const std::string& str);
 
+    public:
+        /**
+         * @brief Contagem da última varredura dos diretórios de entrada
+         */
+        struct ScanReport {
+            size_t added = 0;     /*!< @brief Arquivos nunca vistos */
+            size_t modified = 0;  /*!< @brief Arquivos que mudaram desde a última varredura */
+            size_t unchanged = 0; /*!< @brief Arquivos pulados sem leitura das tags */
+            size_t removed = 0;   /*!< @brief Arquivos que saíram do diretório */
+        };
+
+    private:
+        ScanReport _lastScan;
+
     public:
 
         /**
@@ -99,14 +238,49 @@ namespace core {
         /***
          * @brief Atualiza toda a organização das músicas com base no diretório temporário
          *
-         * Responsável pela lógica de organizar as músicas do diretório temporário
+         * Responsável pela lógica de organizar as músicas do diretório temporário,
+         * incluindo os subdiretórios (álbuns copiados como pastas).
+         * Só lê os arquivos novos ou modificados desde a varredura anterior;
+         * arquivos rejeitados continuam no diretório, mas não são lidos de
+         * novo enquanto não mudarem.
          *
          */
         void update();
 
+        /**
+         * @brief Importa arquivos que chegaram aos diretórios de entrada
+         *
+         * Usado pelo modo de observação: cada caminho é atribuído ao usuário
+         * dono do diretório de entrada e só é lido se for novo ou tiver
+         * mudado. Caminhos fora dos diretórios de entrada são ignorados. Pode
+         * ser chamado de outra thread; as importações são serializadas com
+         * update().
+         *
+         * @param files Caminhos dos arquivos recebidos
+         * @return Número de arquivos lidos
+         */
+        size_t importFiles(const std::vector<std::string>& files);
+
+        /**
+         * @brief Obtém os diretórios de entrada de todos os usuários
+         *
+         * Os diretórios que não existem são criados.
+         *
+         * @return Diretórios de entrada, na ordem dos usuários
+         */
+        std::vector<std::string> inputDirectories();
+
+        /**
+         * @brief Obtém a contagem da última chamada de update() ou importFiles()
+         * @return Arquivos novos, modificados, inalterados e removidos
+         */
+        ScanReport getLastScan() const;
+
         /**
          * @brief Verifica se há arquivos a serem carregados no diretório temporário
          *
+         * Arquivos com a mesma impressão da última varredura não contam.
+         *
          * @return true se não houver nenhuma atualização a ser feita e false caso exista alguma música no diretório temporário
          */
         bool isUpdated();
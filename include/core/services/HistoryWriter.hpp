@@ -0,0 +1,139 @@
+/**
+ * @file HistoryWriter.hpp
+ * @brief Gravação assíncrona do histórico de reprodução
+ *
+ * Servico que acumula as reproduções em memória e as grava no banco em lotes,
+ * fora da thread de controle da reprodução.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-22
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/entities/HistoryPlayback.hpp"
+
+#define HISTORY_BUFFER_SIZE_DEFAULT 256
+#define HISTORY_FLUSH_BATCH_DEFAULT 32
+#define HISTORY_FLUSH_INTERVAL_MS_DEFAULT 2000
+
+namespace core {
+
+    /**
+     * @brief Gravador do histórico de reprodução com escrita em segundo plano
+     *
+     * @details
+     * As reproduções são colocadas em um buffer circular e gravadas por uma
+     * thread própria, em uma única transação por lote, quando o lote atinge
+     * `batch_size` registros ou quando `interval` expira. Se o buffer encher
+     * antes da gravação, record() espera a thread esvaziá-lo; nenhum registro
+     * é descartado. Ao ser destruído o gravador grava tudo o que ainda
+     * estiver pendente.
+     *
+     * O repositório deve usar uma conexão só do gravador, obtida por
+     * DatabaseManager::openConnection(), para que os lotes não entrem nas
+     * transações abertas por outras threads. A aplicação mantém um único
+     * gravador, compartilhado pelas filas de reprodução.
+     */
+    class HistoryWriter {
+    private:
+        std::shared_ptr<HistoryPlaybackRepository> _history_repo; /*!< @brief Repositório de destino */
+        std::vector<HistoryPlayback> _ring; /*!< @brief Buffer circular de registros pendentes */
+        size_t _head;       /*!< @brief Posição do registro mais antigo */
+        size_t _count;      /*!< @brief Registros pendentes no buffer */
+        size_t _batch_size; /*!< @brief Registros que disparam uma gravação */
+        std::chrono::milliseconds _interval; /*!< @brief Intervalo máximo entre gravações */
+        bool _writing;      /*!< @brief Indica se há um lote sendo gravado */
+        bool _flush_requested;
+        bool _stopping;     /*!< @brief Indica que stop() foi chamado */
+        bool _stopped;      /*!< @brief Indica que a thread de gravação terminou */
+        mutable std::mutex _mutex;
+        std::mutex _direct_mutex; /*!< @brief Serializa as gravações feitas após stop() */
+        std::condition_variable _wake;    /*!< @brief Acorda a thread de gravação */
+        std::condition_variable _drained; /*!< @brief Avisa que o buffer foi gravado */
+        std::condition_variable _space;   /*!< @brief Avisa que o buffer foi esvaziado */
+        std::thread _worker;
+
+        /**
+         * @brief Laço da thread de gravação
+         */
+        void run();
+
+        /**
+         * @brief Retira todos os registros pendentes do buffer
+         * @return Registros na ordem em que foram recebidos
+         */
+        std::vector<HistoryPlayback> takePending();
+
+        /**
+         * @brief Grava um lote de registros em uma única transação
+         * @param batch Registros a serem gravados
+         */
+        void writeBatch(std::vector<HistoryPlayback>& batch);
+
+        /**
+         * @brief Grava um lote fora da thread de gravação, um de cada vez
+         * @param batch Registros a serem gravados
+         */
+        void writeDirect(std::vector<HistoryPlayback>& batch);
+
+    public:
+        /**
+         * @brief Construtor do gravador
+         * @param history_repo Repositório onde o histórico será gravado
+         * @param capacity Número máximo de registros pendentes
+         * @param batch_size Número de registros que dispara uma gravação
+         * @param interval Intervalo máximo entre gravações
+         */
+        HistoryWriter(std::shared_ptr<HistoryPlaybackRepository> history_repo,
+                      size_t capacity = HISTORY_BUFFER_SIZE_DEFAULT,
+                      size_t batch_size = HISTORY_FLUSH_BATCH_DEFAULT,
+                      std::chrono::milliseconds interval =
+                          std::chrono::milliseconds(HISTORY_FLUSH_INTERVAL_MS_DEFAULT));
+        ~HistoryWriter();
+
+        HistoryWriter(const HistoryWriter&) = delete;
+        HistoryWriter& operator=(const HistoryWriter&) = delete;
+
+        /**
+         * @brief Registra uma reprodução sem esperar pela gravação
+         *
+         * Só espera se o buffer estiver cheio, até a thread de gravação
+         * retirar os registros pendentes.
+         *
+         * @param entry Registro de reprodução
+         */
+        void record(const HistoryPlayback& entry);
+
+        /**
+         * @brief Grava imediatamente os registros pendentes e aguarda o término
+         */
+        void flush();
+
+        /**
+         * @brief Grava os registros pendentes e encerra a thread de gravação
+         *
+         * Enquanto a thread não termina, os registros recebidos continuam no
+         * buffer e são gravados por ela; depois disso, são gravados de forma
+         * síncrona por record().
+         */
+        void stop();
+
+        /**
+         * @brief Obtém o número de registros ainda não gravados
+         * @return Quantidade de registros pendentes
+         */
+        size_t pending() const;
+    };
+
+}  // namespace core
@@ -23,6 +23,8 @@
 #include "core/bd/AlbumRepository.hpp"
 #include "core/bd/PlaylistRepository.hpp"
 #include "core/bd/RepositoryFactory.hpp"
+#include "core/bd/SummaryRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
 
 namespace core
 {
@@ -34,17 +36,33 @@ namespace core
         std::shared_ptr<core::ArtistRepository> _artistRepo;
         std::shared_ptr<core::AlbumRepository> _albumRepo;
         std::shared_ptr<core::PlaylistRepository> _playlistRepo;
+        std::shared_ptr<core::SummaryRepository> _summaryRepo;
+        std::shared_ptr<SQLite::Database> _writer_db; /*!< @brief Conexão usada por persist(), se separada das consultas */
 
     public:
         [[deprecated]] Library(std::shared_ptr<core::User> user, std::shared_ptr<SQLite::Database> db);
         Library(const User &user, SQLite::Database &db);
         Library(ConfigManager &config);
         Library(ConfigManager &config, SQLite::Database &db);
+
+        /**
+         * @brief Construtor com conexões separadas para leitura e escrita
+         *
+         * As buscas usam uma conexão somente leitura do pool, que não espera
+         * por gravações em andamento; persist() usa a conexão de escrita.
+         *
+         * @param user Usuário dono da biblioteca
+         * @param db_manager Gerenciador que fornece as conexões
+         */
+        Library(std::shared_ptr<core::User> user, DatabaseManager &db_manager);
         ~Library();
 
         /**
          * @brief Obtém o repositório de músicas
          *
+         * Com conexões separadas, o repositório usa a conexão de escrita,
+         * e não a somente leitura das buscas.
+         *
          * @return ponteiro compartilhado para o repositório de músicas
          */
         [[deprecated("Usar RepositoryFactory")]] std::shared_ptr<core::SongRepository> getSongRepository() const;
@@ -52,6 +70,9 @@ namespace core
         /**
          * @brief Obtém o repositório de artistas
          *
+         * Com conexões separadas, o repositório usa a conexão de escrita,
+         * e não a somente leitura das buscas.
+         *
          * @return ponteiro compartilhado para o repositório de artistas
          */
         [[deprecated("Usar RepositoryFactory")]] std::shared_ptr<core::ArtistRepository> getArtistRepository() const;
@@ -59,6 +80,9 @@ namespace core
         /**
          * @brief Obtém o repositório de álbuns
          *
+         * Com conexões separadas, o repositório usa a conexão de escrita,
+         * e não a somente leitura das buscas.
+         *
          * @return ponteiro compartilhado para o repositório de álbuns
          */
         [[deprecated("Usar RepositoryFactory")]] std::shared_ptr<core::AlbumRepository> getAlbumRepository() const;
@@ -66,6 +90,9 @@ namespace core
         /**
          * @brief Obtém o repositório de playlists
          *
+         * Com conexões separadas, o repositório usa a conexão de escrita,
+         * e não a somente leitura das buscas.
+         *
          * @return ponteiro compartilhado para o repositório de playlists
          */
         [[deprecated("Usar RepositoryFactory")]] std::shared_ptr<core::PlaylistRepository> getPlaylistRepository() const;
@@ -91,33 +118,75 @@ namespace core
         [[deprecated("Manipular diretamente na Playlist")]] bool removeFromPlaylist(const core::IPlayable &playlist, const core::IPlayable &playabel);
 
         /**
-         * @brief Procura pelas playlists do usuário.
+         * @brief Procura pelas músicas do usuário.
          * @param query string de busca.
-         *
+         * @return resultados ordenados por relevância (BM25).
          */
         [[nodiscard]] std::vector<std::shared_ptr<core::Song>> searchSong(const std::string &query) const;
 
         /**
          * @brief Procura pelos artistas do usuário.
          * @param query string de busca.
-         *
+         * @return resultados ordenados por relevância (BM25).
          */
         [[nodiscard]] std::vector<std::shared_ptr<core::Artist>> searchArtist(const std::string &query) const;
 
         /**
          * @brief Procura pelos álbuns do usuário.
          * @param query string de busca.
-         *
+         * @return resultados ordenados por relevância (BM25).
          */
         [[nodiscard]] std::vector<std::shared_ptr<core::Album>> searchAlbum(const std::string &query) const;
 
         /**
          * @brief Procura pelas playlists do usuário.
          * @param query string de busca.
-         *
+         * @return resultados ordenados por relevância (BM25).
          */
         [[nodiscard]] std::vector<std::shared_ptr<core::Playlist>> searchPlaylist(const std::string &query) const;
 
+        /**
+         * @brief Percorre as músicas do usuário, uma por vez, em ordem de título.
+         * @param callback função chamada para cada música; retornar false interrompe a leitura.
+         * @return número de músicas entregues ao callback.
+         */
+        size_t forEachSong(const core::SongRepository::RowCallback &callback) const;
+
+        /**
+         * @brief Procura pelas músicas do usuário, devolvendo apenas resumos.
+         * @param query string de busca.
+         * @return resumos ordenados por relevância (BM25).
+         */
+        [[nodiscard]] std::vector<core::SongSummary> searchSongSummaries(const std::string &query) const;
+
+        /**
+         * @brief Procura pelos artistas do usuário, devolvendo apenas resumos.
+         * @param query string de busca.
+         * @return resumos ordenados por relevância (BM25).
+         */
+        [[nodiscard]] std::vector<core::ArtistSummary> searchArtistSummaries(const std::string &query) const;
+
+        /**
+         * @brief Procura pelos álbuns do usuário, devolvendo apenas resumos.
+         * @param query string de busca.
+         * @return resumos ordenados por relevância (BM25).
+         */
+        [[nodiscard]] std::vector<core::AlbumSummary> searchAlbumSummaries(const std::string &query) const;
+
+        /**
+         * @brief Obtém os resumos de uma lista de músicas em uma única consulta.
+         * @param ids IDs das músicas.
+         * @return resumos na mesma ordem dos IDs.
+         */
+        [[nodiscard]] std::vector<core::SongSummary> getSongSummaries(const std::vector<unsigned> &ids) const;
+
+        /**
+         * @brief Obtém os resumos das músicas de uma playlist.
+         * @param playlist_id ID da playlist.
+         * @return resumos na ordem da playlist.
+         */
+        [[nodiscard]] std::vector<core::SongSummary> getPlaylistSongSummaries(unsigned playlist_id) const;
+
         /**
          * @brief Registra uma música no banco de dados.
          * @param song Objeto Song a ser registrado.
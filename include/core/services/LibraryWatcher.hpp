@@ -0,0 +1,146 @@
+/**
+ * @file LibraryWatcher.hpp
+ * @brief Observação dos diretórios de entrada para importação automática
+ *
+ * Servico que recebe do sistema operacional os arquivos que terminaram de
+ * chegar aos diretórios de entrada e os entrega, em lotes, para importação.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-12-04
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define WATCH_DEBOUNCE_MS_DEFAULT 500
+#define WATCH_MAX_BATCH_DEFAULT 256
+
+namespace core {
+
+    /**
+     * @brief Observador dos diretórios de entrada com entrega em lotes
+     *
+     * @details
+     * No Linux usa o inotify, com uma observação por diretório da árvore, e
+     * só reage a `IN_CLOSE_WRITE` (arquivo fechado depois de escrito) e
+     * `IN_MOVED_TO` (arquivo movido para o diretório), de modo que uma cópia
+     * em andamento não é lida pela metade. Um subdiretório criado passa a
+     * ser observado e os arquivos que já tiver entram no lote. Os caminhos
+     * recebidos são acumulados sem repetição e entregues quando nenhum evento
+     * chega por `debounce`, ou assim que o lote atinge `max_batch` caminhos.
+     *
+     * O tratador é chamado na thread do observador, uma vez por lote; os
+     * eventos que chegam enquanto ele executa ficam na fila do kernel. Se a
+     * fila do kernel transbordar, ou se uma pasta for movida para dentro de
+     * um diretório observado, o tratador recebe um lote vazio, indicando que
+     * os diretórios devem ser varridos por inteiro; requestRescan() pede o
+     * mesmo lote de fora. O tratador não deve chamar start() nem stop().
+     *
+     * Nos demais sistemas start() retorna false e nada é observado.
+     */
+    class LibraryWatcher {
+    public:
+        /**
+         * @brief Tratador de um lote de arquivos; vazio pede uma varredura completa
+         */
+        using BatchHandler = std::function<void(const std::vector<std::string>&)>;
+
+    private:
+        BatchHandler _handler;
+        std::chrono::milliseconds _debounce; /*!< @brief Silêncio que fecha um lote */
+        size_t _max_batch;                   /*!< @brief Caminhos que fecham um lote */
+        std::vector<std::string> _directories; /*!< @brief Diretórios observados */
+        int _inotify_fd; /*!< @brief Descritor do inotify; -1 se parado */
+        int _wake_fd;    /*!< @brief Descritor que acorda a thread em stop() e requestRescan() */
+        std::atomic<bool> _stopping;          /*!< @brief Pedido de encerramento da thread */
+        std::atomic<bool> _rescan_requested;  /*!< @brief Pedido de varredura completa */
+        std::mutex _mutex; /*!< @brief Serializa start() e stop() */
+        std::thread _worker;
+
+        /**
+         * @brief Laço da thread do observador
+         * @param directories Diretório de cada descritor de observação
+         */
+        void run(std::unordered_map<int, std::string> directories);
+
+        /**
+         * @brief Encerra a thread e fecha os descritores; exige _mutex
+         */
+        void stopWorker();
+
+    public:
+        /**
+         * @brief Construtor do observador
+         * @param handler Tratador chamado com cada lote de arquivos
+         * @param debounce Tempo sem eventos que fecha um lote
+         * @param max_batch Número de arquivos que fecha um lote
+         */
+        explicit LibraryWatcher(BatchHandler handler,
+                                std::chrono::milliseconds debounce =
+                                    std::chrono::milliseconds(WATCH_DEBOUNCE_MS_DEFAULT),
+                                size_t max_batch = WATCH_MAX_BATCH_DEFAULT);
+        ~LibraryWatcher();
+
+        LibraryWatcher(const LibraryWatcher&) = delete;
+        LibraryWatcher& operator=(const LibraryWatcher&) = delete;
+
+        /**
+         * @brief Indica se o sistema permite observar diretórios
+         * @return true no Linux
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Começa a observar os diretórios
+         *
+         * Diretórios inexistentes são ignorados. Se o observador já estiver
+         * ativo, ele é reiniciado com a nova lista.
+         *
+         * @param directories Diretórios de entrada
+         * @return true se ao menos um diretório passou a ser observado
+         */
+        bool start(const std::vector<std::string>& directories);
+
+        /**
+         * @brief Para de observar e aguarda o término do lote em andamento
+         *
+         * Caminhos recebidos e ainda não entregues são descartados; a próxima
+         * varredura completa os encontra.
+         */
+        void stop();
+
+        /**
+         * @brief Pede uma varredura completa na thread do observador
+         *
+         * O tratador recebe um lote vazio assim que terminar o lote em
+         * andamento, sem esperar `debounce`; os caminhos pendentes são
+         * cobertos pela varredura.
+         *
+         * @return false se o observador não estiver ativo
+         */
+        bool requestRescan();
+
+        /**
+         * @brief Indica se o observador está ativo
+         * @return true entre start() e stop()
+         */
+        bool isRunning() const;
+
+        /**
+         * @brief Obtém os diretórios observados
+         * @return Diretórios passados a start() que existiam
+         */
+        const std::vector<std::string>& getDirectories() const;
+    };
+
+}  // namespace core
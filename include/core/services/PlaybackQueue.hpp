@@ -12,16 +12,19 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <random>
 #include <vector>
 
 #include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/SongRepository.hpp"
 #include "core/entities/Playlist.hpp"
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
 #include "core/interfaces/IPlayable.hpp"
+#include "core/services/HistoryWriter.hpp"
 
 #define MAX_SIZE_DEFAULT 200
 
@@ -42,15 +45,9 @@ namespace core {
         size_t _max_size; /*!< @brief Tamanho máximo da fila */
         bool _aleatory;   /*!< @brief Indica se a reprodução é aleatória */
         bool _loop;      /*!< @brief Indica se a reprodução está em loop */
-        std::shared_ptr<HistoryPlaybackRepository>
-            _history_repo; /*!< @brief Repositório de histórico de reprodução */
         std::shared_ptr<User> _current_user; /*!< @brief Usuário atual */
-
-        /**
-         * @brief Adiciona registro de reprodução ao histórico
-         * @param song Música que foi reproduzida
-         */
-        void addToHistory(const Song& song);
+        std::shared_ptr<HistoryWriter>
+            _history_writer; /*!< @brief Gravador do histórico, compartilhado pela aplicação */
 
         size_t getCurrentIndex() const;
 
@@ -58,10 +55,10 @@ namespace core {
         PlaybackQueue();
         PlaybackQueue(std::shared_ptr<User> current_user,
                       const IPlayable& playable,
-                      std::shared_ptr<HistoryPlaybackRepository> history_repo,
+                      std::shared_ptr<HistoryWriter> history_writer,
                       size_t max_size = MAX_SIZE_DEFAULT);
         PlaybackQueue(std::shared_ptr<User> current_user,
-                      std::shared_ptr<HistoryPlaybackRepository> history_repo,
+                      std::shared_ptr<HistoryWriter> history_writer,
                       size_t max_size = MAX_SIZE_DEFAULT);
 
         ~PlaybackQueue();
@@ -78,6 +75,25 @@ namespace core {
          */
         void add(const PlaybackQueue& other_queue);
 
+        /**
+         * @brief Adiciona músicas lidas de uma consulta, uma por vez
+         *
+         * A leitura é interrompida assim que a fila enche, sem carregar as
+         * linhas restantes.
+         *
+         * @param source Função que percorre as músicas, como
+         *        SongRepository::forEachByAlbum, chamando o callback recebido
+         * @return Número de músicas adicionadas
+         */
+        size_t add(const std::function<size_t(const SongRepository::RowCallback&)>& source);
+
+        /**
+         * @brief Adiciona uma música ao final da fila
+         * @param song Música a ser adicionada
+         * @return true se a música foi adicionada, false se a fila estiver cheia
+         */
+        bool push(const std::shared_ptr<Song>& song);
+
         /**
          * @brief Adiciona uma música, album, artista ou playlist à fila
          * @param song Música a ser adicionada
@@ -90,6 +106,23 @@ namespace core {
          */
         void operator+=(const PlaybackQueue& other_queue);
 
+        /**
+         * @brief Adiciona registro de reprodução ao histórico
+         *
+         * O registro é gravado em segundo plano; a chamada não espera pelo
+         * banco de dados. Não faz nada se a fila não tiver repositório de
+         * histórico ou usuário.
+         *
+         * @param song Música que foi reproduzida
+         * @param play_duration Segundos efetivamente reproduzidos
+         */
+        void addToHistory(const Song& song, unsigned play_duration);
+
+        /**
+         * @brief Grava imediatamente o histórico ainda pendente
+         */
+        void flushHistory();
+
         /**
          * @brief Remove uma música da fila pelo índice
          * @param index Índice da música a ser removida
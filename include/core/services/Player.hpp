@@ -17,6 +17,8 @@
 #include <atomic>
 
 #include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/HistoryWriter.hpp"
 #include "core/services/PlaybackQueue.hpp"
 
 namespace core {
@@ -72,6 +74,11 @@ namespace core {
          */
         void cleanupCurrentSound();
 
+        /**
+         * @brief Registra no histórico a música atual antes de descartá-la
+         */
+        void recordCurrentPlayback();
+
         /**
          * @brief Analisa flag para chamar playNextSong()
          */
@@ -92,6 +99,16 @@ namespace core {
          */
         Player(const core::PlaybackQueue& tracks);
 
+        /**
+         * @brief Construtor da classe Player com histórico de reprodução
+         * Inicializa o player parado e registra as músicas reproduzidas
+         * pelo usuário no histórico.
+         * @param user Usuário que está ouvindo
+         * @param history_writer Gravador do histórico de reprodução da aplicação
+         */
+        Player(std::shared_ptr<User> user,
+               std::shared_ptr<HistoryWriter> history_writer);
+
         /**
          * @brief Destrutor
          * Libera recursos
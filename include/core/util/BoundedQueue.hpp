@@ -0,0 +1,111 @@
+/**
+ * @file BoundedQueue.hpp
+ * @brief Fila com capacidade limitada para passar itens entre threads
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace core {
+
+    /**
+     * @brief Fila produtor/consumidor com capacidade limitada
+     * @tparam T Tipo dos itens
+     *
+     * @details
+     * push() bloqueia enquanto a fila está cheia, o que impede produtores
+     * rápidos de acumularem itens sem limite na memória. Depois de close(),
+     * push() recusa novos itens e pop() devolve os que restam e então
+     * std::nullopt.
+     */
+    template <typename T>
+    class BoundedQueue {
+    private:
+        std::deque<T> _items;
+        size_t _capacity;
+        bool _closed;
+        mutable std::mutex _mutex;
+        std::condition_variable _not_full;
+        std::condition_variable _not_empty;
+
+    public:
+        /**
+         * @brief Cria uma fila vazia
+         * @param capacity Número máximo de itens; 0 é tratado como 1
+         */
+        explicit BoundedQueue(size_t capacity)
+            : _capacity(capacity > 0 ? capacity : 1), _closed(false) {}
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /**
+         * @brief Coloca um item no fim da fila, esperando se estiver cheia
+         * @param item Item a enfileirar
+         * @return false se a fila foi fechada e o item descartado
+         */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _not_full.wait(lock, [this]() {
+                return _closed || _items.size() < _capacity;
+            });
+            if (_closed)
+                return false;
+
+            _items.push_back(std::move(item));
+            lock.unlock();
+            _not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Retira o item do início da fila, esperando se estiver vazia
+         * @return Item retirado, ou std::nullopt se a fila foi fechada e esvaziada
+         */
+        std::optional<T> pop() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _not_empty.wait(lock, [this]() {
+                return _closed || !_items.empty();
+            });
+            if (_items.empty())
+                return std::nullopt;
+
+            T item = std::move(_items.front());
+            _items.pop_front();
+            lock.unlock();
+            _not_full.notify_one();
+            return item;
+        }
+
+        /**
+         * @brief Fecha a fila e acorda quem estiver esperando
+         */
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+            }
+            _not_full.notify_all();
+            _not_empty.notify_all();
+        }
+
+        /**
+         * @brief Obtém o número de itens na fila
+         * @return Itens aguardando pop()
+         */
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _items.size();
+        }
+    };
+
+}  // namespace core
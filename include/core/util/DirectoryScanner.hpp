@@ -0,0 +1,78 @@
+/**
+ * @file DirectoryScanner.hpp
+ * @brief Varredura recursiva e paralela de diretórios
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-05
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Percorre uma árvore de diretórios entregando os arquivos encontrados
+     *
+     * @details
+     * Os diretórios a listar ficam em uma pilha compartilhada: cada thread
+     * retira um diretório, lista suas entradas e empilha os subdiretórios,
+     * de modo que subárvores diferentes são percorridas ao mesmo tempo. No
+     * POSIX o tipo de cada entrada vem do `d_type` do readdir(), sem um
+     * stat() por entrada; só links simbólicos e sistemas de arquivos que não
+     * informam o tipo pagam o stat(). Links para diretórios não são
+     * seguidos, o que evita ciclos.
+     *
+     * Arquivos cuja extensão não está na lista de permitidas são ignorados
+     * sem stat(). Os demais são entregues ao tratador assim que encontrados,
+     * nas threads da varredura.
+     */
+    class DirectoryScanner {
+    public:
+        /**
+         * @brief Tratador de um arquivo; chamado por várias threads ao mesmo tempo
+         *
+         * Retornar false interrompe a varredura.
+         */
+        using FileHandler = std::function<bool(const std::string&)>;
+
+    private:
+        std::vector<std::string> _extensions; /*!< @brief Em minúsculas e sem o ponto */
+        size_t _threads;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param extensions Extensões aceitas, com ou sem ponto; vazia aceita todas
+         * @param threads Threads da varredura; 0 usa o número de núcleos
+         */
+        explicit DirectoryScanner(const std::vector<std::string>& extensions = {},
+                                  size_t threads = 1);
+
+        /**
+         * @brief Verifica se o nome de um arquivo tem uma extensão aceita
+         * @param filename Nome ou caminho do arquivo
+         * @return true se a extensão está na lista, ou se a lista é vazia
+         */
+        bool accepts(const std::string& filename) const;
+
+        /**
+         * @brief Percorre um diretório e seus subdiretórios
+         *
+         * Retorna quando todos os diretórios foram listados e os tratadores
+         * terminaram. Com uma thread, tudo acontece na thread de quem chama.
+         * Diretórios que não podem ser abertos são ignorados.
+         *
+         * @param root Diretório raiz
+         * @param handler Tratador de cada arquivo aceito
+         * @return Número de arquivos entregues ao tratador
+         */
+        size_t scan(const std::string& root, const FileHandler& handler) const;
+    };
+
+}  // namespace core
@@ -0,0 +1,60 @@
+/**
+ * @file FileFingerprint.hpp
+ * @brief Identificação barata de um arquivo para detectar mudanças
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#define FINGERPRINT_HASH_PREFIX_BYTES 65536
+
+namespace core {
+
+    /**
+     * @brief Tamanho, data de modificação, inode e hash do início de um arquivo
+     *
+     * @details
+     * Os três primeiros campos vêm de um único stat(). Quando batem com os
+     * gravados, o arquivo é considerado o mesmo sem ser aberto. O hash dos
+     * primeiros FINGERPRINT_HASH_PREFIX_BYTES bytes desempata os casos em
+     * que só a data ou o inode mudaram (cópia, `touch`, restauração de
+     * backup) e o conteúdo não.
+     */
+    struct FileFingerprint {
+        std::string path;
+        uint64_t size = 0;
+        int64_t mtime = 0;       /*!< @brief Nanossegundos desde a época */
+        uint64_t inode = 0;      /*!< @brief 0 onde o sistema não informa */
+        uint64_t hash_prefix = 0;
+        bool failed = false;     /*!< @brief A importação falhou com erro; tocar o arquivo faz com que seja lido de novo */
+
+        /**
+         * @brief Lê tamanho, data e inode de um arquivo
+         * @param path Caminho do arquivo
+         * @return Impressão sem o hash, ou std::nullopt se o arquivo não existir
+         */
+        static std::optional<FileFingerprint> stat(const std::string& path);
+
+        /**
+         * @brief Calcula o hash FNV-1a do início do arquivo
+         * @param path Caminho do arquivo
+         * @return Hash dos primeiros FINGERPRINT_HASH_PREFIX_BYTES bytes
+         */
+        static uint64_t hashPrefix(const std::string& path);
+
+        /**
+         * @brief Compara os campos obtidos pelo stat()
+         * @param other Impressão a comparar
+         * @return true se tamanho, data e inode são iguais
+         */
+        bool sameStat(const FileFingerprint& other) const;
+    };
+
+}  // namespace core
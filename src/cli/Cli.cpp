@@ -12,9 +12,103 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include "core/bd/DataLoader.hpp"
 #include "core/bd/DatabaseManager.hpp"
+#include "core/bd/QueryProfiler.hpp"
 
 namespace cli {
+    namespace {
+        const char* const PROMPT = "frankenstein> ";
+
+        /**
+         * @brief Estado do console compartilhado com as threads em segundo plano
+         *
+         * Mensagens que chegam enquanto o prompt espera uma linha são
+         * mostradas na hora, seguidas do prompt; as que chegam durante um
+         * comando esperam o fim dele.
+         */
+        struct Console {
+            std::mutex mutex;
+            bool at_prompt = false;
+            std::string pending;
+        };
+
+        Console& console() {
+            static Console instance;
+            return instance;
+        }
+
+        /**
+         * @brief Mostra uma mensagem vinda de outra thread
+         * @param text Texto terminado em quebra de linha
+         */
+        void printFromBackground(const std::string& text) {
+            Console& out = console();
+            std::lock_guard<std::mutex> lock(out.mutex);
+
+            if (!out.at_prompt) {
+                out.pending += text;
+                return;
+            }
+
+            std::cout << "\n" << text << PROMPT << std::flush;
+        }
+
+        /**
+         * @brief Mostra as mensagens pendentes e o prompt
+         */
+        void showPrompt() {
+            Console& out = console();
+            std::lock_guard<std::mutex> lock(out.mutex);
+
+            std::cout << out.pending << PROMPT << std::flush;
+            out.pending.clear();
+            out.at_prompt = true;
+        }
+
+        /**
+         * @brief Marca que a linha digitada começou a ser executada
+         */
+        void leavePrompt() {
+            Console& out = console();
+            std::lock_guard<std::mutex> lock(out.mutex);
+            out.at_prompt = false;
+        }
+
+        /**
+         * @brief Busca o nome do artista de várias músicas em lote
+         *
+         * As músicas são lidas no escopo de um DataLoader, então os
+         * getArtist() delas são resolvidos com uma só consulta de artistas.
+         *
+         * @param factory Fábrica da conexão do executor
+         * @param song_ids IDs das músicas; repetidos são ignorados
+         * @return Nome do artista de cada música encontrada, pelo ID da música
+         */
+        std::unordered_map<unsigned, std::string>
+        songArtistNames(core::RepositoryFactory& factory,
+                        const std::vector<unsigned>& song_ids) {
+            auto loader = factory.createDataLoader();
+            core::DataLoader::Scope scope(*loader);
+
+            // Músicas já no mapa de identidade não passam por
+            // mapRowToEntity e precisam ser registradas no loader
+            auto songs = factory.createSongRepository()->findByIds(song_ids);
+            loader->prime(songs);
+
+            std::unordered_map<unsigned, std::string> names;
+            for (const auto& song : songs) {
+                if (auto artist = song->getArtist())
+                    names[song->getId()] = artist->getName();
+            }
+            return names;
+        }
+    }  // namespace
+
     std::string trimSpaces(const std::string& str) {
         size_t firstNonSpace = str.find_first_not_of(" \t\n\r\f\v");
 
@@ -41,7 +135,8 @@ namespace cli {
             // SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
             _db_manager =
                 core::DatabaseManager(config_manager.databasePath(),
-                                      config_manager.databaseSchemaPath());
+                                      config_manager.databaseSchemaPath(),
+                                      config_manager.databaseSettings());
         } catch (const std::exception& e) {
             std::cerr << "Erro ao conectar ao banco de dados: " << e.what()
                       << std::endl;
@@ -72,10 +167,40 @@ namespace cli {
         // std::string input_path;
         // std::string uid;
 
-        _player = std::make_shared<core::Player>();
-
         _db = _db_manager.getDatabase();
-        _library = std::make_shared<core::Library>(_user, _db);
+        // Conexão própria: as consultas do executor não entram nas
+        // transações abertas pela thread do prompt
+        _db_executor = std::make_shared<core::DatabaseExecutor>(
+            _db_manager.openConnection());
+        _history_writer = std::make_shared<core::HistoryWriter>(
+            std::make_shared<core::HistoryPlaybackRepository>(
+                _db_manager.openConnection()));
+        _player = std::make_shared<core::Player>(_user, _history_writer);
+
+        _library = std::make_shared<core::Library>(_user, _db_manager);
+
+        // Lotes do observador são importados na thread dele, sem travar o prompt
+        std::weak_ptr<core::FilesManager> manager = _manager;
+        _watcher = std::make_unique<core::LibraryWatcher>(
+            [manager](const std::vector<std::string>& files) {
+                auto files_manager = manager.lock();
+                if (!files_manager)
+                    return;
+
+                if (files.empty()) {
+                    files_manager->update();
+                    return;
+                }
+
+                if (size_t read = files_manager->importFiles(files))
+                    printFromBackground(std::to_string(read)
+                                        + " arquivo(s) importado(s) automaticamente.\n");
+            },
+            std::chrono::milliseconds(config_manager.watchDebounceMs()),
+            config_manager.watchMaxBatch());
+
+        if (config_manager.watchEnabled())
+            watch("on");
 
         try {
             std::ifstream helpFile("../resources/help.json");
@@ -202,18 +327,71 @@ namespace cli {
         }
     }
 
+    void Cli::addLibraryToQueue() {
+        try {
+            auto queue = _player->getPlaybackQueue();
+            size_t added = queue->add(
+                [this](const core::SongRepository::RowCallback& callback) {
+                    return _library->forEachSong(callback);
+                });
+            std::cout << added << " músicas adicionadas à fila de reprodução."
+                      << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao adicionar à fila de reprodução: " << e.what()
+                      << std::endl;
+        }
+    }
+
+    void Cli::listSongs() const {
+        size_t total = _library->forEachSong(
+            [](const std::shared_ptr<core::Song>& song) {
+                std::cout << "- " << song->getTitle() << "\n";
+                return true;
+            });
+        std::cout << total << " músicas na biblioteca." << std::endl;
+    }
+
+    void Cli::showDatabaseStats() const {
+        if (!_db_manager.getSettings().profile) {
+            std::cout << "Medição de consultas desativada. Habilite "
+                         "\"profile\" na seção \"database\" da configuração."
+                      << std::endl;
+            return;
+        }
+
+        auto& profiler = core::QueryProfiler::instance();
+        profiler.capturePending(*_db);
+        std::cout << profiler.report();
+    }
+
     void Cli::showQueue() const {
         auto queue = _player->getPlaybackQueue();
-        // std::cout << "Fila de reprodução: \n"
-        //           << queue->toString();
-        std::cout << "Fila de reprodução detalhada: \n";
+        // Só títulos e IDs passam para a thread do executor, que relê as
+        // músicas com os artistas em lote
+        std::vector<std::pair<std::string, unsigned>> songs;
+        songs.reserve(queue->size());
         for (size_t i = 0; i < queue->size(); ++i) {
             auto song = queue->at(i);
-            if (song) {
-                std::cout << i + 1 << ". " << song->getTitle() << " - "
-                          << song->getArtist()->getName() << "\n";
-            }
+            if (song)
+                songs.emplace_back(song->getTitle(), song->getId());
         }
+
+        _db_executor->post(
+            [songs](core::RepositoryFactory& factory) {
+                std::vector<unsigned> ids;
+                ids.reserve(songs.size());
+                for (const auto& song : songs)
+                    ids.push_back(song.second);
+                auto names = songArtistNames(factory, ids);
+
+                std::ostringstream out;
+                out << "Fila de reprodução detalhada: \n";
+                for (size_t i = 0; i < songs.size(); ++i)
+                    out << i + 1 << ". " << songs[i].first << " - "
+                        << names[songs[i].second] << "\n";
+                return out.str();
+            },
+            [](const std::string& text) { printFromBackground(text); });
     }
 
     void Cli::like() {
@@ -256,7 +434,8 @@ namespace cli {
 
     void Cli::showStatus() const {
         try {
-            std::cout << "=== Player Status ===" << std::endl;
+            std::ostringstream head;
+            head << "=== Player Status ===\n";
 
             std::string state;
             if (_player->isPlaying())
@@ -266,93 +445,103 @@ namespace cli {
             else
                 state = "Stopped";
 
-            std::cout << "Estado: " << state << std::endl;
+            head << "Estado: " << state << "\n";
 
             float vol = _player->getVolume() * 100.0f;
-            std::cout << "Volume: " << static_cast<unsigned int>(vol) << "%";
+            head << "Volume: " << static_cast<unsigned int>(vol) << "%";
             if (_player->isMuted())
-                std::cout << " (muted)";
-            std::cout << std::endl;
+                head << " (muted)";
+            head << "\n";
 
-            std::cout << "Loop: " << (_player->isLooping() ? "on" : "off")
-                      << std::endl;
+            head << "Loop: " << (_player->isLooping() ? "on" : "off") << "\n";
 
             std::shared_ptr<core::PlaybackQueue> queue;
 
             queue = _player->getPlaybackQueue();
 
-            if (queue) {
-                std::cout << "Tamanho da fila: " << queue->size() << std::endl;
-
-                auto curr = queue->getCurrentSong();
-                if (curr) {
-                    std::cout << "Musica atual: " << curr->getTitle();
-                    if (curr->getArtist())
-                        std::cout << " - " << curr->getArtist()->getName();
-                    std::cout << std::endl;
-
-                    unsigned int elapsed = 0;
-                    float progress = 0.0f;
-
-                    elapsed = _player->getElapsedTime();
-
-                    progress = _player->getProgress();
-
-                    if (progress > 0.0f && elapsed > 0) {
-                        // unsigned int total = static_cast<unsigned
-                        // int>(elapsed / progress); unsigned int m = elapsed /
-                        // 60; unsigned int sec = elapsed % 60; char
-                        // bufElapsed[32]; std::snprintf(bufElapsed,
-                        // sizeof(bufElapsed), "%02u:%02u", m, sec); m = total /
-                        // 60; sec = total % 60; char bufTotal[32];
-                        // std::snprintf(bufTotal, sizeof(bufTotal),
-                        // "%02u:%02u", m, sec);
-
-                        int totalSeconds = elapsed;
-                        int h = totalSeconds / 3600;
-                        int m = (totalSeconds % 3600) / 60;
-                        int s = totalSeconds % 60;
-
-                        std::string formatted;
-                        if (h > 0) {
-                            formatted =
-                                std::to_string(h) + ":" + (m < 10 ? "0" : "")
-                                + std::to_string(m) + ":" + (s < 10 ? "0" : "")
-                                + std::to_string(s);
-                        } else {
-                            formatted = std::to_string(m) + ":"
-                                        + (s < 10 ? "0" : "")
-                                        + std::to_string(s);
-                        }
+            if (!queue) {
+                std::cout << head.str() << "Fila: N/D\n"
+                          << "======================" << std::endl;
+                return;
+            }
+
+            head << "Tamanho da fila: " << queue->size() << "\n";
+
+            auto curr = queue->getCurrentSong();
+            auto next = queue->getNextSong();
+
+            std::ostringstream progress;
+            if (curr) {
+                unsigned int elapsed = 0;
+                float progress_ratio = 0.0f;
+
+                elapsed = _player->getElapsedTime();
+
+                progress_ratio = _player->getProgress();
 
-                        auto totalDuration = _player->getPlaybackQueue()
-                                                 ->getCurrentSong()
-                                                 ->getFormattedDuration();
+                if (progress_ratio > 0.0f && elapsed > 0) {
+                    int totalSeconds = elapsed;
+                    int h = totalSeconds / 3600;
+                    int m = (totalSeconds % 3600) / 60;
+                    int s = totalSeconds % 60;
 
-                        std::cout << "Progresso: " << formatted << " / "
-                                  << totalDuration << std::endl;
+                    std::string formatted;
+                    if (h > 0) {
+                        formatted =
+                            std::to_string(h) + ":" + (m < 10 ? "0" : "")
+                            + std::to_string(m) + ":" + (s < 10 ? "0" : "")
+                            + std::to_string(s);
                     } else {
-                        std::cout << "Progresso: 0:0/0:0" << std::endl;
+                        formatted = std::to_string(m) + ":"
+                                    + (s < 10 ? "0" : "")
+                                    + std::to_string(s);
                     }
-                } else {
-                    std::cout << "Nenhuma musica carregada atualmente."
-                              << std::endl;
-                }
 
-                auto next = queue->getNextSong();
-                if (next) {
-                    std::cout << "Proxima musica: " << next->getTitle();
-                    if (next->getArtist())
-                        std::cout << " - " << next->getArtist()->getName();
-                    std::cout << std::endl;
+                    progress << "Progresso: " << formatted << " / "
+                             << curr->getFormattedDuration() << "\n";
                 } else {
-                    std::cout << "Proxima musica: (nenhuma)" << std::endl;
+                    progress << "Progresso: 0:0/0:0\n";
                 }
-            } else {
-                std::cout << "Fila: N/D" << std::endl;
             }
 
-            std::cout << "======================" << std::endl;
+            // A música atual e a próxima são lidas na thread do executor, com
+            // os artistas em um só lote; o status aparece entre os comandos
+            bool has_curr = curr != nullptr;
+            bool has_next = next != nullptr;
+            std::string curr_title = has_curr ? curr->getTitle() : "";
+            std::string next_title = has_next ? next->getTitle() : "";
+            unsigned curr_id = has_curr ? curr->getId() : 0;
+            unsigned next_id = has_next ? next->getId() : 0;
+            std::string head_text = head.str();
+            std::string progress_text = progress.str();
+
+            _db_executor->post(
+                [=](core::RepositoryFactory& factory) {
+                    auto names = songArtistNames(factory, {curr_id, next_id});
+                    auto withArtist = [&names](const std::string& title, unsigned id) {
+                        auto found = names.find(id);
+                        return found == names.end() ? title
+                                                    : title + " - " + found->second;
+                    };
+
+                    std::ostringstream out;
+                    out << head_text;
+                    if (has_curr)
+                        out << "Musica atual: " << withArtist(curr_title, curr_id)
+                            << "\n" << progress_text;
+                    else
+                        out << "Nenhuma musica carregada atualmente.\n";
+
+                    if (has_next)
+                        out << "Proxima musica: " << withArtist(next_title, next_id)
+                            << "\n";
+                    else
+                        out << "Proxima musica: (nenhuma)\n";
+
+                    out << "======================\n";
+                    return out.str();
+                },
+                [](const std::string& text) { printFromBackground(text); });
         } catch (const std::exception& e) {
             std::cerr << "Erro ao obter status do player: " << e.what()
                       << std::endl;
@@ -380,6 +569,52 @@ namespace cli {
         }
     }
 
+    void Cli::watch(const std::string& mode) {
+        if (mode.empty()) {
+            if (_watcher->isRunning()) {
+                std::cout << "Observando:" << std::endl;
+                for (const auto& directory : _watcher->getDirectories())
+                    std::cout << "  " << directory << std::endl;
+            } else {
+                std::cout << "Importação automática desligada." << std::endl;
+            }
+            return;
+        }
+
+        if (mode == "off") {
+            _watcher->stop();
+            std::cout << "Importação automática desligada." << std::endl;
+            return;
+        }
+
+        if (mode != "on") {
+            showHelp("watch");
+            return;
+        }
+
+        if (!core::LibraryWatcher::isSupported()) {
+            std::cout << "Importação automática disponível apenas no Linux."
+                      << std::endl;
+            return;
+        }
+
+        try {
+            if (!_watcher->start(_manager->inputDirectories())) {
+                std::cerr << "Nenhum diretório de entrada pôde ser observado."
+                          << std::endl;
+                return;
+            }
+
+            // Arquivos que chegaram antes de ligar o modo são varridos na
+            // thread do observador; os que chegarem depois já geram eventos
+            _watcher->requestRescan();
+            std::cout << "Importação automática ligada." << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao ligar a importação automática: " << e.what()
+                      << std::endl;
+        }
+    }
+
     void Cli::showHelp() const {
         if (_helpData.empty() || !_helpData.contains("commands")) {
             std::cout << "Nenhuma informação de ajuda disponível." << std::endl;
@@ -421,79 +656,112 @@ namespace cli {
         }
     }
 
+    void Cli::postSearch(
+        const std::string& key,
+        std::function<std::string(core::RepositoryFactory&)> search) const {
+        // O texto é montado na thread do executor, mas mostrado entre os
+        // comandos do prompt; o prompt volta já. A mesma busca repetida
+        // enquanto a primeira está na fila é mostrada uma vez só
+        _db_executor->submitCoalesced(
+            key, [search = std::move(search)](core::RepositoryFactory& factory) {
+                try {
+                    printFromBackground(search(factory));
+                } catch (const std::exception& e) {
+                    printFromBackground(std::string("Erro na busca: ") + e.what() + "\n");
+                }
+            });
+    }
+
     void Cli::searchSong(const std::string& query) const {
-        auto songs = _library->searchSong(query);
         std::cout << "Procurando por músicas com o termo: " << query
                   << std::endl;
-        if (songs.empty()) {
-            std::cout << "Nenhuma música encontrada para: " << query
-                      << std::endl;
-            return;
-        } else if (songs.size() == 1) {
-            std::cout << "1 música encontrada: " << songs.at(0)->getTitle()
-                      << std::endl;
-        } else {
-            std::cout << songs.size() << "Músicas encontradas: \n";
-            for (auto song : songs)
-                std::cout << song->getTitle() << std::endl;
-        }
+        unsigned user_id = _user->getId();
+        postSearch("song:" + std::to_string(user_id) + ":" + query,
+                   [query, user_id](core::RepositoryFactory& factory) {
+            auto songs = factory.createSummaryRepository()->searchSongs(query, user_id);
+
+            std::ostringstream out;
+            if (songs.empty()) {
+                out << "Nenhuma música encontrada para: " << query << "\n";
+            } else if (songs.size() == 1) {
+                out << "1 música encontrada: " << songs.at(0).title << "\n";
+            } else {
+                out << songs.size() << "Músicas encontradas: \n";
+                for (const auto& song : songs)
+                    out << song.title << " - " << song.artist << "\n";
+            }
+            return out.str();
+        });
     }
 
     void Cli::searchArtist(const std::string& query) const {
-        auto artists = _library->searchArtist(query);
-        if (artists.empty()) {
-            std::cout << "Nenhum artista encontrado para:" << query
-                      << std::endl;
-            return;
-        } else if (artists.size() == 1) {
-            std::cout << "1 artista encontrado: " << artists.at(0)->getName()
-                      << std::endl;
-        } else {
-            std::cout << artists.size() << "Artistas encontrados: \n";
-            for (auto artist : artists)
-                std::cout << artist->getName() << std::endl;
-        }
+        unsigned user_id = _user->getId();
+        postSearch("artist:" + std::to_string(user_id) + ":" + query,
+                   [query, user_id](core::RepositoryFactory& factory) {
+            auto artists = factory.createSummaryRepository()->searchArtists(query, user_id);
+
+            std::ostringstream out;
+            if (artists.empty()) {
+                out << "Nenhum artista encontrado para:" << query << "\n";
+            } else if (artists.size() == 1) {
+                out << "1 artista encontrado: " << artists.at(0).name << "\n";
+            } else {
+                out << artists.size() << "Artistas encontrados: \n";
+                for (const auto& artist : artists)
+                    out << artist.name << "\n";
+            }
+            return out.str();
+        });
     }
 
     void Cli::searchAlbum(const std::string& query) const {
-        auto albums = _library->searchAlbum(query);
-        if (albums.empty()) {
-            std::cout << "Nenhum album encontrado para: " << query << std::endl;
-            return;
-        } else if (albums.size() == 1) {
-            std::cout << "1 album encontrado: " << albums.at(0)->getTitle()
-                      << std::endl;
-        } else {
-            std::cout << albums.size() << "Albuns encontrados: \n";
-            for (auto album : albums)
-                std::cout << album->getTitle() << " por "
-                          << album->getArtist()->getName() << std::endl;
-        }
+        unsigned user_id = _user->getId();
+        postSearch("album:" + std::to_string(user_id) + ":" + query,
+                   [query, user_id](core::RepositoryFactory& factory) {
+            auto albums = factory.createSummaryRepository()->searchAlbums(query, user_id);
+
+            std::ostringstream out;
+            if (albums.empty()) {
+                out << "Nenhum album encontrado para: " << query << "\n";
+            } else if (albums.size() == 1) {
+                out << "1 album encontrado: " << albums.at(0).title << "\n";
+            } else {
+                out << albums.size() << "Albuns encontrados: \n";
+                for (const auto& album : albums)
+                    out << album.title << " por " << album.artist << "\n";
+            }
+            return out.str();
+        });
     }
 
     void Cli::searchPlaylist(const std::string& query) const {
-        auto playlists = _library->searchPlaylist(query);
-        if (playlists.empty()) {
-            std::cout << "Nenhuma playlist encontrada para: " << query
-                      << std::endl;
-            return;
-        } else if (playlists.size() == 1) {
-            std::cout << "1 playlist encontrada: "
-                      << playlists.at(0)->getTitle() << std::endl;
-        } else {
-            std::cout << playlists.size() << "Playlists encontradas: \n";
-            for (auto playlist : playlists)
-                std::cout << playlist->getTitle() << std::endl;
-        }
+        std::shared_ptr<core::User> user = _user;
+        postSearch("playlist:" + std::to_string(user->getId()) + ":" + query,
+                   [query, user](core::RepositoryFactory& factory) {
+            auto playlists = factory.createPlaylistRepository()->search(query, *user);
+
+            std::ostringstream out;
+            if (playlists.empty()) {
+                out << "Nenhuma playlist encontrada para: " << query << "\n";
+            } else if (playlists.size() == 1) {
+                out << "1 playlist encontrada: " << playlists.at(0)->getTitle()
+                    << "\n";
+            } else {
+                out << playlists.size() << "Playlists encontradas: \n";
+                for (const auto& playlist : playlists)
+                    out << playlist->getTitle() << "\n";
+            }
+            return out.str();
+        });
     }
 
     void Cli::showPlaylist(core::IPlayable& playlist) const {
         auto pl = dynamic_cast<core::Playlist*>(&playlist);
         if (pl) {
             std::cout << "Playlist: " << pl->getTitle() << std::endl;
-            auto songs = pl->getSongs();
+            auto songs = _library->getPlaylistSongSummaries(pl->getId());
             for (const auto& song : songs) {
-                std::cout << "- " << song->getTitle() << std::endl;
+                std::cout << "- " << song.title << std::endl;
             }
         } else {
             std::cout << "O objeto fornecido não é uma playlist válida."
@@ -528,8 +796,9 @@ namespace cli {
                   << std::endl;
 
         while (true) {
-            std::cout << "frankenstein> ";
+            showPrompt();
             std::getline(std::cin, command);
+            leavePrompt();
 
             if (command == "exit" || command == "quit") {
                 std::cout << "Saindo do frankenstein Music Player. Até logo!"
@@ -665,6 +934,10 @@ namespace cli {
                         std::string playable;
                         std::getline(ss, playable);
                         playable = trimSpaces(playable);
+                        if (playable == "all") {
+                            addLibraryToQueue();
+                            return true;
+                        }
                         if (!playable.empty()) {
                             auto opt = _library->searchSong(playable);
                             if (opt.empty()) {
@@ -825,6 +1098,11 @@ namespace cli {
                        || firstCommand == "update_library") {
                 updateSongs();
                 return true;
+            } else if (firstCommand == "watch") {
+                std::string mode;
+                ss >> mode;
+                watch(mode);
+                return true;
             } else if (firstCommand == "search") {
                 std::string searchType;
                 if (ss >> searchType) {
@@ -854,6 +1132,12 @@ namespace cli {
 
                 showHelp("search");
                 return true;
+            } else if (firstCommand == "library" || firstCommand == "list") {
+                listSongs();
+                return true;
+            } else if (firstCommand == "dbstats") {
+                showDatabaseStats();
+                return true;
             } else if (firstCommand == "help") {
                 ss >> firstCommand ? showHelp(firstCommand) : showHelp();
                 return true;
@@ -12,22 +12,63 @@
 #include <string>
 
 namespace core {
+    namespace {
+        using AlbumColumns = EntityTraits<Album>;
+
+        /**
+         * @brief Colunas que ALBUM_EAGER_SELECT acrescenta às do álbum
+         */
+        enum EagerColumn : int {
+            ArtistId = AlbumColumns::ColumnCount,
+            ArtistName,
+            ArtistUserId,
+            SongsCount,
+            EagerColumnCount
+        };
+
+        /**
+         * @brief Seleção do álbum com artista principal e contagem de músicas
+         *
+         * Uma linha por álbum; as colunas extras permitem montar o álbum e o
+         * artista sem consultas adicionais. O artista vem de uma subconsulta
+         * e não de um JOIN em album_artists: com mais de um artista principal
+         * vale o de menor ID, e o álbum continua a ocupar uma única linha.
+         */
+        constexpr SqlText ALBUM_EAGER_SELECT =
+            SqlText("SELECT ") + AlbumColumns::columnList("alb")
+            + ", art.id AS artist_id, art.name AS artist_name, "
+              "art.user_id AS artist_user_id, "
+              "(SELECT COUNT(*) FROM songs s WHERE s.album_id = alb.id) AS songs_count "
+              "FROM albums alb "
+              "LEFT JOIN artists art ON art.id = "
+              "(SELECT aa.artist_id FROM album_artists aa "
+              "WHERE aa.album_id = alb.id AND aa.is_principal = 1 "
+              "ORDER BY aa.artist_id LIMIT 1) ";
+
+        /**
+         * @brief Indica se a linha veio de ALBUM_EAGER_SELECT
+         */
+        bool isEagerRow(SQLite::Statement& query) {
+            return query.getColumnCount() == EagerColumnCount;
+        }
+    }  // namespace
 
     AlbumRepository::AlbumRepository(std::shared_ptr<SQLite::Database> db)
-        : core::SQLiteRepositoryBase<Album>(db, "albums") {};
+        : core::SQLiteRepositoryBase<Album>(db),
+          _user_repo(std::make_shared<UserRepository>(db)) {
+        enableIdentityMap();
+    };
 
     bool AlbumRepository::insert(Album& entity) {
-        std::string sql = "INSERT INTO " + _table_name
-                          + " (title, release_year, genre, user_id) "
-                          + "VALUES (?, ?, ?, ?);";
-        SQLite::Statement query = prepare(sql);
+        static constexpr SqlText sql = AlbumColumns::insert();
+        auto query = prepare(sql);
 
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getYear());
-        query.bind(3, entity.getGenre());
-        query.bind(4, entity.getUser()->getId());
+        query->bind(1, entity.getTitle());
+        query->bind(2, entity.getYear());
+        query->bind(3, entity.getGenre());
+        query->bind(4, entity.getUser()->getId());
 
-        bool success = query.exec() > 0;
+        bool success = query->exec() > 0;
 
         if (success)
             entity.setId(static_cast<unsigned>(getLastInsertId()));
@@ -36,31 +77,31 @@ namespace core {
     };
 
     bool AlbumRepository::update(const Album& entity) {
-        std::string sql = "UPDATE " + _table_name
-                          + " SET title = ?, release_year = ?, genre = ?"
-                          + " WHERE id = ?";
+        static constexpr SqlText sql = AlbumColumns::update();
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getYear());
-        query.bind(3, entity.getGenre());
-        query.bind(4, entity.getId());
+        query->bind(1, entity.getTitle());
+        query->bind(2, entity.getYear());
+        query->bind(3, entity.getGenre());
+        query->bind(4, entity.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     };
 
     std::shared_ptr<Album>
     AlbumRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = query.getColumn("id").getInt();
+        if (isEagerRow(query))
+            return mapEagerRow(query);
 
-        std::string title = query.getColumn("title").getString();
-        int year = query.getColumn("release_year").getInt();
-        std::string genre = query.getColumn("genre").getString();
-        unsigned user_id = query.getColumn("user_id").getInt();
+        unsigned id = AlbumColumns::read<AlbumColumns::Id>(query);
 
-        auto user_repo = UserRepository(_db);
-        auto user_ptr = user_repo.findById(user_id);
+        std::string title = AlbumColumns::read<AlbumColumns::Title>(query);
+        int year = AlbumColumns::read<AlbumColumns::ReleaseYear>(query);
+        std::string genre = AlbumColumns::read<AlbumColumns::Genre>(query);
+        unsigned user_id = AlbumColumns::read<AlbumColumns::UserId>(query);
+
+        auto user_ptr = _user_repo->findSharedById(user_id);
 
         if (!user_ptr) {
             std::cerr << "ERROR: User not found for album id=" << id
@@ -68,53 +109,101 @@ namespace core {
             return nullptr;
         }
 
-        std::string artist_sql =
+        auto artist_query = prepare(
             "SELECT artist_id FROM album_artists "
-            "WHERE album_id = ? AND is_principal = 1 LIMIT 1;";
-        SQLite::Statement artist_query(*_db, artist_sql);
-        artist_query.bind(1, static_cast<int>(id));
+            "WHERE album_id = ? AND is_principal = 1 LIMIT 1;");
+        artist_query->bind(1, static_cast<int>(id));
 
         std::shared_ptr<Artist> artist_ptr = nullptr;
-        if (artist_query.executeStep()) {
-            unsigned artist_id = artist_query.getColumn("artist_id").getInt();
+        if (artist_query->executeStep()) {
+            unsigned artist_id = artist_query->getColumn(0).getInt();
             ArtistRepository artist_repo(_db);
             artist_ptr = artist_repo.findById(artist_id);
         }
 
+        return buildAlbum(id, title, year, genre, user_ptr, artist_ptr);
+    }
+
+    std::shared_ptr<Album>
+    AlbumRepository::mapEagerRow(SQLite::Statement& query) const {
+        unsigned id = AlbumColumns::read<AlbumColumns::Id>(query);
+
+        std::string title = AlbumColumns::read<AlbumColumns::Title>(query);
+        int year = AlbumColumns::read<AlbumColumns::ReleaseYear>(query);
+        std::string genre = AlbumColumns::read<AlbumColumns::Genre>(query);
+        unsigned user_id = AlbumColumns::read<AlbumColumns::UserId>(query);
+
+        auto user_ptr = _user_repo->findSharedById(user_id);
+
+        if (!user_ptr) {
+            std::cerr << "ERROR: User not found for album id=" << id
+                      << std::endl;
+            return nullptr;
+        }
+
+        std::shared_ptr<Artist> artist_ptr = nullptr;
+        if (!query.getColumn(ArtistId).isNull()) {
+            artist_ptr = ArtistRepository(_db).findOrMap(
+                query.getColumn(ArtistId).getInt(),
+                query.getColumn(ArtistName).getString(),
+                query.getColumn(ArtistUserId).getInt());
+        }
+
+        auto album = buildAlbum(id, title, year, genre, user_ptr, artist_ptr);
+        album->setSongsCount(
+            static_cast<size_t>(query.getColumn(SongsCount).getInt64()));
+        return album;
+    }
+
+    std::string_view AlbumRepository::idsSelectPrefix() const {
+        static constexpr SqlText sql = ALBUM_EAGER_SELECT + "WHERE alb.id IN (";
+        return sql;
+    }
+
+    std::shared_ptr<Album>
+    AlbumRepository::buildAlbum(unsigned id,
+                                const std::string& title,
+                                int year,
+                                const std::string& genre,
+                                std::shared_ptr<const User> user_ptr,
+                                std::shared_ptr<Artist> artist_ptr) const {
         if (!artist_ptr) {
             std::cerr << "ERROR: Principal artist not found for album id=" << id
                       << std::endl;
             Artist::string_type unknownName = "Unknown Artist";
-            artist_ptr = std::make_shared<Artist>(0, unknownName, *user_ptr);
+            artist_ptr = std::make_shared<Artist>(0, unknownName, user_ptr);
         }
 
         auto album = std::make_shared<Album>(
-            id, title, year, genre, *artist_ptr, *user_ptr);
+            id, title, year, genre, *artist_ptr);
+        album->setUser(user_ptr);
 
-        auto songs_loader = [this, id]() -> std::vector<std::shared_ptr<Song>> {
-            auto albumPtr = this->findById(id);
-            if (albumPtr) {
-                return this->getSongs(*albumPtr);
-            }
-            return {};
+        // Os loaders não capturam this: o álbum pode continuar no mapa de
+        // identidade depois que este repositório for destruído
+        auto db = _db;
+        auto songs_loader = [db, id]() -> std::vector<std::shared_ptr<Song>> {
+            Album tempAlbum;
+            tempAlbum.setId(id);
+            return SongRepository(db).findByAlbum(tempAlbum);
         };
 
-        auto artists_loader = [this,
+        auto artists_loader = [db,
                                id]() -> std::vector<std::shared_ptr<Artist>> {
             Album tempAlbum;
             tempAlbum.setId(id);
-            return this->getFeaturingArtists(tempAlbum);
+            return AlbumRepository(db).getFeaturingArtists(tempAlbum);
         };
 
         album->setSongsLoader(songs_loader);
         album->setFeaturingArtistsLoader(artists_loader);
 
-        auto artist_loader = [this, id]() -> std::shared_ptr<Artist> {
-            auto albumPtr = this->findById(id);
-            if (albumPtr) {
-                return this->getArtist(*albumPtr);
-            }
-            return nullptr;
+        // O artista principal já foi lido: o loader só o busca no mapa de
+        // identidade, consultando o banco apenas se ele tiver sido removido
+        unsigned artist_id = artist_ptr->getId();
+        auto artist_loader = [db, artist_id]() -> std::shared_ptr<Artist> {
+            if (artist_id == 0)
+                return nullptr;
+            return ArtistRepository(db).findById(artist_id);
         };
         album->setArtistLoader(artist_loader);
         return album;
@@ -124,93 +213,95 @@ namespace core {
         if (entity.getId() == 0) {
             return insert(entity);
         } else {
+            invalidate(entity.getId());
             return update(entity);
         }
     };
 
     bool AlbumRepository::remove(unsigned id) {
-        std::string sql = "DELETE FROM " + _table_name + " WHERE id = ?;";
+        invalidate(id);
+        // songs.album_id passa a ser NULL nas músicas do álbum
+        auto songs = IdentityMap<Song>::forDatabase(_db);
+        if (songs)
+            songs->clear();
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, id);
+        static constexpr SqlText sql = SqlText("DELETE FROM ") + AlbumColumns::table
+                                       + " WHERE id = ?;";
 
-        return query.exec() > 0;
+        auto query = prepare(sql);
+        query->bind(1, id);
+
+        return query->exec() > 0;
     };
 
     std::vector<std::shared_ptr<Album>>
-    AlbumRepository::findByTitleAndUser(const std::string& title,
-                                        const User& user) const {
-        std::string sql = "SELECT * FROM " + _table_name
-                          + " WHERE title LIKE ? AND user_id = ?;";
-
-        SQLite::Statement query = prepare(sql);
-
-        query.bind(1, "%" + title + "%");
-        query.bind(2, user.getId());
-
+    AlbumRepository::mapAlbums(SQLite::Statement& query) const {
         std::vector<std::shared_ptr<Album>> albums;
         while (query.executeStep()) {
-            albums.push_back(mapRowToEntity(query));
+            unsigned id = AlbumColumns::read<AlbumColumns::Id>(query);
+            auto album = findCached(id);
+            if (!album)
+                album = cache(id, mapEagerRow(query));
+            if (album)
+                albums.push_back(album);
         }
 
         return albums;
     }
 
     std::vector<std::shared_ptr<Album>>
-    AlbumRepository::findByUser(const User& user) const {
-        std::string sql =
-            "SELECT * FROM " + _table_name + " WHERE user_id = ?;";
+    AlbumRepository::findByTitleAndUser(const std::string& title,
+                                        const User& user) const {
+        static constexpr SqlText sql =
+            ALBUM_EAGER_SELECT + "WHERE alb.title LIKE ? AND alb.user_id = ?;";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, user.getId());
+        auto query = prepare(sql);
 
-        std::vector<std::shared_ptr<Album>> albums;
-        while (query.executeStep()) {
-            albums.push_back(mapRowToEntity(query));
-        }
+        query->bind(1, "%" + title + "%");
+        query->bind(2, user.getId());
 
-        return albums;
+        return mapAlbums(*query);
     }
 
     std::vector<std::shared_ptr<Album>>
-    AlbumRepository::findByArtist(const std::string& artist_name) const {
-        std::string sql = "SELECT alb.* FROM albums alb "
-                          "JOIN album_artists aa ON alb.id = aa.album_id "
-                          "JOIN artists art ON aa.artist_id = art.id "
-                          "WHERE art.name LIKE ? AND aa.is_principal = 1;";
+    AlbumRepository::findByUser(const User& user) const {
+        static constexpr SqlText sql = ALBUM_EAGER_SELECT + "WHERE alb.user_id = ?;";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
+        query->bind(1, user.getId());
 
-        query.bind(1, "%" + artist_name + "%");
+        return mapAlbums(*query);
+    }
 
-        std::vector<std::shared_ptr<Album>> albums;
+    std::vector<std::shared_ptr<Album>>
+    AlbumRepository::findByArtist(const std::string& artist_name) const {
+        // Basta que um dos artistas principais tenha o nome procurado
+        static constexpr SqlText sql =
+            ALBUM_EAGER_SELECT
+            + "WHERE EXISTS (SELECT 1 FROM album_artists aa "
+              "JOIN artists principal ON principal.id = aa.artist_id "
+              "WHERE aa.album_id = alb.id AND aa.is_principal = 1 "
+              "AND principal.name LIKE ?);";
 
-        while (query.executeStep()) {
-            try {
-                auto album = mapRowToEntity(query);
-                if (album) {
-                    albums.push_back(album);
-                } else {
-                    std::cerr << "DEBUG: mapRowToEntity returned nullptr"
-                              << std::endl;
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "ERROR in mapRowToEntity: " << e.what()
-                          << std::endl;
-            }
-        }
+        auto query = prepare(sql);
 
-        return albums;
+        query->bind(1, "%" + artist_name + "%");
+
+        return mapAlbums(*query);
     }
 
     std::shared_ptr<Album> AlbumRepository::findById(unsigned id) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE id = ?;";
+        auto cached = findCached(id);
+        if (cached)
+            return cached;
+
+        static constexpr SqlText sql = ALBUM_EAGER_SELECT + "WHERE alb.id = ? LIMIT 1;";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, id);
+        auto query = prepare(sql);
+        query->bind(1, id);
 
-        if (query.executeStep()) {
-            return mapRowToEntity(query);
+        if (query->executeStep()) {
+            return cache(id, mapEagerRow(*query));
         }
 
         return nullptr;
@@ -224,18 +315,17 @@ namespace core {
 
     std::vector<std::shared_ptr<Artist>>
     AlbumRepository::getFeaturingArtists(const Album& album) const {
-        std::string sql = "SELECT a.* FROM artists a "
-                          "JOIN album_artists aa ON a.id = aa.artist_id "
-                          "WHERE aa.album_id = ? AND aa.is_principal = 0;";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, album.getId());
+        // Só os IDs: os artistas vêm do mapa de identidade quando possível
+        auto query = prepare("SELECT a.id FROM artists a "
+                             "JOIN album_artists aa ON a.id = aa.artist_id "
+                             "WHERE aa.album_id = ? AND aa.is_principal = 0;");
+        query->bind(1, album.getId());
 
         std::vector<std::shared_ptr<Artist>> artists;
         ArtistRepository artistRepo(_db);
 
-        while (query.executeStep()) {
-            unsigned id = query.getColumn("id").getInt();
+        while (query->executeStep()) {
+            unsigned id = query->getColumn(0).getInt();
             auto artist = artistRepo.findById(id);
             if (artist) {
                 artists.push_back(artist);
@@ -248,14 +338,14 @@ namespace core {
     std::shared_ptr<Artist>
     AlbumRepository::getArtist(const Album& album) const {
         // Primeiro buscar o ID do artista principal da tabela album_artists
-        std::string sql = "SELECT artist_id FROM album_artists "
-                          "WHERE album_id = ? AND is_principal = 1 LIMIT 1;";
+        static constexpr SqlText sql = "SELECT artist_id FROM album_artists "
+                                       "WHERE album_id = ? AND is_principal = 1 LIMIT 1;";
 
-        SQLite::Statement query(*_db, sql);
-        query.bind(1, album.getId());
+        auto query = prepare(sql);
+        query->bind(1, album.getId());
 
-        if (query.executeStep()) {
-            unsigned artist_id = query.getColumn("artist_id").getInt();
+        if (query->executeStep()) {
+            unsigned artist_id = query->getColumn(0).getInt();
             ArtistRepository artist_repo(_db);
             return artist_repo.findById(artist_id);
         }
@@ -264,12 +354,13 @@ namespace core {
     };
 
     size_t AlbumRepository::count() const {
-        std::string sql = "SELECT COUNT(*) FROM " + _table_name + ";";
+        static constexpr SqlText sql = SqlText("SELECT COUNT(*) FROM ")
+                                       + AlbumColumns::table + ";";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
-        if (query.executeStep()) {
-            return query.getColumn(0).getInt();
+        if (query->executeStep()) {
+            return query->getColumn(0).getInt();
         }
 
         return 0;
@@ -278,36 +369,55 @@ namespace core {
     bool AlbumRepository::addFeaturingArtist(const Album& album,
                                              const Artist& artist,
                                              const User& user) const {
-        std::string sql = "INSERT OR IGNORE INTO album_artists (album_id, "
-                          "artist_id, user_id, is_principal) "
-                          "VALUES (?, ?, ?, 0);";
+        invalidate(album.getId());
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, album.getId());
-        query.bind(2, artist.getId());
-        query.bind(3, user.getId());
+        static constexpr SqlText sql = "INSERT OR IGNORE INTO album_artists (album_id, "
+                                       "artist_id, user_id, is_principal) "
+                                       "VALUES (?, ?, ?, 0);";
 
-        return query.exec() > 0;
+        auto query = prepare(sql);
+        query->bind(1, album.getId());
+        query->bind(2, artist.getId());
+        query->bind(3, user.getId());
+
+        return query->exec() > 0;
     }
 
     bool AlbumRepository::setPrincipalArtist(const Album& album,
                                              const Artist& artist,
                                              const User& user) const {
-        std::string delete_sql = "DELETE FROM album_artists WHERE album_id = ? "
-                                 "AND is_principal = 1;";
-        SQLite::Statement delete_query = prepare(delete_sql);
-        delete_query.bind(1, album.getId());
-        delete_query.exec();
-
-        std::string insert_sql = "INSERT OR REPLACE INTO album_artists "
-                                 "(album_id, artist_id, user_id, is_principal) "
-                                 "VALUES (?, ?, ?, 1);";
-        SQLite::Statement insert_query = prepare(insert_sql);
-        insert_query.bind(1, album.getId());
-        insert_query.bind(2, artist.getId());
-        insert_query.bind(3, user.getId());
-
-        return insert_query.exec() > 0;
+        invalidate(album.getId());
+
+        static constexpr SqlText delete_sql = "DELETE FROM album_artists WHERE album_id = ? "
+                                              "AND is_principal = 1;";
+        auto delete_query = prepare(delete_sql);
+        delete_query->bind(1, album.getId());
+        delete_query->exec();
+
+        static constexpr SqlText insert_sql = "INSERT OR REPLACE INTO album_artists "
+                                              "(album_id, artist_id, user_id, is_principal) "
+                                              "VALUES (?, ?, ?, 1);";
+        auto insert_query = prepare(insert_sql);
+        insert_query->bind(1, album.getId());
+        insert_query->bind(2, artist.getId());
+        insert_query->bind(3, user.getId());
+
+        return insert_query->exec() > 0;
     }
 
+    std::vector<std::shared_ptr<Album>>
+    AlbumRepository::search(const std::string& query,
+                            const User& user,
+                            size_t limit) const {
+        if (SearchIndex::toMatchExpression(query).empty())
+            return findByTitleAndUser(query, user);
+
+        std::vector<unsigned> ids;
+        SearchIndex index(_db);
+        for (const auto& hit :
+             index.search(query, SearchIndex::Kind::Album, user.getId(), limit))
+            ids.push_back(hit.id);
+
+        return findByIds(ids);
+    }
 } // namespace core
@@ -21,22 +21,25 @@
 */
 
 namespace core {
+    using ArtistColumns = EntityTraits<Artist>;
 
     ArtistRepository::ArtistRepository(std::shared_ptr<SQLite::Database> db)
-        : core::SQLiteRepositoryBase<Artist>(db, "artists") {};
+        : core::SQLiteRepositoryBase<Artist>(db),
+          _user_repo(std::make_shared<UserRepository>(db)) {
+        enableIdentityMap();
+    };
 
     bool ArtistRepository::insert(Artist& entity) {
         if (!entity.getUser())
             throw std::invalid_argument(
                 "Artist must be associated with a User.");
-        std::string sql = "INSERT INTO " + _table_name + " (name, user_id) "
-                          + "VALUES(?, ?);";
-        SQLite::Statement query = prepare(sql);
+        static constexpr SqlText sql = ArtistColumns::insert();
+        auto query = prepare(sql);
 
-        query.bind(1, entity.getName());
-        query.bind(2, entity.getUser()->getId());
+        query->bind(1, entity.getName());
+        query->bind(2, entity.getUser()->getId());
 
-        bool success = query.exec() > 0;
+        bool success = query->exec() > 0;
 
         if (success)
             entity.setId(static_cast<unsigned>(getLastInsertId()));
@@ -45,46 +48,56 @@ namespace core {
     }
 
     bool ArtistRepository::update(const Artist& entity) {
-        std::string sql =
-            "UPDATE " + _table_name + " SET name = ?, user_id = ? WHERE id = ?";
-        SQLite::Statement query = prepare(sql);
+        static constexpr SqlText sql = ArtistColumns::update();
+        auto query = prepare(sql);
 
-        query.bind(1, entity.getName());
-        query.bind(2, entity.getUser()->getId());
-        query.bind(3, entity.getId());
+        query->bind(1, entity.getName());
+        query->bind(2, entity.getUser()->getId());
+        query->bind(3, entity.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     };
 
     std::shared_ptr<Artist>
     ArtistRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = query.getColumn("id").getInt();
-        std::string name = query.getColumn("name").getString();
-        unsigned user_id = query.getColumn("user_id").getInt();
+        unsigned id = ArtistColumns::read<ArtistColumns::Id>(query);
+        std::string name = ArtistColumns::read<ArtistColumns::Name>(query);
+        unsigned user_id = ArtistColumns::read<ArtistColumns::UserId>(query);
+
+        return buildArtist(id, name, user_id);
+    }
 
-        auto user_repo = UserRepository(_db);
-        auto user_ptr = user_repo.findById(user_id);
+    std::shared_ptr<Artist>
+    ArtistRepository::buildArtist(unsigned id,
+                                  const std::string& name,
+                                  unsigned user_id) const {
+        auto user_ptr = _user_repo->findSharedById(user_id);
 
         if (!user_ptr) {
             throw std::runtime_error("Usuário não encontrado para artista id "
                                      + std::to_string(id));
         }
 
-        auto artist = std::make_shared<Artist>(id, name, *user_ptr);
+        auto artist = std::make_shared<Artist>(id, name, user_ptr);
 
-        auto songs_loader = [this, id]() -> std::vector<std::shared_ptr<Song>> {
-            auto artist_ptr = this->findById(id);
+        // Os loaders não capturam this: o artista pode continuar no mapa de
+        // identidade depois que este repositório for destruído
+        auto db = _db;
+        auto songs_loader = [db, id]() -> std::vector<std::shared_ptr<Song>> {
+            ArtistRepository artist_repo(db);
+            auto artist_ptr = artist_repo.findById(id);
             if (artist_ptr) {
-                return this->getSongs(*artist_ptr);
+                return artist_repo.getSongs(*artist_ptr);
             }
             return std::vector<std::shared_ptr<Song>>();
         };
 
-        auto albums_loader = [this,
+        auto albums_loader = [db,
                               id]() -> std::vector<std::shared_ptr<Album>> {
-            auto artist_ptr = this->findById(id);
+            ArtistRepository artist_repo(db);
+            auto artist_ptr = artist_repo.findById(id);
             if (artist_ptr) {
-                return this->getAlbums(*artist_ptr);
+                return artist_repo.getAlbums(*artist_ptr);
             }
             return std::vector<std::shared_ptr<Album>>();
         };
@@ -95,38 +108,60 @@ namespace core {
         return artist;
     }
 
+    std::shared_ptr<Artist>
+    ArtistRepository::findOrMap(unsigned id,
+                                const std::string& name,
+                                unsigned user_id) const {
+        auto cached = findCached(id);
+        if (cached)
+            return cached;
+
+        return cache(id, buildArtist(id, name, user_id));
+    }
+
     bool ArtistRepository::save(Artist& entity) {
         if (entity.getId() == 0) {
             return insert(entity);
         } else {
+            invalidate(entity.getId());
             return update(entity);
         }
     };
 
     bool ArtistRepository::remove(unsigned id) {
-        std::string sql = "DELETE FROM " + _table_name + " WHERE id = ?;";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, id);
-
-        return query.exec() > 0;
+        invalidate(id);
+        // Músicas e vínculos de álbuns do artista são removidos em cascata
+        auto songs = IdentityMap<Song>::forDatabase(_db);
+        if (songs)
+            songs->clear();
+        auto albums = IdentityMap<Album>::forDatabase(_db);
+        if (albums)
+            albums->clear();
+
+        static constexpr SqlText sql = SqlText("DELETE FROM ") + ArtistColumns::table
+                                       + " WHERE id = ?;";
+
+        auto query = prepare(sql);
+        query->bind(1, id);
+
+        return query->exec() > 0;
     }
 
     std::vector<std::shared_ptr<Artist>>
     ArtistRepository::findByNameAndUser(const std::string& name,
                                         const User& user) const {
-        std::string sql = "SELECT * FROM " + _table_name
-                          + " WHERE name LIKE ? AND user_id = ?;";
+        static constexpr SqlText sql = ArtistColumns::select()
+                                       + " WHERE name LIKE ? AND user_id = ?;";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
 
-        query.bind(1, "%" + name + "%");
-        query.bind(2, user.getId());
+        query->bind(1, "%" + name + "%");
+        query->bind(2, user.getId());
 
         std::vector<std::shared_ptr<Artist>> artists;
-        while (query.executeStep()) {
-            artists.push_back(mapRowToEntity(query));
+        while (query->executeStep()) {
+            artists.push_back(mapRowToEntity(*query));
         }
 
         return artists;
@@ -134,12 +169,16 @@ namespace core {
 
     std::vector<std::shared_ptr<Artist>>
     ArtistRepository::findByName(const std::string& name) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE name = ?;";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, name);
+        // Busca só os IDs para reaproveitar os artistas do mapa de identidade
+        static constexpr SqlText sql = SqlText("SELECT id FROM ")
+                                       + ArtistColumns::table + " WHERE name = ?;";
+        auto query = prepare(sql);
+        query->bind(1, name);
         std::vector<std::shared_ptr<Artist>> artists;
-        while (query.executeStep()) {
-            artists.push_back(mapRowToEntity(query));
+        while (query->executeStep()) {
+            auto artist = findById(query->getColumn(0).getInt());
+            if (artist)
+                artists.push_back(artist);
         }
 
         return artists;
@@ -157,4 +196,19 @@ namespace core {
         return song_repository.findByArtist(artist);
     };
 
+    std::vector<std::shared_ptr<Artist>>
+    ArtistRepository::search(const std::string& query,
+                             const User& user,
+                             size_t limit) const {
+        if (SearchIndex::toMatchExpression(query).empty())
+            return findByNameAndUser(query, user);
+
+        std::vector<unsigned> ids;
+        SearchIndex index(_db);
+        for (const auto& hit :
+             index.search(query, SearchIndex::Kind::Artist, user.getId(), limit))
+            ids.push_back(hit.id);
+
+        return findByIds(ids);
+    }
 }; // namespace core
@@ -0,0 +1,194 @@
+/**
+ * @file DataLoader.cpp
+ * @brief Implementação do carregamento em lote das relações das músicas
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include "core/bd/DataLoader.hpp"
+
+#include <algorithm>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+
+namespace core {
+    namespace {
+        /**
+         * @brief Escopos abertos na thread, do mais externo ao mais interno
+         */
+        std::vector<DataLoader*>& activeLoaders() {
+            thread_local std::vector<DataLoader*> loaders;
+            return loaders;
+        }
+    }  // namespace
+
+    DataLoader::Scope::Scope(DataLoader& loader) : _loader(loader) {
+        activeLoaders().push_back(&_loader);
+    }
+
+    DataLoader::Scope::~Scope() {
+        auto& loaders = activeLoaders();
+        auto found = std::find(loaders.rbegin(), loaders.rend(), &_loader);
+        if (found != loaders.rend())
+            loaders.erase(std::next(found).base());
+    }
+
+    DataLoader::DataLoader(std::shared_ptr<SQLite::Database> db)
+        : _db(db), _batches(0) {}
+
+    void DataLoader::prime(const std::shared_ptr<Song>& song) {
+        if (!song)
+            return;
+
+        _songs.push_back(song);
+
+        unsigned artist_id = song->getArtistId();
+        auto artist = _artists.find(artist_id);
+        if (artist != _artists.end()) {
+            if (artist->second)
+                song->setArtist(artist->second);
+        } else if (artist_id > 0) {
+            _pending_artists.insert(artist_id);
+        }
+
+        unsigned album_id = song->getAlbumId();
+        auto album = _albums.find(album_id);
+        if (album != _albums.end()) {
+            if (album->second)
+                song->setAlbum(album->second);
+        } else if (album_id > 0) {
+            _pending_albums.insert(album_id);
+        }
+
+        if (!_featuring.count(song->getId()))
+            _pending_featuring.insert(song->getId());
+    }
+
+    void DataLoader::prime(const std::vector<std::shared_ptr<Song>>& songs) {
+        for (const auto& song : songs)
+            prime(song);
+    }
+
+    void DataLoader::dispatchArtists() {
+        std::vector<unsigned> ids(_pending_artists.begin(), _pending_artists.end());
+        _pending_artists.clear();
+        if (ids.empty())
+            return;
+
+        for (unsigned id : ids)
+            _artists[id] = nullptr;
+        for (auto& artist : ArtistRepository(_db).findByIds(ids))
+            _artists[artist->getId()] = artist;
+        _batches++;
+
+        for (const auto& weak : _songs) {
+            auto song = weak.lock();
+            if (!song)
+                continue;
+
+            auto artist = _artists.find(song->getArtistId());
+            if (artist != _artists.end() && artist->second)
+                song->setArtist(artist->second);
+        }
+    }
+
+    void DataLoader::dispatchAlbums() {
+        std::vector<unsigned> ids(_pending_albums.begin(), _pending_albums.end());
+        _pending_albums.clear();
+        if (ids.empty())
+            return;
+
+        for (unsigned id : ids)
+            _albums[id] = nullptr;
+        for (auto& album : AlbumRepository(_db).findByIds(ids))
+            _albums[album->getId()] = album;
+        _batches++;
+
+        for (const auto& weak : _songs) {
+            auto song = weak.lock();
+            if (!song)
+                continue;
+
+            auto album = _albums.find(song->getAlbumId());
+            if (album != _albums.end() && album->second)
+                song->setAlbum(album->second);
+        }
+    }
+
+    void DataLoader::dispatchFeaturing() {
+        std::vector<unsigned> ids(_pending_featuring.begin(),
+                                  _pending_featuring.end());
+        _pending_featuring.clear();
+        if (ids.empty())
+            return;
+
+        auto featuring = SongRepository(_db).getFeaturingArtists(ids);
+        for (unsigned id : ids)
+            _featuring[id] = std::move(featuring[id]);
+        _batches++;
+    }
+
+    std::shared_ptr<Artist> DataLoader::loadArtist(unsigned id) {
+        auto found = _artists.find(id);
+        if (found != _artists.end())
+            return found->second;
+
+        _pending_artists.insert(id);
+        dispatchArtists();
+        return _artists[id];
+    }
+
+    std::shared_ptr<Album> DataLoader::loadAlbum(unsigned id) {
+        auto found = _albums.find(id);
+        if (found != _albums.end())
+            return found->second;
+
+        _pending_albums.insert(id);
+        dispatchAlbums();
+        return _albums[id];
+    }
+
+    std::vector<std::shared_ptr<Artist>>
+    DataLoader::loadFeaturingArtists(unsigned song_id) {
+        auto found = _featuring.find(song_id);
+        if (found != _featuring.end())
+            return found->second;
+
+        _pending_featuring.insert(song_id);
+        dispatchFeaturing();
+        return _featuring[song_id];
+    }
+
+    size_t DataLoader::getBatchCount() const {
+        return _batches;
+    }
+
+    bool DataLoader::sameDatabase(const std::shared_ptr<SQLite::Database>& a,
+                                  const std::shared_ptr<SQLite::Database>& b) {
+        if (a == b)
+            return true;
+        if (!a || !b)
+            return false;
+
+        // Conexões do pool de leitura acessam o mesmo arquivo que a de escrita
+        const std::string& filename = a->getFilename();
+        return !filename.empty() && filename != ":memory:"
+               && filename == b->getFilename();
+    }
+
+    DataLoader* DataLoader::current(const std::shared_ptr<SQLite::Database>& db) {
+        auto& loaders = activeLoaders();
+        for (auto it = loaders.rbegin(); it != loaders.rend(); ++it) {
+            if (sameDatabase((*it)->_db, db))
+                return *it;
+        }
+        return nullptr;
+    }
+}  // namespace core
@@ -0,0 +1,130 @@
+/**
+ * @file DatabaseExecutor.cpp
+ * @brief Implementação do executor das operações com o banco de dados
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#include "core/bd/DatabaseExecutor.hpp"
+
+#include <utility>
+
+namespace core {
+    OperationCancelled::OperationCancelled()
+        : std::runtime_error("Operação cancelada") {}
+
+    CancellationToken::CancellationToken()
+        : _cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void CancellationToken::cancel() {
+        _cancelled->store(true);
+    }
+
+    bool CancellationToken::isCancelled() const {
+        return _cancelled->load();
+    }
+
+    DatabaseExecutor::DatabaseExecutor(std::shared_ptr<SQLite::Database> db)
+        : _factory(db), _stopping(false), _stopped(false) {
+        _worker = std::thread(&DatabaseExecutor::run, this);
+        _worker_id = _worker.get_id();
+    }
+
+    DatabaseExecutor::~DatabaseExecutor() {
+        stop();
+    }
+
+    bool DatabaseExecutor::runsInline() const {
+        // Até o fim da thread, os pedidos vão para a fila que ela esvazia
+        return _stopped || std::this_thread::get_id() == _worker_id;
+    }
+
+    void DatabaseExecutor::enqueue(Request request) {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (runsInline()) {
+            // Esperar pela fila aqui travaria a própria thread do executor
+            lock.unlock();
+            executeInline(request);
+            return;
+        }
+
+        _queue.push_back(std::move(request));
+        _wake.notify_one();
+    }
+
+    void DatabaseExecutor::execute(Request& request) {
+        if (request.token.isCancelled()) {
+            request.abort(std::make_exception_ptr(OperationCancelled()));
+            return;
+        }
+
+        request.run(_factory);
+    }
+
+    void DatabaseExecutor::executeInline(Request& request) {
+        if (std::this_thread::get_id() == _worker_id) {
+            execute(request);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_inline_mutex);
+        execute(request);
+    }
+
+    void DatabaseExecutor::run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _wake.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+
+            if (_queue.empty())
+                break;
+
+            Request request = std::move(_queue.front());
+            _queue.pop_front();
+
+            // Pedidos feitos a partir daqui executam a consulta de novo
+            if (!request.key.empty())
+                _coalesced.erase(request.key);
+
+            lock.unlock();
+            execute(request);
+            lock.lock();
+        }
+    }
+
+    void DatabaseExecutor::stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping)
+                return;
+            _stopping = true;
+        }
+
+        _wake.notify_one();
+        if (_worker.joinable())
+            _worker.join();
+
+        // Pedidos que chegaram depois da última verificação da thread são
+        // executados antes de qualquer pedido feito em seguida
+        std::lock_guard<std::mutex> inline_lock(_inline_mutex);
+        std::deque<Request> remaining;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+            remaining.swap(_queue);
+            _coalesced.clear();
+        }
+
+        for (Request& request : remaining)
+            execute(request);
+    }
+
+    size_t DatabaseExecutor::pending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+}  // namespace core
@@ -8,46 +8,421 @@
  */
 
 #include "core/bd/DatabaseManager.hpp"
+#include "core/bd/QueryProfiler.hpp"
+#include "core/bd/SchemaMigrations.hpp"
 
-#include <filesystem>
-#include <fstream>
-#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 
+#include <SQLiteCpp/Backup.h>
+#include <sqlite3.h>
 
 namespace core {
+    /**
+     * @brief Cópia em memória do banco e sua gravação periódica no arquivo
+     *
+     * Há uma cópia por arquivo no processo, compartilhada pelos
+     * gerenciadores e pelas conexões que eles entregam; a última referência
+     * liberada encerra a thread de gravação e grava as alterações pendentes.
+     *
+     * A cópia usa o VFS `memdb` com um nome que começa com "/", o que permite
+     * abrir várias conexões para ela, cada uma com a sua transação. A
+     * gravação lê a cópia por uma conexão própria: enquanto outra conexão
+     * tiver uma transação de escrita aberta a leitura falha com
+     * `SQLITE_BUSY`, então o arquivo nunca recebe uma transação pela metade.
+     *
+     * Cada gravação substitui o arquivo inteiro pela cópia. Se outra conexão
+     * alterar o arquivo depois que a cópia foi criada, as gravações são
+     * recusadas para não apagar essas alterações e a cópia passa a aceitar
+     * só leituras, para que nenhuma escrita seja aceita e depois perdida.
+     */
+    class DatabaseManager::MemoryMirror {
+    private:
+        static constexpr const char* DIVERGED_MESSAGE =
+            "A cópia em memória do banco não será gravada: o arquivo foi "
+            "alterado por outra conexão depois que a cópia foi criada";
+
+        std::string _name; /*!< @brief Nome da cópia no VFS memdb */
+        std::shared_ptr<SQLite::Database> _disk;   /*!< @brief Conexão com o arquivo, destino das gravações */
+        std::shared_ptr<SQLite::Database> _memory; /*!< @brief Conexão de escrita principal com a cópia */
+        std::unique_ptr<SQLite::Database> _source; /*!< @brief Conexão usada só para ler a cópia na gravação */
+        std::chrono::milliseconds _interval;
+        int _flushed_version; /*!< @brief PRAGMA data_version de _source na última gravação */
+        int _disk_version;    /*!< @brief PRAGMA data_version de _disk após a última cópia */
+        std::atomic<bool> _diverged; /*!< @brief Indica que outra conexão alterou o arquivo */
+        std::vector<std::weak_ptr<SQLite::Database>> _writers; /*!< @brief Conexões de escrita abertas por openConnection() */
+        std::mutex _flush_mutex;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        bool _stopping;
+        std::thread _worker;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_wake.wait_for(lock, _interval, [this]() { return _stopping; })) {
+                lock.unlock();
+                try {
+                    flush();
+                } catch (const std::exception& e) {
+                    std::cerr << "Erro ao gravar a cópia em memória do banco: "
+                              << e.what() << std::endl;
+                }
+                if (_diverged)
+                    return;
+                lock.lock();
+            }
+        }
+
+    public:
+        /**
+         * @brief Protege o registro de cópias e a gravação final de cada uma
+         *
+         * Uma cópia nova só é criada depois que a anterior do mesmo arquivo
+         * terminou de gravar.
+         */
+        static std::mutex& registryMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        /**
+         * @brief Cópias abertas, indexadas pelo caminho do arquivo
+         */
+        static std::map<std::string, std::weak_ptr<MemoryMirror>>& registry() {
+            static std::map<std::string, std::weak_ptr<MemoryMirror>> mirrors;
+            return mirrors;
+        }
+
+        /**
+         * @brief Gera um nome ainda não usado no processo; exige registryMutex()
+         */
+        static std::string nextName() {
+            static unsigned long counter = 0;
+            return "/frankenstein-mirror-" + std::to_string(++counter);
+        }
+
+        /**
+         * @brief Abre uma conexão com uma cópia
+         * @param name Nome da cópia no VFS memdb
+         * @param flags Modo de abertura
+         */
+        static std::unique_ptr<SQLite::Database> open(const std::string& name, int flags) {
+            return std::make_unique<SQLite::Database>(name, flags, 0, "memdb");
+        }
+
+        MemoryMirror(std::string name,
+                     std::shared_ptr<SQLite::Database> disk,
+                     std::shared_ptr<SQLite::Database> memory,
+                     std::chrono::milliseconds interval)
+            : _name(std::move(name)),
+              _disk(disk),
+              _memory(memory),
+              _source(open(_name, SQLite::OPEN_READONLY)),
+              _interval(interval),
+              _flushed_version(dataVersion()),
+              _disk_version(diskVersion()),
+              _diverged(false),
+              _stopping(false) {
+            if (_interval.count() > 0)
+                _worker = std::thread(&MemoryMirror::run, this);
+        }
+
+        ~MemoryMirror() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wake.notify_one();
+            if (_worker.joinable())
+                _worker.join();
+
+            std::lock_guard<std::mutex> registry_lock(registryMutex());
+            if (_diverged)
+                return;
+            try {
+                flush();
+            } catch (const std::exception& e) {
+                std::cerr << "Erro ao gravar a cópia em memória do banco: "
+                          << e.what() << std::endl;
+            }
+        }
+
+        SQLite::Database& memory() { return *_memory; }
+
+        const std::string& name() const { return _name; }
+
+        /**
+         * @brief Versão dos dados vista por _source
+         *
+         * Muda a cada transação confirmada por outra conexão, inclusive as
+         * alterações feitas por gatilhos.
+         */
+        int dataVersion() {
+            return _source->execAndGet("PRAGMA data_version;").getInt();
+        }
+
+        /**
+         * @brief Versão dos dados do arquivo vista por _disk
+         *
+         * Só muda quando outra conexão, deste ou de outro processo, confirma
+         * uma transação no arquivo.
+         */
+        int diskVersion() {
+            return _disk->execAndGet("PRAGMA data_version;").getInt();
+        }
+
+        /**
+         * @brief Registra uma conexão de escrita aberta para a cópia
+         *
+         * A conexão passa a aceitar só leituras se a cópia já divergiu do
+         * arquivo ou quando divergir.
+         */
+        void addWriter(const std::shared_ptr<SQLite::Database>& db) {
+            std::lock_guard<std::mutex> lock(_flush_mutex);
+            if (_diverged) {
+                db->exec("PRAGMA query_only = ON;");
+                return;
+            }
+
+            _writers.erase(std::remove_if(_writers.begin(), _writers.end(),
+                                          [](const std::weak_ptr<SQLite::Database>& writer) {
+                                              return writer.expired();
+                                          }),
+                           _writers.end());
+            _writers.push_back(db);
+        }
+
+        /**
+         * @brief Copia a cópia em memória para o arquivo, se houver alterações
+         * @return false se uma transação aberta adiou a gravação
+         * @throws std::runtime_error se o arquivo foi alterado por outra
+         *         conexão; a cópia passa a aceitar só leituras
+         */
+        bool flush() {
+            std::lock_guard<std::mutex> lock(_flush_mutex);
+
+            try {
+                if (_diverged)
+                    throw std::runtime_error(DIVERGED_MESSAGE);
+
+                int version = dataVersion();
+                if (version == _flushed_version)
+                    return true;
+
+                if (diskVersion() != _disk_version) {
+                    _diverged = true;
+                    // Executado por esta thread em conexões de outras; o
+                    // SQLite serializa as chamadas em cada conexão
+                    _memory->exec("PRAGMA query_only = ON;");
+                    for (auto& writer : _writers)
+                        if (auto db = writer.lock())
+                            db->exec("PRAGMA query_only = ON;");
+                    _writers.clear();
+                    throw std::runtime_error(DIVERGED_MESSAGE);
+                }
+
+                SQLite::Backup backup(*_disk, *_source);
+                if (backup.executeStep() != SQLITE_DONE)
+                    return false;
+
+                // Uma transação confirmada depois da leitura da versão só
+                // provoca uma gravação a mais
+                _flushed_version = version;
+                _disk_version = diskVersion();
+                return true;
+            } catch (const SQLite::Exception& e) {
+                if (e.getErrorCode() == SQLITE_BUSY || e.getErrorCode() == SQLITE_LOCKED)
+                    return false;
+                throw;
+            }
+        }
+    };
+
     DatabaseManager::DatabaseManager(std::string db_path,
-                                    std::string schema_path)
-        : _db_path(db_path), _schema_path(schema_path) {
+                                    std::string schema_path,
+                                    DatabaseSettings settings)
+        : _db_path(db_path),
+          _schema_path(schema_path),
+          _settings(std::move(settings)),
+          _readers(std::make_shared<ReaderPool>()) {
+        // URI habilitado para o VACUUM INTO que cria o espelho em memória
         _db = std::make_shared<SQLite::Database>(
             _db_path,
-            SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+            SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE | SQLite::OPEN_URI);
+
+        IdentityMapCapacity::set(_db, _settings.identity_map_entries);
 
         SQLite::Statement query(*_db, "PRAGMA foreign_keys = ON;");
         query.exec();
 
-        std::filesystem::path schema_file(_schema_path);
-        if (std::filesystem::exists(schema_file)) {
-            std::ifstream file(_schema_path);
-            if (!file)
-                throw std::runtime_error("Failed to open schema file");
+        const std::string& sync = _settings.synchronous;
+        if (sync != "OFF" && sync != "NORMAL" && sync != "FULL"
+            && sync != "EXTRA")
+            throw std::runtime_error("Invalid synchronous mode: " + sync);
 
-            std::stringstream buffer;
-            buffer << file.rdbuf();
-            std::string schema_sql = buffer.str();
+        if (_settings.wal && !isInMemory())
+            _db->exec("PRAGMA journal_mode = WAL;");
+        _db->exec("PRAGMA synchronous = " + _settings.synchronous + ";");
+        configureConnection(*_db);
 
-            _db->exec(schema_sql);
-        } else {
-            throw std::runtime_error("Schema file not found");
+        if (_settings.profile) {
+            auto& profiler = QueryProfiler::instance();
+            profiler.setSlowThreshold(
+                std::chrono::milliseconds(_settings.slow_query_ms));
+            profiler.setSlowQueryLog(_settings.slow_query_log);
+            profiler.attach(*_db);
+        }
+
+        SchemaMigrations::migrate(*_db);
+
+        if (_settings.memory_mirror && !isInMemory()) {
+            std::lock_guard<std::mutex> lock(MemoryMirror::registryMutex());
+            auto& mirrors = MemoryMirror::registry();
+            for (auto it = mirrors.begin(); it != mirrors.end();) {
+                if (it->second.expired())
+                    it = mirrors.erase(it);
+                else
+                    ++it;
+            }
+
+            auto& shared = mirrors[_db_path];
+            _mirror = shared.lock();
+
+            if (!_mirror) {
+                std::string name = MemoryMirror::nextName();
+                std::shared_ptr<SQLite::Database> memory = MemoryMirror::open(
+                    name, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+                // Um backup copiaria o cabeçalho do modo WAL, que o memdb
+                // não abre; VACUUM INTO grava a cópia em modo rollback
+                _db->exec("VACUUM INTO 'file:" + name + "?vfs=memdb';");
+                memory->exec("PRAGMA foreign_keys = ON;");
+                configureConnection(*memory);
+                IdentityMapCapacity::set(memory, _settings.identity_map_entries);
+                if (_settings.profile)
+                    QueryProfiler::instance().attach(*memory);
+
+                _mirror = std::make_shared<MemoryMirror>(
+                    name, _db, memory, std::chrono::milliseconds(_settings.mirror_flush_ms));
+                shared = _mirror;
+            }
+
+            // Conexões entregues mantêm a cópia viva após o gerenciador
+            _db = std::shared_ptr<SQLite::Database>(_mirror, &_mirror->memory());
         }
     }
 
     DatabaseManager::~DatabaseManager() {}
 
+    void DatabaseManager::configureConnection(SQLite::Database& db) const {
+        db.setBusyTimeout(_settings.busy_timeout_ms);
+        db.exec("PRAGMA cache_size = " + std::to_string(_settings.cache_size) + ";");
+        db.exec("PRAGMA mmap_size = " + std::to_string(_settings.mmap_size) + ";");
+    }
+
+    std::unique_ptr<SQLite::Database> DatabaseManager::openReader() const {
+        auto reader = _mirror
+                          ? MemoryMirror::open(_mirror->name(), SQLite::OPEN_READONLY)
+                          : std::make_unique<SQLite::Database>(_db_path,
+                                                               SQLite::OPEN_READONLY);
+        configureConnection(*reader);
+        reader->exec("PRAGMA query_only = ON;");
+        if (_settings.profile)
+            QueryProfiler::instance().attach(*reader);
+        return reader;
+    }
+
+    bool DatabaseManager::isInMemory() const {
+        return _db_path.empty() || _db_path == ":memory:"
+               || _db_path.rfind("file::memory:", 0) == 0;
+    }
+
     std::shared_ptr<SQLite::Database> DatabaseManager::getDatabase() {
         return _db;
     }
 
+    std::shared_ptr<SQLite::Database> DatabaseManager::openConnection() {
+        // O banco só existe nesta conexão
+        if (isInMemory() || !_db)
+            return _db;
+
+        std::shared_ptr<SQLite::Database> db;
+        if (_mirror) {
+            // A conexão mantém a cópia viva, como as devolvidas por getDatabase()
+            auto mirror = _mirror;
+            db = std::shared_ptr<SQLite::Database>(
+                MemoryMirror::open(mirror->name(), SQLite::OPEN_READWRITE).release(),
+                [mirror](SQLite::Database* connection) { delete connection; });
+            mirror->addWriter(db);
+        } else {
+            db = std::make_shared<SQLite::Database>(_db_path, SQLite::OPEN_READWRITE);
+            db->exec("PRAGMA synchronous = " + _settings.synchronous + ";");
+        }
+
+        db->exec("PRAGMA foreign_keys = ON;");
+        configureConnection(*db);
+        IdentityMapCapacity::set(db, _settings.identity_map_entries);
+        if (_settings.profile)
+            QueryProfiler::instance().attach(*db);
+        return db;
+    }
+
+    std::shared_ptr<SQLite::Database> DatabaseManager::getReader() {
+        // O banco só existe na conexão de escrita
+        if (!_readers || isInMemory() || !_db)
+            return _db;
+
+        std::unique_ptr<SQLite::Database> reader;
+        {
+            std::lock_guard<std::mutex> lock(_readers->mutex);
+            if (!_readers->idle.empty()) {
+                reader = std::move(_readers->idle.back());
+                _readers->idle.pop_back();
+            }
+        }
+
+        if (!reader)
+            reader = openReader();
+
+        auto pool = _readers;
+        size_t pool_size = _settings.reader_pool_size;
+        std::shared_ptr<SQLite::Database> db(
+            reader.release(), [pool, pool_size](SQLite::Database* db) {
+                std::unique_ptr<SQLite::Database> released(db);
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                if (pool->idle.size() < pool_size)
+                    pool->idle.push_back(std::move(released));
+            });
+        // Registrada a cada entrega: o registro acompanha este ponteiro
+        IdentityMapCapacity::set(db, _settings.identity_map_entries);
+        return db;
+    }
+
+    bool DatabaseManager::flushMirror() {
+        if (!_mirror)
+            return true;
+        return _mirror->flush();
+    }
+
+    bool DatabaseManager::isMirrored() const {
+        return _mirror != nullptr;
+    }
+
+    int DatabaseManager::getSchemaVersion() const {
+        return SchemaMigrations::currentVersion(*_db);
+    }
+
     std::string DatabaseManager::getDatabasePath() const {
         return _db_path;
     }
+
+    const DatabaseSettings& DatabaseManager::getSettings() const {
+        return _settings;
+    }
 }  // namespace core
@@ -9,70 +9,75 @@
 
 
 #include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/ListeningStats.hpp"
 #include "core/bd/UserRepository.hpp"
 #include "core/bd/SongRepository.hpp"
 #include "core/entities/User.hpp"
 
 
 namespace core {
+    using HistoryColumns = EntityTraits<HistoryPlayback>;
+
     HistoryPlaybackRepository::HistoryPlaybackRepository()
-        : SQLiteRepositoryBase<HistoryPlayback>(
-              nullptr,
-              "playback_history") {}
+        : SQLiteRepositoryBase<HistoryPlayback>(nullptr),
+          _user_repo(std::make_shared<UserRepository>(nullptr)) {}
 
     HistoryPlaybackRepository::HistoryPlaybackRepository(
         std::shared_ptr<SQLite::Database> db)
-        : SQLiteRepositoryBase<HistoryPlayback>(
-              db,
-              "playback_history") {}
+        : SQLiteRepositoryBase<HistoryPlayback>(db),
+          _user_repo(std::make_shared<UserRepository>(db)) {}
 
     bool HistoryPlaybackRepository::insert(HistoryPlayback& entity) {
-        std::string sql =
-            "INSERT INTO " + _table_name +
-            " (user_id, song_id, played_at) "
-            "VALUES (?, ?, ?);";
+        static constexpr SqlText sql = HistoryColumns::insert();
+
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(entity.getUser()->getId()));
+        query->bind(2, static_cast<int>(entity.getSong()->getId()));
+        query->bind(3, entity.getPlayedAt());
+        query->bind(4, entity.getPlayDuration());
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(entity.getUser()->getId()));
-        query.bind(2, static_cast<int>(entity.getSong()->getId()));
-        query.bind(3, entity.getPlayedAt());
+        bool success = query->exec() > 0;
+        if (success)
+            entity.setId(static_cast<unsigned>(getLastInsertId()));
 
-        return query.exec() > 0;
+        return success;
     }
 
     bool HistoryPlaybackRepository::update(const HistoryPlayback& entity) {
-        std::string sql =
-            "UPDATE " + _table_name +
-            " SET user_id = ?, song_id = ?, played_at = ? "
-            "WHERE id = ?;";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(entity.getUser()->getId()));
-        query.bind(2, static_cast<int>(entity.getSong()->getId()));
-        query.bind(3, entity.getPlayedAt());
-        query.bind(4, static_cast<int>(entity.getId()));
-
-        return query.exec() > 0;
+        static constexpr SqlText sql = HistoryColumns::update();
+
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(entity.getUser()->getId()));
+        query->bind(2, static_cast<int>(entity.getSong()->getId()));
+        query->bind(3, entity.getPlayedAt());
+        query->bind(4, entity.getPlayDuration());
+        query->bind(5, static_cast<int>(entity.getId()));
+
+        return query->exec() > 0;
     }
 
     std::shared_ptr<HistoryPlayback>
     HistoryPlaybackRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = static_cast<unsigned>(query.getColumn("id").getInt());
-        unsigned user_id = static_cast<unsigned>(query.getColumn("user_id").getInt());
-        unsigned song_id = static_cast<unsigned>(query.getColumn("song_id").getInt());
-        std::time_t played_at = query.getColumn("played_at").getInt64();
+        unsigned id = HistoryColumns::read<HistoryColumns::Id>(query);
+        unsigned user_id = HistoryColumns::read<HistoryColumns::UserId>(query);
+        unsigned song_id = HistoryColumns::read<HistoryColumns::SongId>(query);
+        std::time_t played_at = HistoryColumns::read<HistoryColumns::PlayedAt>(query);
+        unsigned play_duration =
+            HistoryColumns::read<HistoryColumns::PlayDuration>(query);
 
-        auto user_repo = UserRepository(_db);
-        auto user = user_repo.findById(user_id);
+        auto user = _user_repo->findSharedById(user_id);
 
         auto song_repo = SongRepository(_db);
         auto song = song_repo.findById(song_id);
 
-        return std::make_shared<HistoryPlayback>(
+        auto history = std::make_shared<HistoryPlayback>(
             id,
-            *user,
+            user,
             *song,
             played_at);
+        history->setPlayDuration(play_duration);
+
+        return history;
     }
 
     bool HistoryPlaybackRepository::save(HistoryPlayback& entity) {
@@ -85,16 +90,15 @@ namespace core {
     std::vector<std::shared_ptr<HistoryPlayback>>
     HistoryPlaybackRepository::findByUser(const User& user) const {
         std::vector<std::shared_ptr<HistoryPlayback>> results;
-        std::string sql =
-            "SELECT * FROM " + _table_name +
-            " WHERE user_id = ? "
-            "ORDER BY played_at DESC;";
+        static constexpr SqlText sql = HistoryColumns::select()
+                                       + " WHERE user_id = ? "
+                                         "ORDER BY played_at DESC;";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(user.getId()));
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(user.getId()));
 
-        while (query.executeStep())
-            results.push_back(this->mapRowToEntity(query));
+        while (query->executeStep())
+            results.push_back(this->mapRowToEntity(*query));
 
         return results;
     }
@@ -105,42 +109,14 @@ namespace core {
 
     bool HistoryPlaybackRepository::insertMultipleHistoryPlaybacks(
         std::vector<HistoryPlayback>& entities) {
-        bool all_inserted = true;
-        for (auto& entity : entities) {
-            if (!insert(entity))
-                all_inserted = false;
-        }
-        return all_inserted;
+        return insertMany(entities);
     }
 
     unsigned HistoryPlaybackRepository::countPlaybacksBySongAndUser(const Song& song) const {
-        std::string sql =
-            "SELECT COUNT(1) FROM " + _table_name +
-            " WHERE song_id = ? AND user_id = ?;" +
-            " ORDER BY played_at DESC;";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(song.getId()));
-        query.bind(2, static_cast<int>(song.getUser()->getId()));
-
-        if (query.executeStep())
-            return static_cast<unsigned>(query.getColumn(0).getInt());
-
-        return 0;
+        return countPlaybacksBySongAndUser(song, *song.getUser());
     }
 
     unsigned HistoryPlaybackRepository::countPlaybacksBySongAndUser(const Song& song, const User& user) const {
-        std::string sql =
-            "SELECT COUNT(1) FROM " + _table_name +
-            " WHERE song_id = ? AND user_id = ?;";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(song.getId()));
-        query.bind(2, static_cast<int>(user.getId()));
-
-        if (query.executeStep())
-            return static_cast<unsigned>(query.getColumn(0).getInt());
-
-        return 0;
+        return ListeningStats(_db).playCount(user.getId(), song.getId());
     }
 }  // namespace core
@@ -0,0 +1,134 @@
+/**
+ * @file ListeningStats.cpp
+ * @brief Implementação das consultas de estatísticas de reprodução
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-25
+ */
+
+#include "core/bd/ListeningStats.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace core {
+    namespace {
+        /**
+         * @brief Converte um instante no número do dia UTC correspondente
+         */
+        int64_t dayNumber(std::time_t time) {
+            int64_t seconds = static_cast<int64_t>(time);
+            int64_t day = seconds / STATS_SECONDS_PER_DAY;
+            if (seconds % STATS_SECONDS_PER_DAY < 0)
+                day--;
+            return day;
+        }
+    }  // namespace
+
+    ListeningStats::ListeningStats(std::shared_ptr<SQLite::Database> db)
+        : _statements(StatementCache::forDatabase(db)) {}
+
+    unsigned ListeningStats::playCount(unsigned user_id, unsigned song_id) const {
+        if (!_statements)
+            return 0;
+
+        auto statement = _statements->acquire(
+            "SELECT play_count FROM play_stats_song "
+            "WHERE user_id = ? AND song_id = ?;");
+        statement->bind(1, user_id);
+        statement->bind(2, song_id);
+
+        if (statement->executeStep())
+            return static_cast<unsigned>(statement->getColumn(0).getInt());
+
+        return 0;
+    }
+
+    std::vector<ListeningStats::Entry>
+    ListeningStats::top(const char* table,
+                        const char* id_column,
+                        unsigned user_id,
+                        size_t limit) const {
+        std::vector<Entry> entries;
+        if (!_statements || limit == 0)
+            return entries;
+
+        auto statement = _statements->acquire(
+            std::string("SELECT ") + id_column + ", play_count, listen_seconds "
+            "FROM " + table + " WHERE user_id = ? "
+            "ORDER BY play_count DESC LIMIT ?;");
+        statement->bind(1, user_id);
+        statement->bind(2, static_cast<int64_t>(limit));
+
+        while (statement->executeStep()) {
+            entries.push_back(Entry {
+                static_cast<unsigned>(statement->getColumn(0).getInt()),
+                static_cast<unsigned>(statement->getColumn(1).getInt()),
+                static_cast<unsigned long long>(statement->getColumn(2).getInt64())});
+        }
+
+        return entries;
+    }
+
+    std::vector<ListeningStats::Entry>
+    ListeningStats::topSongs(unsigned user_id, size_t limit) const {
+        return top("play_stats_song", "song_id", user_id, limit);
+    }
+
+    std::vector<ListeningStats::Entry>
+    ListeningStats::topArtists(unsigned user_id, size_t limit) const {
+        return top("play_stats_artist", "artist_id", user_id, limit);
+    }
+
+    std::vector<ListeningStats::Entry>
+    ListeningStats::topAlbums(unsigned user_id, size_t limit) const {
+        return top("play_stats_album", "album_id", user_id, limit);
+    }
+
+    std::vector<ListeningStats::DayTotal>
+    ListeningStats::listeningByDay(unsigned user_id,
+                                   std::time_t from,
+                                   std::time_t to) const {
+        std::vector<DayTotal> days;
+        if (!_statements || to <= from)
+            return days;
+
+        auto statement = _statements->acquire(
+            "SELECT day, play_count, listen_seconds FROM play_stats_day "
+            "WHERE user_id = ? AND day BETWEEN ? AND ? "
+            "ORDER BY day;");
+        statement->bind(1, user_id);
+        statement->bind(2, dayNumber(from));
+        statement->bind(3, dayNumber(to - 1));
+
+        while (statement->executeStep()) {
+            days.push_back(DayTotal {
+                static_cast<std::time_t>(statement->getColumn(0).getInt64()
+                                         * STATS_SECONDS_PER_DAY),
+                static_cast<unsigned>(statement->getColumn(1).getInt()),
+                static_cast<unsigned long long>(statement->getColumn(2).getInt64())});
+        }
+
+        return days;
+    }
+
+    unsigned long long ListeningStats::listeningTime(unsigned user_id,
+                                                     std::time_t from,
+                                                     std::time_t to) const {
+        if (!_statements || to <= from)
+            return 0;
+
+        auto statement = _statements->acquire(
+            "SELECT COALESCE(SUM(listen_seconds), 0) FROM play_stats_day "
+            "WHERE user_id = ? AND day BETWEEN ? AND ?;");
+        statement->bind(1, user_id);
+        statement->bind(2, dayNumber(from));
+        statement->bind(3, dayNumber(to - 1));
+
+        if (statement->executeStep())
+            return static_cast<unsigned long long>(statement->getColumn(0).getInt64());
+
+        return 0;
+    }
+}  // namespace core
@@ -9,76 +9,240 @@
 
 #include "core/bd/PlaylistRepository.hpp"
 #include "core/bd/UserRepository.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace core {
+    namespace {
+        using PlaylistColumns = EntityTraits<Playlist>;
+
+        /**
+         * @brief Marca as músicas que podem manter a posição gravada
+         *
+         * Escolhe a maior subsequência estritamente crescente das posições
+         * gravadas, na ordem atual da playlist, em O(n log n).
+         *
+         * @param stored Posição gravada de cada música, vazia se for nova
+         * @return true nas músicas que não precisam ser regravadas
+         */
+        std::vector<bool>
+        stationarySongs(const std::vector<std::optional<int64_t>>& stored) {
+            const size_t none = stored.size();
+            std::vector<size_t> tails;  // menor final de cada comprimento
+            std::vector<size_t> previous(stored.size(), none);
+
+            for (size_t i = 0; i < stored.size(); ++i) {
+                if (!stored[i])
+                    continue;
+
+                auto tail = std::lower_bound(
+                    tails.begin(), tails.end(), *stored[i],
+                    [&stored](size_t index, int64_t position) {
+                        return *stored[index] < position;
+                    });
+                if (tail != tails.begin())
+                    previous[i] = *(tail - 1);
+                if (tail == tails.end())
+                    tails.push_back(i);
+                else
+                    *tail = i;
+            }
+
+            std::vector<bool> stationary(stored.size(), false);
+            if (!tails.empty())
+                for (size_t i = tails.back(); i != none; i = previous[i])
+                    stationary[i] = true;
+
+            return stationary;
+        }
+
+        /**
+         * @brief Calcula a posição de cada música na ordem atual
+         *
+         * As músicas fora da subsequência estável recebem posições
+         * espaçadas entre as das vizinhas estáveis; se não houver espaço,
+         * todas as músicas são renumeradas com PLAYLIST_POSITION_GAP.
+         *
+         * @param stored Posição gravada de cada música, vazia se for nova
+         * @return Posição desejada de cada música
+         */
+        std::vector<int64_t>
+        targetPositions(const std::vector<std::optional<int64_t>>& stored) {
+            const size_t size = stored.size();
+            auto stationary = stationarySongs(stored);
+
+            std::vector<int64_t> target(size);
+            auto renumber = [&target]() {
+                for (size_t i = 0; i < target.size(); ++i)
+                    target[i] = static_cast<int64_t>(i + 1) * PLAYLIST_POSITION_GAP;
+                return target;
+            };
+
+            for (size_t i = 0; i < size;) {
+                if (stationary[i]) {
+                    target[i] = *stored[i];
+                    ++i;
+                    continue;
+                }
+
+                size_t end = i;
+                while (end < size && !stationary[end])
+                    ++end;
+
+                auto count = static_cast<int64_t>(end - i);
+                if (i == 0 && end == size)
+                    return renumber();
+
+                for (int64_t k = 0; k < count; ++k) {
+                    if (i == 0) {
+                        target[i + k] = *stored[end] - (count - k) * PLAYLIST_POSITION_GAP;
+                    } else if (end == size) {
+                        target[i + k] = target[i - 1] + (k + 1) * PLAYLIST_POSITION_GAP;
+                    } else {
+                        int64_t step = (*stored[end] - target[i - 1]) / (count + 1);
+                        if (step == 0)
+                            return renumber();
+                        target[i + k] = target[i - 1] + (k + 1) * step;
+                    }
+                }
+
+                i = end;
+            }
+
+            return target;
+        }
+    }  // namespace
+
     PlaylistRepository::PlaylistRepository(std::shared_ptr<SQLite::Database> db)
-        : SQLiteRepositoryBase<Playlist>(db, "playlists") {}
+        : SQLiteRepositoryBase<Playlist>(db),
+          _user_repo(std::make_shared<UserRepository>(db)) {}
 
     bool PlaylistRepository::insert(Playlist& entity) {
-        SQLite::Statement query(*_db,
-                                "INSERT INTO playlists (title, user_id) "
-                                "VALUES (?, ?);");
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getUser()->getId());
-
-        if (!query.exec())
-            return false;
-
-        entity.setId(static_cast<unsigned>(getLastInsertId()));
-
-        size_t size = entity.getSongsCount();
-        for (size_t i {0}; i < size; ++i) {
-            const auto& song =
-                *std::dynamic_pointer_cast<Song>(entity.getSongAt(i));
-            if (!addSongToPlaylist(entity, i, song))
+        // A playlist e todas as suas músicas são gravadas em uma transação
+        bool success = runInTransaction([this, &entity]() {
+            static constexpr SqlText sql = PlaylistColumns::insert();
+            auto query = prepare(sql);
+            query->bind(1, entity.getTitle());
+            query->bind(2, entity.getUser()->getId());
+
+            if (!query->exec())
                 return false;
-        }
 
-        return true;
+            entity.setId(static_cast<unsigned>(getLastInsertId()));
+
+            int64_t position = 0;
+            std::unordered_set<unsigned> seen;
+            for (const auto& song : entity.getSongs()) {
+                if (!song || !seen.insert(song->getId()).second)
+                    continue;
+                position += PLAYLIST_POSITION_GAP;
+                if (!addSongToPlaylist(entity, position, song->getId()))
+                    return false;
+            }
+
+            return true;
+        });
+
+        if (!success)
+            entity.setId(0);
+        else
+            entity.clearSongChanges();
+
+        return success;
     }
 
     bool PlaylistRepository::addSongToPlaylist(const Playlist& playlist,
-                                               size_t pos,
-                                               const Song& song) {
-        SQLite::Statement query(*_db,
-                                "INSERT INTO playlist_songs (playlist_id, "
-                                "song_id, position) "
-                                "VALUES (?, ?, ?);");
-        query.bind(1, playlist.getId());
-        query.bind(2, song.getId());
-        query.bind(3, static_cast<unsigned>(pos));
-
-        return query.exec() > 0;
+                                               int64_t position,
+                                               unsigned song_id) {
+        auto query = prepare("INSERT INTO playlist_songs (playlist_id, "
+                             "song_id, position) "
+                             "VALUES (?, ?, ?);");
+        query->bind(1, playlist.getId());
+        query->bind(2, song_id);
+        query->bind(3, position);
+
+        return query->exec() > 0;
     }
 
     bool PlaylistRepository::update(const Playlist& entity) {
-        SQLite::Statement query(*_db,
-                                "UPDATE playlists SET title = ?, user_id = ? "
-                                "WHERE id = ?;");
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getUser()->getId());
-        query.bind(3, entity.getId());
-
-        if (!query.exec())
-            return false;
-
-        SQLite::Statement deleteQuery(*_db,
-                                      "DELETE FROM playlist_songs WHERE "
-                                      "playlist_id = ?;");
-        deleteQuery.bind(1, entity.getId());
-
-        if (!deleteQuery.exec())
-            return false;
-
-
-        size_t size = entity.getSongsCount();
-        auto songs = entity.getSongs();
-        for (size_t i {0}; i < size; ++i) {
-            const auto& song =
-                *std::dynamic_pointer_cast<Song>(songs[i]);
-            if (!addSongToPlaylist(entity, i, song))
+        bool success = runInTransaction([this, &entity]() {
+            static constexpr SqlText sql = PlaylistColumns::update();
+            auto query = prepare(sql);
+            query->bind(1, entity.getTitle());
+            query->bind(2, entity.getUser()->getId());
+            query->bind(3, entity.getId());
+
+            if (!query->exec())
+                return false;
+
+            // Músicas não carregadas ou não alteradas não são regravadas
+            return !entity.hasSongChanges() || saveSongChanges(entity);
+        });
+
+        if (success)
+            entity.clearSongChanges();
+
+        return success;
+    }
+
+    bool PlaylistRepository::saveSongChanges(const Playlist& playlist) {
+        std::unordered_map<unsigned, int64_t> stored;
+        auto storedQuery = prepare("SELECT song_id, position FROM playlist_songs "
+                                   "WHERE playlist_id = ?;");
+        storedQuery->bind(1, playlist.getId());
+        while (storedQuery->executeStep())
+            stored[storedQuery->getColumn(0).getUInt()] =
+                storedQuery->getColumn(1).getInt64();
+
+        std::vector<unsigned> ids;
+        std::vector<std::optional<int64_t>> positions;
+        std::unordered_set<unsigned> seen;
+        for (const auto& song : playlist.getSongs()) {
+            if (!song || !seen.insert(song->getId()).second)
+                continue;
+
+            ids.push_back(song->getId());
+            auto found = stored.find(song->getId());
+            if (found == stored.end())
+                positions.push_back(std::nullopt);
+            else
+                positions.push_back(found->second);
+        }
+
+        for (const auto& [song_id, position] : stored) {
+            if (seen.count(song_id))
+                continue;
+
+            auto removeQuery = prepare("DELETE FROM playlist_songs WHERE "
+                                       "playlist_id = ? AND song_id = ?;");
+            removeQuery->bind(1, playlist.getId());
+            removeQuery->bind(2, song_id);
+            if (!removeQuery->exec())
+                return false;
+        }
+
+        auto target = targetPositions(positions);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (!positions[i]) {
+                if (!addSongToPlaylist(playlist, target[i], ids[i]))
+                    return false;
+                continue;
+            }
+
+            if (*positions[i] == target[i])
+                continue;
+
+            auto moveQuery = prepare("UPDATE playlist_songs SET position = ? "
+                                     "WHERE playlist_id = ? AND song_id = ?;");
+            moveQuery->bind(1, target[i]);
+            moveQuery->bind(2, playlist.getId());
+            moveQuery->bind(3, ids[i]);
+            if (!moveQuery->exec())
                 return false;
         }
 
@@ -87,15 +251,13 @@ namespace core {
 
     std::shared_ptr<Playlist>
     PlaylistRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = query.getColumn("id").getUInt();
-        std::string title = query.getColumn("title").getString();
-        unsigned user_id = query.getColumn("user_id").getUInt();
+        unsigned id = PlaylistColumns::read<PlaylistColumns::Id>(query);
+        std::string title = PlaylistColumns::read<PlaylistColumns::Title>(query);
+        unsigned user_id = PlaylistColumns::read<PlaylistColumns::UserId>(query);
         Playlist playlist(id, title);
 
-        std::shared_ptr<UserRepository> userRepo =
-            std::make_shared<UserRepository>(_db);
-        std::shared_ptr<User> user = userRepo->findById(user_id);
-        playlist.setUser(*user);
+        std::shared_ptr<const User> user = _user_repo->findSharedById(user_id);
+        playlist.setUser(user);
 
         auto playlistPtr = std::make_shared<Playlist>(playlist);
         playlist.setSongsLoader(
@@ -109,51 +271,72 @@ namespace core {
     std::vector<std::shared_ptr<Playlist>>
     PlaylistRepository::findByTitleAndUser(const std::string& title,
                                            const User& user) const {
-        SQLite::Statement query(
-            *_db,
-            "SELECT * FROM playlists WHERE title LIKE ? AND user_id = ?;");
-        query.bind(1, "%" + title + "%");
-        query.bind(2, user.getId());
+        static constexpr SqlText sql = PlaylistColumns::select()
+                                       + " WHERE title LIKE ? AND user_id = ?;";
+        auto query = prepare(sql);
+        query->bind(1, "%" + title + "%");
+        query->bind(2, user.getId());
 
         std::vector<std::shared_ptr<Playlist>> playlists;
-        while (query.executeStep()) {
-            playlists.push_back(mapRowToEntity(query));
+        while (query->executeStep()) {
+            playlists.push_back(mapRowToEntity(*query));
         }
         return playlists;
     }
 
     std::vector<std::shared_ptr<Playlist>>
     PlaylistRepository::findByUser(const User& user) const {
-        SQLite::Statement query(*_db,
-                                "SELECT * FROM playlists WHERE user_id = ?;");
-        query.bind(1, user.getId());
+        static constexpr SqlText sql = PlaylistColumns::select()
+                                       + " WHERE user_id = ?;";
+        auto query = prepare(sql);
+        query->bind(1, user.getId());
 
         std::vector<std::shared_ptr<Playlist>> playlists;
-        while (query.executeStep()) {
-            playlists.push_back(mapRowToEntity(query));
+        while (query->executeStep()) {
+            playlists.push_back(mapRowToEntity(*query));
         }
         return playlists;
     }
 
     std::vector<std::shared_ptr<Song>>
     PlaylistRepository::getSongs(const Playlist& playlist) const {
-        SQLite::Statement query(*_db,
-                                "SELECT s.* FROM songs s "
-                                "JOIN playlist_songs ps ON s.id = ps.song_id "
-                                "WHERE ps.playlist_id = ?;");
-        query.bind(1, playlist.getId());
+        using SongColumns = EntityTraits<Song>;
+        static constexpr SqlText sql =
+            SqlText("SELECT ") + SongColumns::columnList("s")
+            + " FROM songs s "
+              "JOIN playlist_songs ps ON s.id = ps.song_id "
+              "WHERE ps.playlist_id = ? "
+              "ORDER BY ps.position;";
+        auto query = prepare(sql);
+        query->bind(1, playlist.getId());
 
         std::vector<std::shared_ptr<Song>> songs;
-        while (query.executeStep()) {
-            unsigned song_id = query.getColumn("id").getUInt();
-            std::string title = query.getColumn("title").getString();
-            unsigned artist_id = query.getColumn("artist_id").getUInt();
+        while (query->executeStep()) {
+            unsigned song_id = SongColumns::read<SongColumns::Id>(*query);
+            std::string title = SongColumns::read<SongColumns::Title>(*query);
+            unsigned artist_id = SongColumns::read<SongColumns::ArtistId>(*query);
 
             Song song(song_id, title, artist_id);
-            song.setUser(*playlist.getUser());
+            song.setUser(playlist.getUser());
             songs.push_back(std::make_shared<Song>(song));
         }
 
         return songs;
     }
+
+    std::vector<std::shared_ptr<Playlist>>
+    PlaylistRepository::search(const std::string& query,
+                               const User& user,
+                               size_t limit) const {
+        if (SearchIndex::toMatchExpression(query).empty())
+            return findByTitleAndUser(query, user);
+
+        std::vector<unsigned> ids;
+        SearchIndex index(_db);
+        for (const auto& hit :
+             index.search(query, SearchIndex::Kind::Playlist, user.getId(), limit))
+            ids.push_back(hit.id);
+
+        return findByIds(ids);
+    }
 }  // namespace core
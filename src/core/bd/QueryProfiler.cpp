@@ -0,0 +1,288 @@
+/**
+ * @file QueryProfiler.cpp
+ * @brief Implementação da medição das consultas SQL
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#include "core/bd/QueryProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include <sqlite3.h>
+
+namespace core {
+    namespace {
+        /**
+         * @brief Limites superiores das faixas do histograma, em nanossegundos
+         */
+        const std::array<uint64_t, QUERY_PROFILER_BUCKETS - 1> BUCKET_LIMITS_NS = {
+            100000ULL,       // 100us
+            1000000ULL,      // 1ms
+            10000000ULL,     // 10ms
+            100000000ULL,    // 100ms
+            1000000000ULL};  // 1s
+
+        size_t bucketOf(uint64_t elapsed_ns) {
+            size_t bucket = 0;
+            while (bucket < BUCKET_LIMITS_NS.size()
+                   && elapsed_ns >= BUCKET_LIMITS_NS[bucket])
+                bucket++;
+            return bucket;
+        }
+
+        std::string formatMs(uint64_t ns) {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(2)
+                << static_cast<double>(ns) / 1000000.0 << " ms";
+            return out.str();
+        }
+
+        bool isExplain(const char* sql) {
+            while (*sql == ' ' || *sql == '\n' || *sql == '\t')
+                sql++;
+            return sqlite3_strnicmp(sql, "EXPLAIN", 7) == 0;
+        }
+    }  // namespace
+
+    QueryProfiler& QueryProfiler::instance() {
+        static QueryProfiler profiler;
+        return profiler;
+    }
+
+    void QueryProfiler::attach(SQLite::Database& db) {
+        _enabled.store(true, std::memory_order_relaxed);
+        sqlite3_trace_v2(db.getHandle(),
+                         SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW,
+                         &QueryProfiler::traceCallback,
+                         this);
+    }
+
+    int QueryProfiler::traceCallback(unsigned type, void* context, void* p, void* x) {
+        auto* profiler = static_cast<QueryProfiler*>(context);
+        auto* statement = static_cast<sqlite3_stmt*>(p);
+
+        if (type == SQLITE_TRACE_ROW)
+            profiler->onRow(statement);
+        else if (type == SQLITE_TRACE_PROFILE)
+            profiler->onProfile(statement, *static_cast<sqlite3_int64*>(x));
+
+        return 0;
+    }
+
+    void QueryProfiler::onRow(sqlite3_stmt* statement) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rows[statement]++;
+    }
+
+    void QueryProfiler::onProfile(sqlite3_stmt* statement, int64_t elapsed_ns) {
+        const char* sql = sqlite3_sql(statement);
+        if (!sql || isExplain(sql))
+            return;
+
+        uint64_t elapsed = elapsed_ns > 0 ? static_cast<uint64_t>(elapsed_ns) : 0;
+        uint64_t fullscan = static_cast<uint64_t>(
+            sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1));
+        bool slow = elapsed_ns >= _slow_ns.load();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        uint64_t rows = 0;
+        auto found = _rows.find(statement);
+        if (found != _rows.end()) {
+            rows = found->second;
+            _rows.erase(found);
+        }
+
+        auto& stats = _stats[sql];
+        if (stats.sql.empty())
+            stats.sql = sql;
+        stats.calls++;
+        stats.total_ns += elapsed;
+        stats.max_ns = std::max(stats.max_ns, elapsed);
+        stats.rows += rows;
+        stats.fullscan_steps += fullscan;
+        stats.histogram[bucketOf(elapsed)]++;
+
+        if (slow) {
+            stats.slow_calls++;
+            if (_pending.size() < QUERY_PROFILER_PENDING_MAX) {
+                _pending.push_back(SlowQuery {stats.sql, elapsed, rows, std::time(nullptr)});
+                _has_pending.store(true);
+            }
+        }
+    }
+
+    std::string QueryProfiler::explain(SQLite::Database& db, const std::string& sql) {
+        try {
+            SQLite::Statement query(db, "EXPLAIN QUERY PLAN " + sql);
+
+            std::map<int, int> depth;
+            std::ostringstream plan;
+            while (query.executeStep()) {
+                int id = query.getColumn(0).getInt();
+                int parent = query.getColumn(1).getInt();
+                auto it = depth.find(parent);
+                int level = it == depth.end() ? 0 : it->second + 1;
+                depth[id] = level;
+
+                plan << std::string(static_cast<size_t>(2 + level * 2), ' ')
+                     << query.getColumn(3).getString() << "\n";
+            }
+            return plan.str();
+        } catch (const std::exception&) {
+            // Declarações como PRAGMA e BEGIN não têm plano
+            return "";
+        }
+    }
+
+    void QueryProfiler::setSlowThreshold(std::chrono::milliseconds threshold) {
+        _slow_ns.store(static_cast<int64_t>(threshold.count()) * 1000000LL);
+    }
+
+    std::chrono::milliseconds QueryProfiler::getSlowThreshold() const {
+        return std::chrono::milliseconds(_slow_ns.load() / 1000000LL);
+    }
+
+    void QueryProfiler::setSlowQueryLog(const std::string& path) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _log_path = path;
+    }
+
+    void QueryProfiler::capturePending(SQLite::Database& db) {
+        if (!_has_pending.load())
+            return;
+
+        std::deque<SlowQuery> pending;
+        std::string log_path;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            pending.swap(_pending);
+            _has_pending.store(false);
+            log_path = _log_path;
+        }
+
+        std::ofstream log;
+        if (!log_path.empty())
+            log.open(log_path, std::ios::app);
+
+        for (const auto& slow : pending) {
+            std::string plan;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto found = _stats.find(slow.sql);
+                if (found != _stats.end())
+                    plan = found->second.plan;
+            }
+
+            // O plano é obtido uma vez por texto SQL
+            if (plan.empty()) {
+                plan = explain(db, slow.sql);
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto found = _stats.find(slow.sql);
+                if (found != _stats.end())
+                    found->second.plan = plan;
+            }
+
+            if (!log)
+                continue;
+
+            char when[32];
+            std::tm tm_at {};
+#ifdef _WIN32
+            localtime_s(&tm_at, &slow.at);
+#else
+            localtime_r(&slow.at, &tm_at);
+#endif
+            std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &tm_at);
+
+            log << "[" << when << "] " << formatMs(slow.elapsed_ns) << ", "
+                << slow.rows << " linhas\n"
+                << slow.sql << "\n"
+                << plan << "\n";
+        }
+    }
+
+    std::vector<QueryProfiler::SqlStats> QueryProfiler::snapshot() const {
+        std::vector<SqlStats> stats;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            stats.reserve(_stats.size());
+            for (const auto& entry : _stats)
+                stats.push_back(entry.second);
+        }
+
+        std::sort(stats.begin(), stats.end(),
+                  [](const SqlStats& a, const SqlStats& b) {
+                      return a.total_ns > b.total_ns;
+                  });
+        return stats;
+    }
+
+    std::string QueryProfiler::report(size_t limit) const {
+        auto stats = snapshot();
+        std::ostringstream out;
+
+        if (stats.empty()) {
+            out << "Nenhuma consulta registrada.\n";
+            return out.str();
+        }
+
+        uint64_t total_calls = 0;
+        uint64_t total_ns = 0;
+        for (const auto& s : stats) {
+            total_calls += s.calls;
+            total_ns += s.total_ns;
+        }
+
+        out << stats.size() << " consultas distintas, " << total_calls
+            << " execuções, " << formatMs(total_ns) << " no total.\n"
+            << "Limite para consulta lenta: " << getSlowThreshold().count()
+            << " ms\n";
+
+        size_t shown = std::min(limit, stats.size());
+        for (size_t i = 0; i < shown; ++i) {
+            const auto& s = stats[i];
+            out << "\n" << i + 1 << ". " << s.sql << "\n"
+                << "   execuções: " << s.calls
+                << "  total: " << formatMs(s.total_ns)
+                << "  média: " << formatMs(s.total_ns / s.calls)
+                << "  máximo: " << formatMs(s.max_ns)
+                << "  linhas: " << s.rows << "\n"
+                << "   histograma:";
+            for (size_t b = 0; b < s.histogram.size(); ++b)
+                out << " " << bucketLabel(b) << "=" << s.histogram[b];
+            out << "\n";
+
+            if (s.fullscan_steps > 0)
+                out << "   varredura completa: " << s.fullscan_steps
+                    << " passos (possível índice ausente)\n";
+            if (s.slow_calls > 0)
+                out << "   execuções lentas: " << s.slow_calls << "\n";
+            if (!s.plan.empty())
+                out << "   plano:\n" << s.plan;
+        }
+
+        return out.str();
+    }
+
+    void QueryProfiler::reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rows.clear();
+        _stats.clear();
+        _pending.clear();
+        _has_pending.store(false);
+    }
+
+    const char* QueryProfiler::bucketLabel(size_t bucket) {
+        static const char* labels[QUERY_PROFILER_BUCKETS] = {
+            "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"};
+        return bucket < QUERY_PROFILER_BUCKETS ? labels[bucket] : "";
+    }
+}  // namespace core
@@ -44,4 +44,20 @@ namespace core {
     std::unique_ptr<core::UserRepository> RepositoryFactory::createUserRepository() {
         return std::unique_ptr<core::UserRepository>(new core::UserRepository(_db));
     }
+
+    std::unique_ptr<core::SummaryRepository> RepositoryFactory::createSummaryRepository() {
+        return std::unique_ptr<core::SummaryRepository>(new core::SummaryRepository(_db));
+    }
+
+    std::unique_ptr<core::ScannedFileRepository> RepositoryFactory::createScannedFileRepository() {
+        return std::unique_ptr<core::ScannedFileRepository>(new core::ScannedFileRepository(_db));
+    }
+
+    std::unique_ptr<core::UnitOfWork> RepositoryFactory::createUnitOfWork() {
+        return std::unique_ptr<core::UnitOfWork>(new core::UnitOfWork(_db));
+    }
+
+    std::unique_ptr<core::DataLoader> RepositoryFactory::createDataLoader() {
+        return std::unique_ptr<core::DataLoader>(new core::DataLoader(_db));
+    }
 }
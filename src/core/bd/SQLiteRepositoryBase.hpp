@@ -11,33 +11,167 @@
 
 #pragma once
 
+#include "core/bd/EntityTraits.hpp"
+#include "core/bd/IdentityMap.hpp"
+#include "core/bd/StatementCache.hpp"
+#include "core/bd/UnitOfWork.hpp"
 #include "core/interfaces/IRepository.hpp"
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <functional>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 namespace core {
 
     /**
      * @brief Classe base para repositórios SQLite
      * @tparam T Tipo da entidade gerenciada
+     * @tparam Traits Descrição da tabela de T (ver EntityTraits)
      *
      * @details
      * Fornece funcionalidades comuns para repositórios que usam SQLite,
-     * mas não implementa a interface IRepository diretamente.
+     * mas não implementa a interface IRepository diretamente. O SQL das
+     * operações comuns é gerado a partir de Traits em tempo de compilação,
+     * e mapRowToEntity recebe as colunas na ordem de Traits::Column.
      */
-    template <typename T>
+    template <typename T, typename Traits = EntityTraits<T>>
     class SQLiteRepositoryBase : public IRepository<T> {
+    public:
+        /**
+         * @brief Função chamada para cada entidade lida por uma consulta
+         *
+         * Deve retornar true para continuar a leitura ou false para
+         * interrompê-la.
+         */
+        using RowCallback = std::function<bool(const std::shared_ptr<T>&)>;
+
     protected:
         std::shared_ptr<SQLite::Database> _db;
-        std::string _table_name;
+        std::shared_ptr<StatementCache> _statements; /*!< @brief Cache de declarações da conexão */
+        std::shared_ptr<IdentityMap<T>> _identity_map; /*!< @brief Entidades já carregadas, se habilitado */
+        std::string _table_name; /*!< @brief Nome da tabela, vindo de Traits::table */
+
+        /**
+         * @brief Passa a usar o mapa de identidade da conexão para T
+         *
+         * Repositórios que habilitam o mapa devem invalidar as entidades
+         * alteradas fora de save() e remove().
+         */
+        void enableIdentityMap();
+
+        /**
+         * @brief Esvazia o mapa de identidade se outra conexão alterou o banco
+         */
+        void syncIdentityMap() const;
+
+        /**
+         * @brief Esvazia outro mapa da conexão se outra conexão alterou o banco
+         * @tparam U Tipo das entidades do mapa
+         * @param map Mapa obtido por IdentityMap<U>::forDatabase() para _db
+         */
+        template <typename U>
+        void syncIdentityMap(IdentityMap<U>& map) const;
+
+        /**
+         * @brief Busca uma entidade no mapa de identidade
+         *
+         * Antes da busca, o mapa é sincronizado com syncIdentityMap(), que
+         * executa `PRAGMA data_version` na conexão.
+         *
+         * @param id ID da entidade
+         * @return Entidade em cache, ou nullptr se ausente ou mapa desabilitado
+         */
+        std::shared_ptr<T> findCached(unsigned id) const;
+
+        /**
+         * @brief Registra uma entidade recém-mapeada no mapa de identidade
+         * @param id ID da entidade
+         * @param entity Entidade mapeada
+         * @return Instância compartilhada que deve ser entregue ao chamador
+         */
+        std::shared_ptr<T> cache(unsigned id, std::shared_ptr<T> entity) const;
+
+        /**
+         * @brief Remove uma entidade do mapa de identidade
+         * @param id ID da entidade
+         */
+        void invalidate(unsigned id) const;
+
+        /**
+         * @brief Executa um bloco de escritas em uma única transação
+         *
+         * Se a conexão já estiver dentro de uma transação, como uma
+         * UnitOfWork aberta por quem chama, o bloco usa um savepoint: em
+         * caso de falha só as suas escritas são desfeitas.
+         *
+         * @param work Bloco a executar; deve retornar true para confirmar
+         * @return Valor retornado por work
+         */
+        bool runInTransaction(const std::function<bool()>& work);
+
+        /**
+         * @brief Acessa a entidade de um elemento de coleção
+         * @param entity Entidade
+         * @return Referência para a entidade
+         */
+        static T& entityRef(T& entity);
+
+        /**
+         * @brief Acessa a entidade de um elemento de coleção
+         * @param entity Ponteiro compartilhado para a entidade
+         * @return Referência para a entidade
+         */
+        static T& entityRef(const std::shared_ptr<T>& entity);
 
         /**
          * @brief Prepara uma declaração SQL
-         * @copydoc IRepository::prepare
+         *
+         * A declaração vem do cache da conexão e é devolvida a ele quando o
+         * ponteiro retornado é liberado.
+         *
          * @param sql Consulta SQL a ser preparada
          * @return Declaração preparada
          */
-        SQLite::Statement prepare(const std::string& sql) const;
+        std::shared_ptr<SQLite::Statement> prepare(std::string_view sql) const;
+
+        /**
+         * @brief Executa uma consulta `IN (...)` em lotes de IDs
+         *
+         * Usa StatementCache::forEachIdBatch com o cache da conexão.
+         *
+         * @param ids IDs distintos a consultar
+         * @param prefix SQL terminado em "IN ("
+         * @param suffix SQL acrescentado depois do ")" que fecha a lista
+         * @param row Função chamada para cada linha do resultado
+         */
+        void forEachIdBatch(const std::vector<unsigned>& ids,
+                            std::string_view prefix,
+                            std::string_view suffix,
+                            const std::function<void(SQLite::Statement&)>& row) const;
+
+        /**
+         * @brief SELECT usado por findByIds, terminado em "IN ("
+         *
+         * Repositórios que leem as entidades com junções sobrescrevem este
+         * método; as linhas continuam sendo mapeadas por mapRowToEntity.
+         *
+         * @return SQL até a lista de IDs
+         */
+        virtual std::string_view idsSelectPrefix() const;
+
+        /**
+         * @brief Percorre o resultado de uma consulta entregando uma entidade por vez
+         *
+         * Cada linha é mapeada apenas quando lida, sem acumular o resultado
+         * em memória.
+         *
+         * @param query Declaração já preparada e com os parâmetros definidos
+         * @param callback Função chamada para cada entidade
+         * @return Número de entidades entregues ao callback
+         */
+        size_t forEachRow(SQLite::Statement& query,
+                          const RowCallback& callback) const;
 
         /**
          * @brief Busca entidades por um campo específico
@@ -57,6 +191,10 @@ namespace core {
 
         /**
          * @brief Mapeia uma linha do resultado para uma entidade
+         *
+         * As primeiras colunas da linha são as de Traits::columns, na mesma
+         * ordem, e podem ser lidas com Traits::read.
+         *
          * @param query Declaração SQL com o resultado da consulta
          * @return Ponteiro compartilhado para a entidade mapeada
          */
@@ -78,21 +216,34 @@ namespace core {
         virtual bool update(const T& entity) override = 0;
 
     public:
-        SQLiteRepositoryBase(
-            std::shared_ptr<SQLite::Database> db,
-            const std::string& table_name
-        );
+        explicit SQLiteRepositoryBase(std::shared_ptr<SQLite::Database> db);
 
         virtual ~SQLiteRepositoryBase() = default;
 
         /**
          * @bief Busca uma entidade pelo ID
          * @copydoc IRepository::findById
+         *
+         * Uma entidade presente no mapa de identidade é devolvida sem ler a
+         * sua linha, mas a verificação do mapa ainda executa um `PRAGMA
+         * data_version` na conexão.
+         *
          * @param id ID da entidade a ser buscada
          * @return Ponteiro compartilhado para a entidade encontrada, ou nullptr se não encontrada
          */
         std::shared_ptr<T> findById(unsigned id) const override;
 
+        /**
+         * @brief Busca várias entidades pelo ID com poucas consultas
+         *
+         * Entidades presentes no mapa de identidade não são consultadas; as
+         * demais são lidas com `WHERE id IN (...)` e registradas no mapa.
+         *
+         * @param ids IDs procurados; repetições são ignoradas
+         * @return Entidades encontradas, na ordem da primeira ocorrência em ids
+         */
+        std::vector<std::shared_ptr<T>> findByIds(const std::vector<unsigned>& ids) const;
+
 
         /**
          * @brief Obtém o ID da última inserção
@@ -108,6 +259,31 @@ namespace core {
          */
         std::vector<std::shared_ptr<T>> getAll() const override;
 
+        /**
+         * @brief Percorre todas as entidades do repositório em ordem de ID
+         *
+         * As entidades são lidas sob demanda de uma consulta aberta, de
+         * modo que a memória usada não depende do tamanho da tabela.
+         *
+         * @param callback Função chamada para cada entidade; retornar false
+         *        interrompe a leitura
+         * @return Número de entidades entregues ao callback
+         */
+        size_t forEach(const RowCallback& callback) const;
+
+        /**
+         * @brief Obtém uma página de entidades por paginação por chave
+         *
+         * Para obter a próxima página, passe o ID da última entidade da
+         * página anterior como after_id.
+         *
+         * @param after_id Apenas entidades com ID maior que este são retornadas
+         * @param limit Número máximo de entidades
+         * @return Entidades em ordem crescente de ID
+         */
+        std::vector<std::shared_ptr<T>> getPage(unsigned after_id,
+                                                size_t limit) const;
+
         /**
          * @brief Verifica se um ID existe na tabela
          * @copydoc IRepository::exists
@@ -131,6 +307,29 @@ namespace core {
          */
         virtual bool save(T& entity) override;
 
+        /**
+         * @brief Insere várias entidades em uma única transação
+         *
+         * As inserções reaproveitam a mesma declaração preparada e os IDs
+         * gerados são gravados nas entidades. Se alguma falhar, nada é
+         * gravado e os IDs voltam a 0.
+         *
+         * @tparam Range Coleção de T ou de std::shared_ptr<T>
+         * @param entities Entidades a serem inseridas
+         * @return true se todas foram inseridas, false caso contrário
+         */
+        template <typename Range>
+        bool insertMany(Range& entities);
+
+        /**
+         * @brief Salva (insere ou atualiza) várias entidades em uma única transação
+         * @tparam Range Coleção de T ou de std::shared_ptr<T>
+         * @param entities Entidades a serem salvas
+         * @return true se todas foram salvas, false caso contrário
+         */
+        template <typename Range>
+        bool saveMany(Range& entities);
+
         /**
          * @brief Remove uma entidade pelo ID
          * @copydoc IRepository::remove
@@ -144,6 +343,28 @@ namespace core {
          * @return Quantidade de entidades
          */
         virtual size_t count() const override;
+
+        /**
+         * @brief Obtém os contadores do cache de declarações da conexão
+         * @return Acertos, falhas e descartes do cache
+         */
+        StatementCache::Stats getStatementCacheStats() const;
+
+        /**
+         * @brief Define quantas entidades o mapa de identidade pode manter
+         *
+         * O mapa é compartilhado pelos repositórios da mesma conexão.
+         * Não tem efeito se o repositório não usa mapa de identidade.
+         *
+         * @param capacity Número máximo de entidades, 0 desativa o cache
+         */
+        void setIdentityMapCapacity(size_t capacity);
+
+        /**
+         * @brief Obtém os contadores do mapa de identidade
+         * @return Acertos, falhas e descartes do mapa
+         */
+        typename IdentityMap<T>::Stats getIdentityMapStats() const;
     };
 
 }  // namespace core
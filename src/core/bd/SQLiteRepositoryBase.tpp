@@ -12,117 +12,378 @@
 
 // #include "core/bd/SQLiteRepositoryBase.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace core {
-    template <typename T>
-    SQLiteRepositoryBase<T>::SQLiteRepositoryBase(
-        std::shared_ptr<SQLite::Database> db,
-        const std::string& table_name)
-        : _db(db), _table_name(table_name) {}
+    template <typename T, typename Traits>
+    SQLiteRepositoryBase<T, Traits>::SQLiteRepositoryBase(
+        std::shared_ptr<SQLite::Database> db)
+        : _db(db),
+          _statements(StatementCache::forDatabase(db)),
+          _table_name(Traits::table) {}
 
-    template <typename T>
-    SQLite::Statement SQLiteRepositoryBase<T>::prepare(
-        const std::string& sql) const {
-        return SQLite::Statement(*_db, sql);
+    template <typename T, typename Traits>
+    std::shared_ptr<SQLite::Statement> SQLiteRepositoryBase<T, Traits>::prepare(
+        std::string_view sql) const {
+        if (!_statements)
+            return std::make_shared<SQLite::Statement>(*_db, std::string(sql));
+
+        return _statements->acquire(sql);
+    }
+
+    template <typename T, typename Traits>
+    void SQLiteRepositoryBase<T, Traits>::forEachIdBatch(
+        const std::vector<unsigned>& ids,
+        std::string_view prefix,
+        std::string_view suffix,
+        const std::function<void(SQLite::Statement&)>& row) const {
+        if (_statements)
+            _statements->forEachIdBatch(ids, prefix, suffix, row);
+    }
+
+    template <typename T, typename Traits>
+    std::string_view SQLiteRepositoryBase<T, Traits>::idsSelectPrefix() const {
+        static constexpr SqlText sql = Traits::select() + " WHERE id IN (";
+        return sql;
+    }
+
+    template <typename T, typename Traits>
+    void SQLiteRepositoryBase<T, Traits>::enableIdentityMap() {
+        _identity_map = IdentityMap<T>::forDatabase(_db);
+    }
+
+    template <typename T, typename Traits>
+    void SQLiteRepositoryBase<T, Traits>::syncIdentityMap() const {
+        if (_identity_map)
+            syncIdentityMap(*_identity_map);
     }
 
-    template <typename T>
+    template <typename T, typename Traits>
+    template <typename U>
+    void SQLiteRepositoryBase<T, Traits>::syncIdentityMap(IdentityMap<U>& map) const {
+        // Não muda com as gravações desta conexão, que já invalidam o mapa
+        auto query = prepare("PRAGMA data_version;");
+        if (query->executeStep())
+            map.sync(query->getColumn(0).getInt64());
+    }
+
+    template <typename T, typename Traits>
+    std::shared_ptr<T> SQLiteRepositoryBase<T, Traits>::findCached(unsigned id) const {
+        if (!_identity_map)
+            return nullptr;
+
+        syncIdentityMap();
+        return _identity_map->find(id);
+    }
+
+    template <typename T, typename Traits>
+    std::shared_ptr<T> SQLiteRepositoryBase<T, Traits>::cache(
+        unsigned id, std::shared_ptr<T> entity) const {
+        if (!_identity_map)
+            return entity;
+
+        return _identity_map->insert(id, entity);
+    }
+
+    template <typename T, typename Traits>
+    void SQLiteRepositoryBase<T, Traits>::invalidate(unsigned id) const {
+        if (_identity_map)
+            _identity_map->invalidate(id);
+    }
+
+    template <typename T, typename Traits>
+    bool SQLiteRepositoryBase<T, Traits>::runInTransaction(
+        const std::function<bool()>& work) {
+        UnitOfWork unit(_db);
+        if (!work())
+            return false;  // rollback no destrutor
+
+        unit.commit();
+        return true;
+    }
+
+    template <typename T, typename Traits>
+    T& SQLiteRepositoryBase<T, Traits>::entityRef(T& entity) {
+        return entity;
+    }
+
+    template <typename T, typename Traits>
+    T& SQLiteRepositoryBase<T, Traits>::entityRef(const std::shared_ptr<T>& entity) {
+        return *entity;
+    }
+
+    template <typename T, typename Traits>
     std::vector<std::shared_ptr<T>>
-    SQLiteRepositoryBase<T>::findBy(const std::string& field,
+    SQLiteRepositoryBase<T, Traits>::findBy(const std::string& field,
                                    const std::string& value) const {
         std::vector<std::shared_ptr<T>> results;
-        std::string sql = "SELECT * FROM " + _table_name +
-                          " WHERE " + field + " = ?";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, value);
+        // O campo só é conhecido em tempo de execução
+        static constexpr SqlText select = Traits::select();
+        std::string sql = std::string(select.view()) + " WHERE " + field + " = ?";
+        auto query = prepare(sql);
+        query->bind(1, value);
 
-        while (query.executeStep())
-            results.push_back(this->mapRowToEntity(query));
+        while (query->executeStep())
+            results.push_back(this->mapRowToEntity(*query));
 
         return results;
     }
 
-    template <typename T>
-    const std::string& SQLiteRepositoryBase<T>::getTableName() const {
+    template <typename T, typename Traits>
+    const std::string& SQLiteRepositoryBase<T, Traits>::getTableName() const {
         return _table_name;
     }
 
-    template <typename T>
-    std::shared_ptr<T> SQLiteRepositoryBase<T>::findById(unsigned id) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE id = ?";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(id));
+    template <typename T, typename Traits>
+    std::shared_ptr<T> SQLiteRepositoryBase<T, Traits>::findById(unsigned id) const {
+        auto cached = findCached(id);
+        if (cached)
+            return cached;
+
+        static constexpr SqlText sql = Traits::select() + " WHERE id = ?";
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(id));
 
-        if (query.executeStep())
-            return this->mapRowToEntity(query);
+        if (query->executeStep())
+            return cache(id, this->mapRowToEntity(*query));
 
         return nullptr;
     }
 
-    template <typename T>
-    std::vector<std::shared_ptr<T>> SQLiteRepositoryBase<T>::getAll() const {
+    template <typename T, typename Traits>
+    std::vector<std::shared_ptr<T>>
+    SQLiteRepositoryBase<T, Traits>::findByIds(const std::vector<unsigned>& ids) const {
+        std::unordered_map<unsigned, std::shared_ptr<T>> found;
+        std::vector<unsigned> missing;
+        syncIdentityMap();
+        for (unsigned id : ids) {
+            if (found.count(id))
+                continue;
+
+            auto cached = _identity_map ? _identity_map->find(id) : nullptr;
+            found[id] = cached;
+            if (!cached)
+                missing.push_back(id);
+        }
+
+        forEachIdBatch(missing, idsSelectPrefix(), ";",
+                       [this, &found](SQLite::Statement& query) {
+                           auto entity = this->mapRowToEntity(query);
+                           if (entity)
+                               found[entity->getId()] = cache(entity->getId(), entity);
+                       });
+
+        std::vector<std::shared_ptr<T>> results;
+        std::unordered_set<unsigned> delivered;
+        for (unsigned id : ids) {
+            auto& entity = found[id];
+            if (entity && delivered.insert(id).second)
+                results.push_back(entity);
+        }
+
+        return results;
+    }
+
+    template <typename T, typename Traits>
+    std::vector<std::shared_ptr<T>> SQLiteRepositoryBase<T, Traits>::getAll() const {
+        std::vector<std::shared_ptr<T>> results;
+        static constexpr SqlText sql = Traits::select();
+        auto query = prepare(sql);
+
+        while (query->executeStep())
+            results.push_back(this->mapRowToEntity(*query));
+
+        return results;
+    }
+
+    template <typename T, typename Traits>
+    size_t SQLiteRepositoryBase<T, Traits>::forEachRow(SQLite::Statement& query,
+                                               const RowCallback& callback) const {
+        size_t delivered = 0;
+        while (query.executeStep()) {
+            delivered++;
+            if (!callback(this->mapRowToEntity(query)))
+                break;
+        }
+
+        return delivered;
+    }
+
+    template <typename T, typename Traits>
+    size_t SQLiteRepositoryBase<T, Traits>::forEach(const RowCallback& callback) const {
+        static constexpr SqlText sql = Traits::select() + " ORDER BY id";
+        auto query = prepare(sql);
+
+        return forEachRow(*query, callback);
+    }
+
+    template <typename T, typename Traits>
+    std::vector<std::shared_ptr<T>>
+    SQLiteRepositoryBase<T, Traits>::getPage(unsigned after_id, size_t limit) const {
         std::vector<std::shared_ptr<T>> results;
-        std::string sql = "SELECT * FROM " + _table_name;
-        SQLite::Statement query = prepare(sql);
+        static constexpr SqlText sql = Traits::select()
+                                       + " WHERE id > ? ORDER BY id LIMIT ?";
+        auto query = prepare(sql);
+        query->bind(1, after_id);
+        query->bind(2, static_cast<int64_t>(limit));
 
-        while (query.executeStep())
-            results.push_back(this->mapRowToEntity(query));
+        forEachRow(*query, [&results](const std::shared_ptr<T>& entity) {
+            results.push_back(entity);
+            return true;
+        });
 
         return results;
     }
 
-    template <typename T>
-    unsigned SQLiteRepositoryBase<T>::getLastInsertId() const {
+    template <typename T, typename Traits>
+    unsigned SQLiteRepositoryBase<T, Traits>::getLastInsertId() const {
         return static_cast<unsigned>(_db->getLastInsertRowid());
     }
 
-    template <typename T>
-    bool SQLiteRepositoryBase<T>::exists(unsigned id) const {
-        std::string sql = "SELECT COUNT(1) FROM " + _table_name + " WHERE id = ?";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(id));
+    template <typename T, typename Traits>
+    bool SQLiteRepositoryBase<T, Traits>::exists(unsigned id) const {
+        static constexpr SqlText sql = SqlText("SELECT COUNT(1) FROM ")
+                                       + Traits::table + " WHERE id = ?";
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(id));
 
-        if (query.executeStep())
-            return query.getColumn(0).getInt() > 0;
+        if (query->executeStep())
+            return query->getColumn(0).getInt() > 0;
 
         return false;
     }
 
-    template <typename T>
-    bool SQLiteRepositoryBase<T>::removeAll() {
-        std::string sql = "DELETE FROM " + _table_name;
-        SQLite::Statement query = prepare(sql);
-        return query.exec() > 0;
+    template <typename T, typename Traits>
+    bool SQLiteRepositoryBase<T, Traits>::removeAll() {
+        if (_identity_map)
+            _identity_map->clear();
+
+        static constexpr SqlText sql = SqlText("DELETE FROM ") + Traits::table;
+        auto query = prepare(sql);
+        return query->exec() > 0;
     }
 
-    template <typename T>
-    bool SQLiteRepositoryBase<T>::remove(unsigned id) {
-        std::string sql = "DELETE FROM " + _table_name + " WHERE id = ?";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(id));
-        return query.exec() > 0;
+    template <typename T, typename Traits>
+    bool SQLiteRepositoryBase<T, Traits>::remove(unsigned id) {
+        invalidate(id);
+
+        static constexpr SqlText sql = SqlText("DELETE FROM ") + Traits::table
+                                       + " WHERE id = ?";
+        auto query = prepare(sql);
+        query->bind(1, static_cast<int>(id));
+        return query->exec() > 0;
     }
 
-    template <typename T>
-    bool SQLiteRepositoryBase<T>::save(T& entity) {
+    template <typename T, typename Traits>
+    bool SQLiteRepositoryBase<T, Traits>::save(T& entity) {
         if (entity.getId() == 0)
             return insert(entity);
-        else
-            return update(entity);
+
+        invalidate(entity.getId());
+        return update(entity);
     }
 
-    template <typename T>
-    size_t SQLiteRepositoryBase<T>::count() const {
-        std::string sql = "SELECT COUNT(1) FROM " + _table_name;
-        SQLite::Statement query = prepare(sql);
+    template <typename T, typename Traits>
+    template <typename Range>
+    bool SQLiteRepositoryBase<T, Traits>::insertMany(Range& entities) {
+        std::vector<T*> inserted;
+
+        bool success = false;
+        try {
+            success = runInTransaction([this, &entities, &inserted]() {
+                for (auto& item : entities) {
+                    T& entity = entityRef(item);
+                    if (!insert(entity))
+                        return false;
+                    inserted.push_back(&entity);
+                }
+                return true;
+            });
+        } catch (...) {
+            for (T* entity : inserted)
+                entity->setId(0);
+            throw;
+        }
 
-        if (query.executeStep())
-            return static_cast<size_t>(query.getColumn(0).getInt());
+        if (!success) {
+            for (T* entity : inserted)
+                entity->setId(0);
+        }
+
+        return success;
+    }
+
+    template <typename T, typename Traits>
+    template <typename Range>
+    bool SQLiteRepositoryBase<T, Traits>::saveMany(Range& entities) {
+        std::vector<T*> inserted;
+
+        bool success = false;
+        try {
+            success = runInTransaction([this, &entities, &inserted]() {
+                for (auto& item : entities) {
+                    T& entity = entityRef(item);
+                    bool is_new = entity.getId() == 0;
+                    if (!save(entity))
+                        return false;
+                    if (is_new)
+                        inserted.push_back(&entity);
+                }
+                return true;
+            });
+        } catch (...) {
+            for (T* entity : inserted)
+                entity->setId(0);
+            throw;
+        }
+
+        if (!success) {
+            for (T* entity : inserted)
+                entity->setId(0);
+        }
+
+        return success;
+    }
+
+    template <typename T, typename Traits>
+    size_t SQLiteRepositoryBase<T, Traits>::count() const {
+        static constexpr SqlText sql = SqlText("SELECT COUNT(1) FROM ")
+                                       + Traits::table;
+        auto query = prepare(sql);
+
+        if (query->executeStep())
+            return static_cast<size_t>(query->getColumn(0).getInt());
 
         return 0;
     }
+
+    template <typename T, typename Traits>
+    StatementCache::Stats SQLiteRepositoryBase<T, Traits>::getStatementCacheStats() const {
+        if (!_statements)
+            return StatementCache::Stats();
+
+        return _statements->getStats();
+    }
+
+    template <typename T, typename Traits>
+    void SQLiteRepositoryBase<T, Traits>::setIdentityMapCapacity(size_t capacity) {
+        if (_identity_map)
+            _identity_map->setCapacity(capacity);
+    }
+
+    template <typename T, typename Traits>
+    typename IdentityMap<T>::Stats
+    SQLiteRepositoryBase<T, Traits>::getIdentityMapStats() const {
+        if (!_identity_map)
+            return typename IdentityMap<T>::Stats();
+
+        return _identity_map->getStats();
+    }
 }
 
 #endif // SQLITE_REPOSITORY_BASE_TPP
@@ -0,0 +1,101 @@
+/**
+ * @file ScannedFileRepository.cpp
+ * @brief Implementação do acesso às impressões dos arquivos
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include "core/bd/ScannedFileRepository.hpp"
+
+#include <cstdint>
+
+namespace core {
+    ScannedFileRepository::ScannedFileRepository(std::shared_ptr<SQLite::Database> db)
+        : _statements(StatementCache::forDatabase(db)) {}
+
+    namespace {
+        FileFingerprint fingerprintFromRow(SQLite::Statement& query) {
+            FileFingerprint fingerprint;
+            fingerprint.path = query.getColumn(0).getString();
+            fingerprint.size = static_cast<uint64_t>(query.getColumn(1).getInt64());
+            fingerprint.mtime = query.getColumn(2).getInt64();
+            fingerprint.inode = static_cast<uint64_t>(query.getColumn(3).getInt64());
+            fingerprint.hash_prefix = static_cast<uint64_t>(query.getColumn(4).getInt64());
+            fingerprint.failed = query.getColumn(5).getString() == "failed";
+            return fingerprint;
+        }
+    }  // namespace
+
+    std::optional<FileFingerprint> ScannedFileRepository::find(const std::string& path) const {
+        if (!_statements)
+            return std::nullopt;
+
+        auto query = _statements->acquire(
+            "SELECT path, size, mtime, inode, hash_prefix, status "
+            "FROM scanned_files WHERE path = ?;");
+        query->bind(1, path);
+
+        if (!query->executeStep())
+            return std::nullopt;
+        return fingerprintFromRow(*query);
+    }
+
+    std::unordered_map<std::string, FileFingerprint>
+    ScannedFileRepository::findUnder(const std::string& directory) const {
+        std::unordered_map<std::string, FileFingerprint> fingerprints;
+        if (!_statements)
+            return fingerprints;
+
+        // Intervalo na chave primária: 0xFF não ocorre em UTF-8, então
+        // directory + 0xFF é maior que qualquer caminho com esse prefixo
+        auto query = _statements->acquire(
+            "SELECT path, size, mtime, inode, hash_prefix, status "
+            "FROM scanned_files WHERE path >= ? AND path < ?;");
+        query->bind(1, directory);
+        query->bind(2, directory + '\xFF');
+
+        while (query->executeStep()) {
+            FileFingerprint fingerprint = fingerprintFromRow(*query);
+
+            std::string path = fingerprint.path;
+            fingerprints.emplace(std::move(path), std::move(fingerprint));
+        }
+
+        return fingerprints;
+    }
+
+    bool ScannedFileRepository::save(const FileFingerprint& fingerprint,
+                                     unsigned user_id) const {
+        if (!_statements)
+            return false;
+
+        auto query = _statements->acquire(
+            "INSERT INTO scanned_files "
+            "(path, user_id, size, mtime, inode, hash_prefix, status, scanned_at) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, strftime('%s', 'now')) "
+            "ON CONFLICT(path) DO UPDATE SET user_id = excluded.user_id, "
+            "size = excluded.size, mtime = excluded.mtime, inode = excluded.inode, "
+            "hash_prefix = excluded.hash_prefix, status = excluded.status, "
+            "scanned_at = excluded.scanned_at;");
+        query->bind(1, fingerprint.path);
+        query->bind(2, user_id);
+        query->bind(3, static_cast<int64_t>(fingerprint.size));
+        query->bind(4, fingerprint.mtime);
+        query->bind(5, static_cast<int64_t>(fingerprint.inode));
+        query->bind(6, static_cast<int64_t>(fingerprint.hash_prefix));
+        query->bind(7, fingerprint.failed ? "failed" : "rejected");
+
+        return query->exec() > 0;
+    }
+
+    bool ScannedFileRepository::remove(const std::string& path) const {
+        if (!_statements)
+            return false;
+
+        auto query = _statements->acquire("DELETE FROM scanned_files WHERE path = ?;");
+        query->bind(1, path);
+        return query->exec() > 0;
+    }
+}  // namespace core
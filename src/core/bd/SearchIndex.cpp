@@ -0,0 +1,99 @@
+/**
+ * @file SearchIndex.cpp
+ * @brief Implementação da busca no índice textual da biblioteca
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-23
+ */
+
+#include "core/bd/SearchIndex.hpp"
+
+#include <cctype>
+#include <sstream>
+#include <string>
+
+namespace core {
+    SearchIndex::SearchIndex(std::shared_ptr<SQLite::Database> db)
+        : _statements(StatementCache::forDatabase(db)) {}
+
+    const char* SearchIndex::kindName(Kind kind) {
+        switch (kind) {
+            case Kind::Song:
+                return "song";
+            case Kind::Artist:
+                return "artist";
+            case Kind::Album:
+                return "album";
+            case Kind::Playlist:
+                return "playlist";
+        }
+        return "";
+    }
+
+    const char* SearchIndex::rankExpression() {
+        return "bm25(search_index, 0.0, 0.0, 0.0, 10.0, 5.0, 3.0, 1.0)";
+    }
+
+    std::string SearchIndex::toMatchExpression(const std::string& query) {
+        std::istringstream stream(query);
+        std::string term;
+        std::string expression;
+
+        while (stream >> term) {
+            std::string cleaned;
+            for (char c : term) {
+                if (c != '"')
+                    cleaned += c;
+            }
+
+            bool has_token = false;
+            for (char c : cleaned) {
+                unsigned char uc = static_cast<unsigned char>(c);
+                if (std::isalnum(uc) || uc >= 0x80) {
+                    has_token = true;
+                    break;
+                }
+            }
+            if (!has_token)
+                continue;
+
+            if (!expression.empty())
+                expression += " ";
+            expression += "\"" + cleaned + "\"*";
+        }
+
+        return expression;
+    }
+
+    std::vector<SearchIndex::Hit>
+    SearchIndex::search(const std::string& query,
+                        Kind kind,
+                        unsigned user_id,
+                        size_t limit) const {
+        std::vector<Hit> hits;
+
+        std::string expression = toMatchExpression(query);
+        if (expression.empty() || !_statements)
+            return hits;
+
+        auto statement = _statements->acquire(
+            std::string("SELECT entity_id, ") + rankExpression() + " AS rank "
+            "FROM search_index "
+            "WHERE search_index MATCH ? AND kind = ? AND user_id = ? "
+            "ORDER BY rank LIMIT ?;");
+
+        statement->bind(1, expression);
+        statement->bind(2, kindName(kind));
+        statement->bind(3, user_id);
+        statement->bind(4, static_cast<int64_t>(limit));
+
+        while (statement->executeStep()) {
+            hits.push_back(Hit {
+                static_cast<unsigned>(statement->getColumn(0).getInt()),
+                statement->getColumn(1).getDouble()});
+        }
+
+        return hits;
+    }
+}  // namespace core
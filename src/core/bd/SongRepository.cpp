@@ -3,6 +3,7 @@
 #include "SQLiteCpp/Statement.h"
 #include "core/bd/AlbumRepository.hpp"
 #include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DataLoader.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/bd/UserRepository.hpp"
 #include "core/entities/Artist.hpp"
@@ -35,30 +36,45 @@
 */
 
 namespace core {
+    using SongColumns = EntityTraits<Song>;
 
     SongRepository::SongRepository(std::shared_ptr<SQLite::Database> db)
-        : SQLiteRepositoryBase<Song>(db, "songs") {
+        : SQLiteRepositoryBase<Song>(db),
+          _user_repo(std::make_shared<UserRepository>(db)) {
+        enableIdentityMap();
     }
 
     bool SongRepository::insert(Song &entity) {
-        std::string sql = "INSERT INTO " + _table_name + " (title, duration, track_number, artist_id, album_id, user_id, release_year) "
-                                                    "VALUES (?, ?, ?, ?, ?, ?, ?);";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getDuration());
-        query.bind(3, entity.getTrackNumber());
-        query.bind(4, entity.getArtistId());
-        //query.bind(5, entity.getAlbumId());
+        static constexpr SqlText sql = SongColumns::insert();
+
+        auto query = prepare(sql);
+        query->bind(1, entity.getTitle());
+        query->bind(2, entity.getDuration());
+        query->bind(3, entity.getTrackNumber());
+        query->bind(4, entity.getArtistId());
+        //query->bind(5, entity.getAlbumId());
         if (entity.getAlbumId() == 0){
-          query.bind(5);
+          query->bind(5);
         }else{
-          query.bind(5, entity.getAlbumId());
+          query->bind(5, entity.getAlbumId());
         }
-        query.bind(6, entity.getUser()->getId());
-        query.bind(7, entity.getYear());
-
-        bool success = query.exec() > 0;
+        query->bind(6, entity.getUser()->getId());
+        query->bind(7, entity.getYear());
+        // 0 significa propriedade não lida do arquivo
+        if (entity.getFileSize() == 0)
+            query->bind(8);
+        else
+            query->bind(8, static_cast<int64_t>(entity.getFileSize()));
+        if (entity.getBitrate() == 0)
+            query->bind(9);
+        else
+            query->bind(9, entity.getBitrate());
+        if (entity.getSampleRate() == 0)
+            query->bind(10);
+        else
+            query->bind(10, entity.getSampleRate());
+
+        bool success = query->exec() > 0;
 
         if (success)
             entity.setId(static_cast<unsigned>(getLastInsertId()));
@@ -67,93 +83,119 @@ namespace core {
     };
 
     bool SongRepository::update(const Song &entity) {
-        std::string sql = "UPDATE " + _table_name + " SET title = ?, artist_id = ?, user_id = ? "
-                                                    "WHERE id = ?;"; // nao faz sentido trocar duration
+        static constexpr SqlText sql = SongColumns::update(); // nao faz sentido trocar duration
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, entity.getTitle());
-        query.bind(2, entity.getArtistId());
-        query.bind(3, entity.getUser()->getId());
-        query.bind(4, entity.getId());
+        auto query = prepare(sql);
+        query->bind(1, entity.getTitle());
+        query->bind(2, entity.getArtistId());
+        query->bind(3, entity.getUser()->getId());
+        query->bind(4, entity.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     };
 
     std::shared_ptr<Song> SongRepository::mapRowToEntity(SQLite::Statement &query) const {
-        unsigned id = query.getColumn("id").getInt();
-        std::string title = query.getColumn("title").getString();
-        unsigned duration = query.getColumn("duration").getInt();
-        unsigned track_number = query.getColumn("track_number").getInt();
-        unsigned artist_id = query.getColumn("artist_id").getInt();
-        unsigned user_id = query.getColumn("user_id").getInt();
-        int year = query.getColumn("release_year").getInt();
+        unsigned id = SongColumns::read<SongColumns::Id>(query);
+        std::string title = SongColumns::read<SongColumns::Title>(query);
+        unsigned duration = SongColumns::read<SongColumns::Duration>(query);
+        unsigned track_number = SongColumns::read<SongColumns::TrackNumber>(query);
+        unsigned artist_id = SongColumns::read<SongColumns::ArtistId>(query);
+        unsigned album_id = SongColumns::read<SongColumns::AlbumId>(query);
+        unsigned user_id = SongColumns::read<SongColumns::UserId>(query);
+        int year = SongColumns::read<SongColumns::ReleaseYear>(query);
+        uint64_t file_size = SongColumns::read<SongColumns::FileSize>(query);
+        unsigned bitrate = SongColumns::read<SongColumns::Bitrate>(query);
+        unsigned sample_rate = SongColumns::read<SongColumns::SampleRate>(query);
 
         auto song = std::make_shared<Song>(id, title, artist_id, user_id);
         song->setDuration(duration);
         song->setTrackNumber(track_number);
         song->setYear(year);
-
-        auto artistLoader = [this, song]() -> std::shared_ptr<Artist> {
-            return this->getArtist(*song);
+        song->setAlbumId(album_id);
+        song->setFileSize(file_size);
+        song->setBitrate(bitrate);
+        song->setSampleRate(sample_rate);
+
+        // Os loaders não capturam this: a música pode continuar no mapa de
+        // identidade depois que este repositório for destruído
+        // Dentro do escopo de um DataLoader as cargas são feitas em lote
+        auto db = _db;
+        auto artistLoader = [db, artist_id]() -> std::shared_ptr<Artist> {
+            if (auto loader = DataLoader::current(db))
+                return loader->loadArtist(artist_id);
+            return ArtistRepository(db).findById(artist_id);
         };
 
-        auto featuringArtistsLoader = [this, id]() -> std::vector<std::shared_ptr<Artist>> {
+        auto featuringArtistsLoader = [db, id]() -> std::vector<std::shared_ptr<Artist>> {
+            if (auto loader = DataLoader::current(db))
+                return loader->loadFeaturingArtists(id);
             Song tempSong;
             tempSong.setId(id);
-            return this->getFeaturingArtists(tempSong);
+            return SongRepository(db).getFeaturingArtists(tempSong);
         };
 
-        auto albumLoader = [this, song]() -> std::shared_ptr<Album> {
-            return this->getAlbum(*song);
+        auto albumLoader = [db, album_id]() -> std::shared_ptr<Album> {
+            if (album_id == 0)
+                return nullptr;
+            if (auto loader = DataLoader::current(db))
+                return loader->loadAlbum(album_id);
+            return AlbumRepository(db).findById(album_id);
         };
 
         song->setArtistLoader(artistLoader);
         song->setFeaturingArtistsLoader(featuringArtistsLoader);
         song->setAlbumLoader(albumLoader);
 
-        auto user_repo = UserRepository(_db);
-        auto user_ptr = user_repo.findById(user_id);
+        auto user_ptr = _user_repo->findSharedById(user_id);
         if (user_ptr){
-          song->setUser(*user_ptr);
+          song->setUser(user_ptr);
         }
         else{
           throw std::runtime_error("Usuário não encontrado, song id "+ std::to_string(id));
         }
 
+        if (auto loader = DataLoader::current(_db))
+            loader->prime(song);
+
         return song;
     }
     bool SongRepository::save(Song &entity) {
         if (entity.getId() == 0) {
             return insert(entity);
         } else {
+            invalidate(entity.getId());
             return update(entity);
         }
     };
 
     bool SongRepository::remove(unsigned id) {
-        std::string sql = "DELETE FROM " + _table_name + " WHERE id = ?;";
+        invalidate(id);
 
-        SQLite::Statement query = prepare(sql);
+        static constexpr SqlText sql = SqlText("DELETE FROM ") + SongColumns::table
+                                       + " WHERE id = ?;";
 
-        query.bind(1, id);
+        auto query = prepare(sql);
 
-        return query.exec() > 0;
+        query->bind(1, id);
+
+        return query->exec() > 0;
     };
 
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByTitleAndUser(const std::string &title,
                                        const User &user) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE title LIKE ? AND user_id = ? ORDER BY title;";
+        static constexpr SqlText sql = SongColumns::select()
+                                       + " WHERE title LIKE ? AND user_id = ? ORDER BY title;";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
 
-        query.bind(1, "%" + title + "%"); // "%" nao considera char especial
-        query.bind(2, user.getId());
+        query->bind(1, "%" + title + "%"); // "%" nao considera char especial
+        query->bind(2, user.getId());
 
         std::vector<std::shared_ptr<Song>> songs;
-        while (query.executeStep()) {
-            songs.push_back(mapRowToEntity(query));
+        while (query->executeStep()) {
+            songs.push_back(mapRowToEntity(*query));
         }
 
         return songs;
@@ -161,77 +203,122 @@ namespace core {
 
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByUser(const User &user) const {
+        std::vector<std::shared_ptr<Song>> songs;
+        forEachByUser(user, [&songs](const std::shared_ptr<Song> &song) {
+            songs.push_back(song);
+            return true;
+        });
+
+        return songs;
+    };
 
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? ORDER BY title;";
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::findByUser(const User &user,
+                               unsigned after_id,
+                               size_t limit) const {
+        static constexpr SqlText sql = SongColumns::select()
+                                       + " WHERE user_id = ? AND id > ? ORDER BY id LIMIT ?;";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
-        query.bind(1, user.getId());
+        query->bind(1, user.getId());
+        query->bind(2, after_id);
+        query->bind(3, static_cast<int64_t>(limit));
 
         std::vector<std::shared_ptr<Song>> songs;
-
-        while (query.executeStep()) {
-            songs.push_back(mapRowToEntity(query));
-        }
+        forEachRow(*query, [&songs](const std::shared_ptr<Song> &song) {
+            songs.push_back(song);
+            return true;
+        });
 
         return songs;
-    };
+    }
 
-    std::vector<std::shared_ptr<Song>>
-    SongRepository::findByArtist(const Artist &artist) const {
+    size_t SongRepository::forEachByUser(const User &user,
+                                         const RowCallback &callback) const {
+        static constexpr SqlText sql = SongColumns::select()
+                                       + " WHERE user_id = ? ORDER BY title;";
 
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE artist_id = ? ORDER BY title;";
+        auto query = prepare(sql);
 
-        SQLite::Statement query = prepare(sql);
+        query->bind(1, user.getId());
 
-        query.bind(1, artist.getId());
+        return forEachRow(*query, callback);
+    }
 
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::findByArtist(const Artist &artist) const {
         std::vector<std::shared_ptr<Song>> songs;
-
-        while (query.executeStep()) {
-            songs.push_back(mapRowToEntity(query));
-        }
+        forEachByArtist(artist, [&songs](const std::shared_ptr<Song> &song) {
+            songs.push_back(song);
+            return true;
+        });
 
         return songs;
     };
 
-    std::vector<std::shared_ptr<Song>>
-    SongRepository::findByAlbum(const Album &album) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE album_id = ? ORDER BY title;";
+    size_t SongRepository::forEachByArtist(const Artist &artist,
+                                           const RowCallback &callback) const {
+        static constexpr SqlText sql = SongColumns::select()
+                                       + " WHERE artist_id = ? ORDER BY title;";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
-        query.bind(1, album.getId());
+        query->bind(1, artist.getId());
 
-        std::vector<std::shared_ptr<Song>> songs;
+        return forEachRow(*query, callback);
+    }
 
-        while (query.executeStep()) {
-            songs.push_back(mapRowToEntity(query));
-        }
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::findByAlbum(const Album &album) const {
+        std::vector<std::shared_ptr<Song>> songs;
+        forEachByAlbum(album, [&songs](const std::shared_ptr<Song> &song) {
+            songs.push_back(song);
+            return true;
+        });
 
         return songs;
     };
 
+    size_t SongRepository::forEachByAlbum(const Album &album,
+                                          const RowCallback &callback) const {
+        static constexpr SqlText sql = SongColumns::select()
+                                       + " WHERE album_id = ? ORDER BY title;";
+
+        auto query = prepare(sql);
+
+        query->bind(1, album.getId());
+
+        return forEachRow(*query, callback);
+    }
+
     std::shared_ptr<Song> SongRepository::findById(unsigned id) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE id = ?;";
+        auto cached = findCached(id);
+        if (cached)
+            return cached;
+
+        static constexpr SqlText sql = SongColumns::select() + " WHERE id = ?;";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, id);
+        auto query = prepare(sql);
+        query->bind(1, id);
 
-        if (query.executeStep()) {
-            return mapRowToEntity(query);
+        if (query->executeStep()) {
+            return cache(id, mapRowToEntity(*query));
         }
 
         return nullptr;
     };
 
     std::shared_ptr<Album> SongRepository::getAlbum(const Song &song) const {
-        std::string sql = "SELECT album_id FROM songs WHERE id = ?;";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, song.getId());
+        if (song.getAlbumId() > 0)
+            return AlbumRepository(_db).findById(song.getAlbumId());
 
-        if (query.executeStep()) {
-            unsigned album_id = query.getColumn("album_id").getInt();
+        static constexpr SqlText sql = "SELECT album_id FROM songs WHERE id = ?;";
+        auto query = prepare(sql);
+        query->bind(1, song.getId());
+
+        if (query->executeStep()) {
+            unsigned album_id = query->getColumn(0).getInt();
             if (album_id > 0) {
                 AlbumRepository album_repo(_db);
                 return album_repo.findById(album_id);
@@ -241,12 +328,15 @@ namespace core {
     };
 
     std::shared_ptr<Artist> SongRepository::getArtist(const Song &song) const {
-        std::string sql = "SELECT artist_id FROM songs WHERE id = ?;";
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, song.getId());
+        if (song.getArtistId() > 0)
+            return ArtistRepository(_db).findById(song.getArtistId());
+
+        static constexpr SqlText sql = "SELECT artist_id FROM songs WHERE id = ?;";
+        auto query = prepare(sql);
+        query->bind(1, song.getId());
 
-        if (query.executeStep()) {
-            unsigned artist_id = query.getColumn("artist_id").getInt();
+        if (query->executeStep()) {
+            unsigned artist_id = query->getColumn(0).getInt();
             if (artist_id > 0) {
                 ArtistRepository artist_repo(_db);
                 return artist_repo.findById(artist_id);
@@ -257,78 +347,106 @@ namespace core {
 
     std::vector<std::shared_ptr<Artist>>
     SongRepository::getFeaturingArtists(const Song &song) const {
-        std::string sql = "SELECT a.* FROM artists a "
-                          "JOIN song_artists sa ON a.id = sa.artist_id "
-                          "WHERE sa.song_id = ? AND sa.is_principal = 0;";
+        auto artists = getFeaturingArtists(std::vector<unsigned>{song.getId()});
+        return artists[song.getId()];
+    };
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, song.getId());
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+    SongRepository::getFeaturingArtists(const std::vector<unsigned> &song_ids) const {
+        using ArtistColumns = EntityTraits<Artist>;
+        // song_id vem depois das colunas do artista para manter os ordinais
+        static constexpr SqlText prefix =
+            SqlText("SELECT ") + ArtistColumns::columnList("a")
+            + ", sa.song_id FROM artists a "
+              "JOIN song_artists sa ON a.id = sa.artist_id "
+              "WHERE sa.is_principal = 0 AND sa.song_id IN (";
 
         ArtistRepository artist_repo(_db);
-        std::vector<std::shared_ptr<Artist>> artists;
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>> artists;
 
-        while (query.executeStep()) {
-            unsigned id = query.getColumn("id").getInt();
-            std::string name = query.getColumn("name").getString();
-            unsigned user_id = query.getColumn("user_id").getInt();
-
-            // TODO carregar usuário do artista
-            // artists.push_back(std::make_shared<Artist>(id, name, user_id));
-        }
+        forEachIdBatch(song_ids, prefix, " ORDER BY a.name;",
+                       [&artist_repo, &artists](SQLite::Statement &query) {
+            unsigned song_id = query.getColumn(ArtistColumns::ColumnCount).getUInt();
+            artists[song_id].push_back(artist_repo.findOrMap(
+                ArtistColumns::read<ArtistColumns::Id>(query),
+                ArtistColumns::read<ArtistColumns::Name>(query),
+                ArtistColumns::read<ArtistColumns::UserId>(query)));
+        });
 
         return artists;
-    };
+    }
 
     size_t SongRepository::count() const {
-        std::string sql = "SELECT COUNT(*) FROM " + _table_name + ";";
+        static constexpr SqlText sql = SqlText("SELECT COUNT(*) FROM ")
+                                       + SongColumns::table + ";";
 
-        SQLite::Statement query = prepare(sql);
+        auto query = prepare(sql);
 
-        if (query.executeStep()) {
-            return query.getColumn(0).getInt();
+        if (query->executeStep()) {
+            return query->getColumn(0).getInt();
         }
 
         return 0;
     }
 
     bool SongRepository::addFeaturingArtist(const Song &song, const Artist &artist, const User &user) const {
-        std::string sql = "INSERT OR IGNORE INTO song_artists (song_id, artist_id, user_id, is_principal) "
-                          "VALUES (?, ?, ?, 0);";
+        invalidate(song.getId());
+
+        static constexpr SqlText sql = "INSERT OR IGNORE INTO song_artists (song_id, artist_id, user_id, is_principal) "
+                                       "VALUES (?, ?, ?, 0);";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, song.getId());
-        query.bind(2, artist.getId());
-        query.bind(3, user.getId());
+        auto query = prepare(sql);
+        query->bind(1, song.getId());
+        query->bind(2, artist.getId());
+        query->bind(3, user.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     }
 
     bool SongRepository::removeFeaturingArtist(const Song &song, const Artist &artist) const {
-        std::string sql = "DELETE FROM song_artists "
-                          "WHERE song_id = ? AND artist_id = ? AND is_principal = 0;";
+        invalidate(song.getId());
+
+        static constexpr SqlText sql = "DELETE FROM song_artists "
+                                       "WHERE song_id = ? AND artist_id = ? AND is_principal = 0;";
 
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, song.getId());
-        query.bind(2, artist.getId());
+        auto query = prepare(sql);
+        query->bind(1, song.getId());
+        query->bind(2, artist.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     }
 
     bool SongRepository::setPrincipalArtist(const Song &song, const Artist &artist, const User &user) const {
+        invalidate(song.getId());
 
-        std::string delete_sql = "DELETE FROM song_artists WHERE song_id = ? AND is_principal = 1;";
-        SQLite::Statement delete_query = prepare(delete_sql);
-        delete_query.bind(1, song.getId());
-        delete_query.exec();
+        static constexpr SqlText delete_sql = "DELETE FROM song_artists WHERE song_id = ? AND is_principal = 1;";
+        auto delete_query = prepare(delete_sql);
+        delete_query->bind(1, song.getId());
+        delete_query->exec();
 
-        std::string insert_sql = "INSERT OR REPLACE INTO song_artists (song_id, artist_id, user_id, is_principal) "
-                                 "VALUES (?, ?, ?, 1);";
-        SQLite::Statement insert_query = prepare(insert_sql);
-        insert_query.bind(1, song.getId());
-        insert_query.bind(2, artist.getId());
-        insert_query.bind(3, user.getId());
+        static constexpr SqlText insert_sql = "INSERT OR REPLACE INTO song_artists (song_id, artist_id, user_id, is_principal) "
+                                              "VALUES (?, ?, ?, 1);";
+        auto insert_query = prepare(insert_sql);
+        insert_query->bind(1, song.getId());
+        insert_query->bind(2, artist.getId());
+        insert_query->bind(3, user.getId());
 
-        return insert_query.exec() > 0;
+        return insert_query->exec() > 0;
     }
 
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::search(const std::string& query,
+                           const User& user,
+                           size_t limit) const {
+        if (SearchIndex::toMatchExpression(query).empty())
+            return findByTitleAndUser(query, user);
+
+        std::vector<unsigned> ids;
+        SearchIndex index(_db);
+        for (const auto& hit :
+             index.search(query, SearchIndex::Kind::Song, user.getId(), limit))
+            ids.push_back(hit.id);
+
+        return findByIds(ids);
+    }
 } // namespace core
@@ -0,0 +1,230 @@
+/**
+ * @file StatementCache.cpp
+ * @brief Implementação do cache de declarações preparadas
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#include "core/bd/StatementCache.hpp"
+#include "core/bd/QueryProfiler.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace core {
+    StatementCache::StatementCache(std::shared_ptr<SQLite::Database> db,
+                                   size_t capacity)
+        : _db(db), _capacity(capacity) {}
+
+    StatementCache::~StatementCache() {
+        // As declarações precisam ser finalizadas antes da conexão, mesmo as
+        // que ainda estão emprestadas
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (const auto& entry : _lru)
+            finalize(*entry);
+
+        for (const auto& detached : _detached) {
+            if (auto entry = detached.lock())
+                finalize(*entry);
+        }
+
+        _index.clear();
+        _lru.clear();
+        _detached.clear();
+    }
+
+    std::shared_ptr<StatementCache>
+    StatementCache::forDatabase(const std::shared_ptr<SQLite::Database>& db) {
+        if (!db)
+            return nullptr;
+
+        static std::mutex registry_mutex;
+        static std::unordered_map<const SQLite::Database*,
+                                  std::weak_ptr<StatementCache>>
+            registry;
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+
+        auto found = registry.find(db.get());
+        if (found != registry.end()) {
+            auto cache = found->second.lock();
+            if (cache)
+                return cache;
+        }
+
+        auto cache = std::make_shared<StatementCache>(db);
+        registry[db.get()] = cache;
+        return cache;
+    }
+
+    StatementCache::StatementPtr StatementCache::lease(const EntryPtr& entry) {
+        std::weak_ptr<Entry> weak = entry;
+        return StatementPtr(entry->statement.get(),
+                            [weak](SQLite::Statement*) {
+                                // Sem a entrada o cache já finalizou a declaração
+                                EntryPtr entry = weak.lock();
+                                if (!entry)
+                                    return;
+
+                                std::lock_guard<std::mutex> lock(entry->mutex);
+                                if (entry->statement) {
+                                    entry->statement->tryReset();
+                                    try {
+                                        entry->statement->clearBindings();
+                                    } catch (const std::exception&) {
+                                    }
+                                }
+                                entry->in_use.store(false);
+                            });
+    }
+
+    StatementCache::StatementPtr
+    StatementCache::leaseDetached(const EntryPtr& entry) {
+        return StatementPtr(entry->statement.get(),
+                            [entry](SQLite::Statement*) { finalize(*entry); });
+    }
+
+    void StatementCache::finalize(Entry& entry) {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        entry.statement.reset();
+    }
+
+    StatementCache::StatementPtr
+    StatementCache::acquire(std::string_view sql) {
+        // Planos das consultas lentas são obtidos fora do callback do SQLite
+        if (QueryProfiler::enabled())
+            QueryProfiler::instance().capturePending(*_db);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto found = _index.find(sql);
+        if (found != _index.end()) {
+            EntryPtr entry = *found->second;
+            if (!entry->in_use.load()) {
+                entry->in_use.store(true);
+                _lru.splice(_lru.begin(), _lru, found->second);
+                _stats.hits++;
+                return lease(entry);
+            }
+
+            // Consulta aninhada com o mesmo SQL: usa uma declaração avulsa,
+            // registrada para que o destrutor também a finalize
+            _stats.misses++;
+            _detached.erase(std::remove_if(_detached.begin(), _detached.end(),
+                                           [](const std::weak_ptr<Entry>& detached) {
+                                               return detached.expired();
+                                           }),
+                            _detached.end());
+
+            auto detached = std::make_shared<Entry>();
+            detached->statement = std::make_unique<SQLite::Statement>(*_db, std::string(sql));
+            _detached.push_back(detached);
+            return leaseDetached(detached);
+        }
+
+        _stats.misses++;
+
+        auto entry = std::make_shared<Entry>();
+        entry->sql = std::string(sql);
+        entry->statement = std::make_unique<SQLite::Statement>(*_db, entry->sql);
+        entry->in_use.store(true);
+
+        _lru.push_front(entry);
+        _index[entry->sql] = _lru.begin();
+        evict();
+
+        return lease(entry);
+    }
+
+    void StatementCache::forEachIdBatch(
+        const std::vector<unsigned>& ids,
+        std::string_view prefix,
+        std::string_view suffix,
+        const std::function<void(SQLite::Statement&)>& row) {
+        size_t offset = 0;
+        while (offset < ids.size()) {
+            size_t remaining = ids.size() - offset;
+            size_t size = 1;
+            while (size < remaining && size < STATEMENT_CACHE_IDS_PER_QUERY)
+                size *= 2;
+
+            std::string sql(prefix);
+            sql += "?";
+            for (size_t i = 1; i < size; ++i)
+                sql += ", ?";
+            sql += ")";
+            sql += suffix;
+
+            auto query = acquire(sql);
+            for (size_t i = 0; i < size; ++i) {
+                size_t index = offset + std::min(i, remaining - 1);
+                query->bind(static_cast<int>(i + 1), ids[index]);
+            }
+
+            while (query->executeStep())
+                row(*query);
+
+            offset += std::min(size, remaining);
+        }
+    }
+
+    void StatementCache::evict() {
+        auto it = _lru.end();
+        while (_index.size() > _capacity && it != _lru.begin()) {
+            --it;
+            if ((*it)->in_use.load())
+                continue;
+
+            _index.erase((*it)->sql);
+            it = _lru.erase(it);
+            _stats.evictions++;
+        }
+    }
+
+    void StatementCache::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _lru.begin(); it != _lru.end();) {
+            if ((*it)->in_use.load()) {
+                ++it;
+                continue;
+            }
+
+            _index.erase((*it)->sql);
+            it = _lru.erase(it);
+        }
+    }
+
+    size_t StatementCache::getCapacity() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _capacity;
+    }
+
+    void StatementCache::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+        evict();
+    }
+
+    StatementCache::Stats StatementCache::getStats() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Stats stats = _stats;
+        stats.size = _index.size();
+        return stats;
+    }
+
+    void StatementCache::resetStats() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats = Stats();
+    }
+}  // namespace core
@@ -0,0 +1,229 @@
+/**
+ * @file SummaryRepository.cpp
+ * @brief Implementação das consultas de projeção para listagens
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#include "core/bd/SummaryRepository.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace core {
+    namespace {
+        const std::string SONG_COLUMNS =
+            "SELECT s.id, s.title, COALESCE(ar.name, '') AS artist, "
+            "COALESCE(al.title, '') AS album, s.duration ";
+
+        const std::string SONG_JOINS =
+            "LEFT JOIN artists ar ON ar.id = s.artist_id "
+            "LEFT JOIN albums al ON al.id = s.album_id ";
+
+        // O artista vem de uma subconsulta e não de um JOIN: álbuns com mais
+        // de um artista principal continuam a ocupar uma única linha
+        const std::string ALBUM_COLUMNS =
+            "SELECT al.id, al.title, "
+            "COALESCE((SELECT ar.name FROM album_artists aa "
+            "JOIN artists ar ON ar.id = aa.artist_id "
+            "WHERE aa.album_id = al.id AND aa.is_principal = 1 "
+            "ORDER BY aa.artist_id LIMIT 1), '') AS artist, "
+            "COALESCE(al.release_year, 0) AS year, "
+            "(SELECT COUNT(*) FROM songs s WHERE s.album_id = al.id) AS songs_count ";
+
+        const std::string ARTIST_COLUMNS =
+            "SELECT ar.id, ar.name, "
+            "(SELECT COUNT(*) FROM songs s WHERE s.artist_id = ar.id) AS songs_count ";
+
+        /**
+         * @brief Condição e ordenação das buscas no índice textual
+         */
+        std::string searchClause(const char* kind) {
+            return std::string("WHERE search_index MATCH ? AND search_index.kind = '")
+                   + kind + "' AND search_index.user_id = ? "
+                   + "ORDER BY " + SearchIndex::rankExpression() + " LIMIT ?;";
+        }
+    }  // namespace
+
+    SummaryRepository::SummaryRepository(std::shared_ptr<SQLite::Database> db)
+        : _statements(StatementCache::forDatabase(db)) {}
+
+    SongSummary SummaryRepository::readSong(SQLite::Statement& query) {
+        SongSummary summary;
+        summary.id = static_cast<unsigned>(query.getColumn(0).getInt());
+        summary.title = query.getColumn(1).getString();
+        summary.artist = query.getColumn(2).getString();
+        summary.album = query.getColumn(3).getString();
+        summary.duration = static_cast<unsigned>(query.getColumn(4).getInt());
+        return summary;
+    }
+
+    AlbumSummary SummaryRepository::readAlbum(SQLite::Statement& query) {
+        AlbumSummary summary;
+        summary.id = static_cast<unsigned>(query.getColumn(0).getInt());
+        summary.title = query.getColumn(1).getString();
+        summary.artist = query.getColumn(2).getString();
+        summary.year = query.getColumn(3).getInt();
+        summary.songs_count = static_cast<unsigned>(query.getColumn(4).getInt());
+        return summary;
+    }
+
+    ArtistSummary SummaryRepository::readArtist(SQLite::Statement& query) {
+        ArtistSummary summary;
+        summary.id = static_cast<unsigned>(query.getColumn(0).getInt());
+        summary.name = query.getColumn(1).getString();
+        summary.songs_count = static_cast<unsigned>(query.getColumn(2).getInt());
+        return summary;
+    }
+
+    std::vector<SongSummary>
+    SummaryRepository::searchSongs(const std::string& query,
+                                   unsigned user_id,
+                                   size_t limit) const {
+        std::vector<SongSummary> songs;
+        if (!_statements || limit == 0)
+            return songs;
+
+        std::string expression = SearchIndex::toMatchExpression(query);
+        std::shared_ptr<SQLite::Statement> statement;
+        if (expression.empty()) {
+            statement = _statements->acquire(
+                SONG_COLUMNS + "FROM songs s " + SONG_JOINS
+                + "WHERE s.title LIKE ? AND s.user_id = ? "
+                  "ORDER BY s.title LIMIT ?;");
+            statement->bind(1, "%" + query + "%");
+        } else {
+            statement = _statements->acquire(
+                SONG_COLUMNS + "FROM search_index "
+                + "JOIN songs s ON s.id = search_index.entity_id " + SONG_JOINS
+                + searchClause("song"));
+            statement->bind(1, expression);
+        }
+        statement->bind(2, user_id);
+        statement->bind(3, static_cast<int64_t>(limit));
+
+        songs.reserve(std::min<size_t>(limit, SEARCH_LIMIT_DEFAULT));
+        while (statement->executeStep())
+            songs.push_back(readSong(*statement));
+
+        return songs;
+    }
+
+    std::vector<AlbumSummary>
+    SummaryRepository::searchAlbums(const std::string& query,
+                                    unsigned user_id,
+                                    size_t limit) const {
+        std::vector<AlbumSummary> albums;
+        if (!_statements || limit == 0)
+            return albums;
+
+        std::string expression = SearchIndex::toMatchExpression(query);
+        std::shared_ptr<SQLite::Statement> statement;
+        if (expression.empty()) {
+            statement = _statements->acquire(
+                ALBUM_COLUMNS + "FROM albums al "
+                  "WHERE al.title LIKE ? AND al.user_id = ? "
+                  "ORDER BY al.title LIMIT ?;");
+            statement->bind(1, "%" + query + "%");
+        } else {
+            statement = _statements->acquire(
+                ALBUM_COLUMNS + "FROM search_index "
+                + "JOIN albums al ON al.id = search_index.entity_id "
+                + searchClause("album"));
+            statement->bind(1, expression);
+        }
+        statement->bind(2, user_id);
+        statement->bind(3, static_cast<int64_t>(limit));
+
+        while (statement->executeStep())
+            albums.push_back(readAlbum(*statement));
+
+        return albums;
+    }
+
+    std::vector<ArtistSummary>
+    SummaryRepository::searchArtists(const std::string& query,
+                                     unsigned user_id,
+                                     size_t limit) const {
+        std::vector<ArtistSummary> artists;
+        if (!_statements || limit == 0)
+            return artists;
+
+        std::string expression = SearchIndex::toMatchExpression(query);
+        std::shared_ptr<SQLite::Statement> statement;
+        if (expression.empty()) {
+            statement = _statements->acquire(
+                ARTIST_COLUMNS + "FROM artists ar "
+                + "WHERE ar.name LIKE ? AND ar.user_id = ? "
+                  "ORDER BY ar.name LIMIT ?;");
+            statement->bind(1, "%" + query + "%");
+        } else {
+            statement = _statements->acquire(
+                ARTIST_COLUMNS + "FROM search_index "
+                + "JOIN artists ar ON ar.id = search_index.entity_id "
+                + searchClause("artist"));
+            statement->bind(1, expression);
+        }
+        statement->bind(2, user_id);
+        statement->bind(3, static_cast<int64_t>(limit));
+
+        while (statement->executeStep())
+            artists.push_back(readArtist(*statement));
+
+        return artists;
+    }
+
+    std::vector<SongSummary>
+    SummaryRepository::songsByIds(const std::vector<unsigned>& ids) const {
+        std::vector<SongSummary> songs;
+        if (!_statements || ids.empty())
+            return songs;
+
+        std::vector<unsigned> distinct(ids);
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                       distinct.end());
+
+        std::unordered_map<unsigned, SongSummary> found;
+        found.reserve(distinct.size());
+
+        _statements->forEachIdBatch(
+            distinct,
+            SONG_COLUMNS + "FROM songs s " + SONG_JOINS + "WHERE s.id IN (",
+            ";",
+            [&found](SQLite::Statement& statement) {
+                SongSummary summary = readSong(statement);
+                found.emplace(summary.id, std::move(summary));
+            });
+
+        songs.reserve(ids.size());
+        for (unsigned id : ids) {
+            auto it = found.find(id);
+            if (it != found.end())
+                songs.push_back(it->second);
+        }
+
+        return songs;
+    }
+
+    std::vector<SongSummary>
+    SummaryRepository::playlistSongs(unsigned playlist_id) const {
+        std::vector<SongSummary> songs;
+        if (!_statements)
+            return songs;
+
+        auto statement = _statements->acquire(
+            SONG_COLUMNS + "FROM playlist_songs ps "
+            + "JOIN songs s ON s.id = ps.song_id " + SONG_JOINS
+            + "WHERE ps.playlist_id = ? ORDER BY ps.position;");
+        statement->bind(1, playlist_id);
+
+        while (statement->executeStep())
+            songs.push_back(readSong(*statement));
+
+        return songs;
+    }
+}  // namespace core
@@ -0,0 +1,94 @@
+/**
+ * @file UnitOfWork.cpp
+ * @brief Implementação da transação entre repositórios
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-30
+ */
+
+#include "core/bd/UnitOfWork.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+
+#include <sqlite3.h>
+
+#include "core/bd/IdentityMap.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+namespace core {
+    UnitOfWork::UnitOfWork(std::shared_ptr<SQLite::Database> db)
+        : _db(db), _active(false) {
+        if (!sqlite3_get_autocommit(_db->getHandle())) {
+            // Nomes distintos mesmo entre unidades de threads diferentes
+            static std::atomic<unsigned> next_savepoint {0};
+            _savepoint = "unit_of_work_" + std::to_string(++next_savepoint);
+            _db->exec("SAVEPOINT " + _savepoint + ";");
+        } else {
+            _db->exec("BEGIN IMMEDIATE;");
+        }
+
+        _active = true;
+    }
+
+    UnitOfWork::~UnitOfWork() {
+        if (!_active)
+            return;
+
+        try {
+            rollback();
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao desfazer a unidade de trabalho: " << e.what()
+                      << std::endl;
+        }
+    }
+
+    void UnitOfWork::commit() {
+        if (!_active)
+            throw std::runtime_error("Unidade de trabalho já encerrada");
+
+        if (isNested())
+            _db->exec("RELEASE SAVEPOINT " + _savepoint + ";");
+        else
+            _db->exec("COMMIT;");
+
+        _active = false;
+    }
+
+    void UnitOfWork::rollback() {
+        if (!_active)
+            throw std::runtime_error("Unidade de trabalho já encerrada");
+
+        _active = false;
+        clearIdentityMaps();
+
+        if (isNested()) {
+            // ROLLBACK TO mantém o savepoint aberto; RELEASE o encerra
+            _db->exec("ROLLBACK TO SAVEPOINT " + _savepoint + ";");
+            _db->exec("RELEASE SAVEPOINT " + _savepoint + ";");
+        } else if (!sqlite3_get_autocommit(_db->getHandle())) {
+            // Alguns erros já desfazem a transação inteira no SQLite
+            _db->exec("ROLLBACK;");
+        }
+    }
+
+    bool UnitOfWork::isNested() const {
+        return !_savepoint.empty();
+    }
+
+    bool UnitOfWork::isActive() const {
+        return _active;
+    }
+
+    void UnitOfWork::clearIdentityMaps() {
+        IdentityMap<Song>::forDatabase(_db)->clear();
+        IdentityMap<Artist>::forDatabase(_db)->clear();
+        IdentityMap<Album>::forDatabase(_db)->clear();
+        IdentityMap<const User>::forDatabase(_db)->clear();
+    }
+}  // namespace core
@@ -9,30 +9,49 @@
 
 
 #include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
 
 
 #include <iostream>
 
 
 namespace core {
+    namespace {
+        using UserColumns = EntityTraits<User>;
+
+        // Músicas, álbuns e artistas do usuário são removidos em cascata
+        void clearOwnedEntities(const std::shared_ptr<SQLite::Database>& db) {
+            auto songs = IdentityMap<Song>::forDatabase(db);
+            if (songs)
+                songs->clear();
+            auto albums = IdentityMap<Album>::forDatabase(db);
+            if (albums)
+                albums->clear();
+            auto artists = IdentityMap<Artist>::forDatabase(db);
+            if (artists)
+                artists->clear();
+        }
+    }
+
     UserRepository::UserRepository(std::shared_ptr<SQLite::Database> db) :
-        SQLiteRepositoryBase<User>(db, "users") {}
+        SQLiteRepositoryBase<User>(db),
+        _shared_users(IdentityMap<const User>::forDatabase(db)) {}
 
     bool UserRepository::insert(User& entity) {
-        SQLite::Statement query(*_db,
-                                "INSERT INTO users (username, home_path, "
-                                "input_path, uid) "
-                                "VALUES (?, ?, ?, ?);");
-        query.bind(1, entity.getUsername());
-        query.bind(2, entity.getHomePath());
-        query.bind(3, entity.getInputPath());
+        static constexpr SqlText sql = UserColumns::insert();
+        auto query = prepare(sql);
+        query->bind(1, entity.getUsername());
+        query->bind(2, entity.getHomePath());
+        query->bind(3, entity.getInputPath());
         #if defined(_WIN32)
-                query.bind(4, entity.getUID());
+                query->bind(4, entity.getUID());
         #else
-                query.bind(4, std::to_string(entity.getUID()));
+                query->bind(4, std::to_string(entity.getUID()));
         #endif
 
-        bool success = query.exec() > 0;
+        bool success = query->exec() > 0;
         if (success)
             entity.setId(static_cast<unsigned>(getLastInsertId()));
 
@@ -40,21 +59,19 @@ namespace core {
     }
 
     bool UserRepository::update(const User& entity) {
-        SQLite::Statement query(*_db,
-                                "UPDATE users SET username = ?, home_path = "
-                                "?, input_path = ?, uid = ? "
-                                "WHERE id = ?;");
-        query.bind(1, entity.getUsername());
-        query.bind(2, entity.getHomePath());
-        query.bind(3, entity.getInputPath());
+        static constexpr SqlText sql = UserColumns::update();
+        auto query = prepare(sql);
+        query->bind(1, entity.getUsername());
+        query->bind(2, entity.getHomePath());
+        query->bind(3, entity.getInputPath());
         #if defined(_WIN32)
-                query.bind(4, entity.getUID());
+                query->bind(4, entity.getUID());
         #else
-                query.bind(4, std::to_string(entity.getUID()));
+                query->bind(4, std::to_string(entity.getUID()));
         #endif
-        query.bind(5, entity.getId());
+        query->bind(5, entity.getId());
 
-        return query.exec() > 0;
+        return query->exec() > 0;
     }
 
     bool UserRepository::save(User& entity) {
@@ -65,15 +82,50 @@ namespace core {
 
         if (entity.getId() == 0)
             return insert(entity);
-        else
-            return update(entity);
+
+        if (_shared_users)
+            _shared_users->invalidate(entity.getId());
+        return update(entity);
+    }
+
+    bool UserRepository::remove(unsigned id) {
+        if (_shared_users)
+            _shared_users->invalidate(id);
+        clearOwnedEntities(_db);
+        return SQLiteRepositoryBase<User>::remove(id);
+    }
+
+    bool UserRepository::removeAll() {
+        if (_shared_users)
+            _shared_users->clear();
+        clearOwnedEntities(_db);
+        return SQLiteRepositoryBase<User>::removeAll();
+    }
+
+    std::shared_ptr<const User> UserRepository::findSharedById(unsigned id) const {
+        if (!_shared_users)
+            return findById(id);
+
+        syncIdentityMap(*_shared_users);
+        auto user = _shared_users->find(id);
+        if (user)
+            return user;
+
+        user = findById(id);
+        if (!user)
+            return nullptr;
+
+        return _shared_users->insert(id, user);
     }
 
     std::shared_ptr<User> UserRepository::findByUsername(
         const std::string& username) const {
-        auto results = findBy("username", username);
-        if (!results.empty())
-            return results.front();
+        static constexpr SqlText sql = UserColumns::select() + " WHERE username = ?";
+        auto query = prepare(sql);
+        query->bind(1, username);
+
+        if (query->executeStep())
+            return mapRowToEntity(*query);
         return nullptr;
     }
 
@@ -84,22 +136,25 @@ namespace core {
         #else
             uid_str = std::to_string(uid);
         #endif
-        auto results = findBy("uid", uid_str);
-        if (!results.empty())
-            return results.front();
+        static constexpr SqlText sql = UserColumns::select() + " WHERE uid = ?";
+        auto query = prepare(sql);
+        query->bind(1, uid_str);
+
+        if (query->executeStep())
+            return mapRowToEntity(*query);
         return nullptr;
     }
 
     std::shared_ptr<User> UserRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = static_cast<unsigned>(query.getColumn("id").getInt());
-        std::string username = query.getColumn("username").getString();
-        std::string home_path = query.getColumn("home_path").getString();
-        std::string input_path = query.getColumn("input_path").getString();
+        unsigned id = UserColumns::read<UserColumns::Id>(query);
+        std::string username = UserColumns::read<UserColumns::Username>(query);
+        std::string home_path = UserColumns::read<UserColumns::HomePath>(query);
+        std::string input_path = UserColumns::read<UserColumns::InputPath>(query);
         userid uid;
         #if defined(_WIN32)
-            uid = query.getColumn("uid").getString();
+            uid = UserColumns::read<UserColumns::Uid>(query);
         #else
-            uid = static_cast<userid>(std::stoul(query.getColumn("uid").getString()));
+            uid = static_cast<userid>(std::stoul(UserColumns::read<UserColumns::Uid>(query)));
         #endif
 
         return std::make_shared<User>(id, username, home_path, input_path, uid);
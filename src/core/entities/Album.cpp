@@ -67,7 +67,7 @@ namespace core {
     Album::Album(const Album& other)
         : Entity(other.getId()),
           _title(other._title),
-          _user(other._user ? std::make_shared<User>(*other._user) : nullptr),
+          _user(other._user),
           _genre(other._genre),
           _year(other._year),
           _artist_id(other._artist_id),
@@ -76,6 +76,8 @@ namespace core {
           _songs(other._songs),
           _song_ids(other._song_ids),
           _songsLoaded(other._songsLoaded),
+          _songs_count_known(other._songs_count_known),
+          _songs_count(other._songs_count),
           songsLoader(other.songsLoader),
           artistLoader(other.artistLoader),
           featuringArtistsLoader(other.featuringArtistsLoader) {
@@ -138,6 +140,8 @@ namespace core {
     };
 
     size_t Album::getSongsCount() const {
+        if (!_songsLoaded && _songs_count_known)
+            return _songs_count;
         return static_cast<int>(loadSongs().size());
     };
 
@@ -171,6 +175,11 @@ namespace core {
         _artist_id = artist.getId();
     };
 
+    void Album::setSongsCount(size_t count) {
+        _songs_count = count;
+        _songs_count_known = true;
+    };
+
     void Album::setFeaturingArtists(const std::vector<Artist>& artists) {
         if (!artists.empty()) {
             throw std::invalid_argument("Parametro vazio");
@@ -204,6 +213,10 @@ namespace core {
         _user = std::make_shared<User>(user);
     };
 
+    void Album::setUser(std::shared_ptr<const User> user) {
+        _user = user;
+    };
+
     void Album::setArtistLoader(
         const std::function<std::shared_ptr<Artist>()>& loader) {
         if (!loader) {
@@ -25,6 +25,15 @@ namespace core {
           _user(std::make_shared<User>(user)) {
     }
 
+    Artist::Artist(unsigned id,
+                   std::string name,
+                   std::shared_ptr<const User> user)
+        : Entity(id),
+          _name(name),
+          _user(user),
+          _user_id(user ? user->getId() : 0) {
+    }
+
     Artist::Artist(unsigned id,
                    std::string name,
                    std::string genre,
@@ -51,7 +60,7 @@ namespace core {
         : Entity(other.getId()),
           _name(other._name),
           _genre(other._genre),
-          _user(other._user ? std::make_shared<User>(*other._user) : nullptr),
+          _user(other._user),
           _user_id(other._user_id),
           songsLoader([]() {
               return std::vector<std::shared_ptr<Song>>();
@@ -164,6 +173,11 @@ namespace core {
         _user_id = user.getId();
     };
 
+    void Artist::setUser(std::shared_ptr<const User> user) {
+        _user = user;
+        _user_id = user ? user->getId() : 0;
+    };
+
     void Artist::addSong(const Song& song) {
         if (!_songsLoaded)
             loadSongs();
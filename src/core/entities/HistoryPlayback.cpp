@@ -40,6 +40,15 @@ namespace core {
         _song(std::make_shared<Song>(song)),
         _played_at(played_at) {}
 
+    HistoryPlayback::HistoryPlayback(unsigned id,
+                                     std::shared_ptr<const User> user,
+                                     Song& song,
+                                     std::time_t played_at) :
+        Entity(id),
+        _user(user),
+        _song(std::make_shared<Song>(song)),
+        _played_at(played_at) {}
+
     HistoryPlayback::HistoryPlayback(User& user,
                                      Song& song,
                                      std::time_t played_at) :
@@ -56,6 +65,10 @@ namespace core {
         _user = std::make_shared<User>(user);
     }
 
+    void HistoryPlayback::setUser(std::shared_ptr<const User> user) {
+        _user = user;
+    }
+
     std::shared_ptr<const Song> HistoryPlayback::getSong() const {
         return _song;
     }
@@ -72,6 +85,14 @@ namespace core {
         _played_at = played_at;
     }
 
+    unsigned HistoryPlayback::getPlayDuration() const {
+        return _play_duration;
+    }
+
+    void HistoryPlayback::setPlayDuration(unsigned play_duration) {
+        _play_duration = play_duration;
+    }
+
     std::string HistoryPlayback::toString() const {
         return "HistoryPlayback{id=" + std::to_string(getId()) +
                ", user=" + (_user ? std::to_string(_user->getId()) : "null") +
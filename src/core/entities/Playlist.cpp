@@ -113,6 +113,7 @@ namespace core {
             return;
 
 		_songs.push_back(std::make_shared<Song>(song));
+		_songsChanged = true;
 	}
 
 	bool Playlist::removeSong(unsigned id) {
@@ -121,6 +122,7 @@ namespace core {
             if (_songs[i]->getId() == id) {
                 _songs.erase(_songs.begin() + static_cast<int>(i));
                 _song_ids.erase(id);
+                _songsChanged = true;
                 return true;
             }
         }
@@ -203,6 +205,10 @@ namespace core {
 		_user = std::make_shared<User>(user);
 	}
 
+	void Playlist::setUser(std::shared_ptr<const User> user) {
+		_user = user;
+	}
+
 	bool Playlist::containsSong(unsigned songId) const {
         loadSongs();
         return _song_ids.find(songId) != _song_ids.end();
@@ -223,6 +229,7 @@ namespace core {
 
         _songs.insert(_songs.begin() + static_cast<int>(pos),
                       std::make_shared<Song>(song));
+        _songsChanged = true;
         return true;
 	}
 
@@ -245,6 +252,7 @@ namespace core {
             }
         }
 
+        _songsChanged = _songsChanged || inserted;
         return inserted;
     }
 
@@ -267,6 +275,7 @@ namespace core {
             }
         }
 
+        _songsChanged = _songsChanged || inserted;
         return inserted;
     }
 
@@ -288,6 +297,7 @@ namespace core {
             }
         }
 
+        _songsChanged = _songsChanged || inserted;
         return inserted;
     }
 
@@ -310,6 +320,7 @@ namespace core {
             }
         }
 
+        _songsChanged = _songsChanged || inserted;
         return inserted;
     }
 
@@ -352,4 +363,42 @@ namespace core {
     bool Playlist::pushFront(const Playlist &playlist) {
         return insert(playlist, 0);
     }
+
+    void Playlist::switchSong(unsigned id, unsigned index) {
+        loadSongs();
+
+        auto it = std::find_if(_songs.begin(), _songs.end(),
+                               [id](const std::shared_ptr<Song>& song) {
+                                   return song && song->getId() == id;
+                               });
+        if (it == _songs.end())
+            return;
+
+        moveSong(static_cast<unsigned>(it - _songs.begin()), index);
+    }
+
+    void Playlist::moveSong(unsigned fromIndex, unsigned toIndex) {
+        loadSongs();
+
+        if (fromIndex >= _songs.size())
+            throw std::out_of_range("Índice fora dos limites: " + std::to_string(fromIndex));
+
+        if (toIndex >= _songs.size())
+            toIndex = static_cast<unsigned>(_songs.size() - 1);
+        if (fromIndex == toIndex)
+            return;
+
+        auto song = _songs[fromIndex];
+        _songs.erase(_songs.begin() + static_cast<int>(fromIndex));
+        _songs.insert(_songs.begin() + static_cast<int>(toIndex), song);
+        _songsChanged = true;
+    }
+
+    bool Playlist::hasSongChanges() const {
+        return _songsLoaded && _songsChanged;
+    }
+
+    void Playlist::clearSongChanges() const {
+        _songsChanged = false;
+    }
 }
@@ -58,8 +58,11 @@ namespace core {
           _duration(other._duration),
           _year(other._year),
           _track_number(other._track_number),
+          _bitrate(other._bitrate),
+          _sample_rate(other._sample_rate),
+          _file_size(other._file_size),
           _genre(other._genre),
-          _user(other._user ? std::make_shared<User>(*other._user) : nullptr),
+          _user(other._user),
           _artist_id(other._artist_id),
           _album_id(other._album_id),
           _artist(other._artist),
@@ -165,6 +168,18 @@ namespace core {
         return _year;
     };
 
+    unsigned Song::getBitrate() const {
+        return _bitrate;
+    };
+
+    unsigned Song::getSampleRate() const {
+        return _sample_rate;
+    };
+
+    uint64_t Song::getFileSize() const {
+        return _file_size;
+    };
+
     unsigned Song::getTrackNumber() const {
         return _track_number;
     };
@@ -179,6 +194,10 @@ namespace core {
         _user = std::make_shared<User>(user);
     };
 
+    void Song::setUser(std::shared_ptr<const User> user) {
+        _user = user;
+    };
+
     void Song::setTitle(const std::string& title) {
         if (title.empty()) {
             throw std::invalid_argument(
@@ -240,6 +259,18 @@ namespace core {
         _duration = sec;
     };
 
+    void Song::setBitrate(unsigned bitrate) {
+        _bitrate = bitrate;
+    };
+
+    void Song::setSampleRate(unsigned sample_rate) {
+        _sample_rate = sample_rate;
+    };
+
+    void Song::setFileSize(uint64_t file_size) {
+        _file_size = file_size;
+    };
+
     void Song::setAlbumId(unsigned id) {
         _album_id = id;
     }
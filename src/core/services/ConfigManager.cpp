@@ -8,7 +8,9 @@
  */
 
 #include "core/services/ConfigManager.hpp"
+#include "core/bd/IdentityMap.hpp"
 
+#include <cctype>
 #include <string>
 #include <filesystem>
 #include <fstream>
@@ -82,6 +84,100 @@ namespace core {
         return _config_data["database"]["schema_path"].get<std::string>();
     }
 
+    size_t ConfigManager::databaseIdentityMapEntries() const {
+        if (!_config_data.contains("database")) {
+            throw std::runtime_error("Database configuration not found");
+        }
+
+        // "identity_map_size" é o nome antigo da mesma contagem
+        const auto& database = _config_data["database"];
+        size_t entries = database.value("identity_map_size",
+                                        static_cast<size_t>(IDENTITY_MAP_ENTRIES_DEFAULT));
+        return database.value("identity_map_entries", entries);
+    }
+
+    DatabaseSettings ConfigManager::databaseSettings() const {
+        if (!_config_data.contains("database")) {
+            throw std::runtime_error("Database configuration not found");
+        }
+
+        const auto& database = _config_data["database"];
+        DatabaseSettings settings;
+        settings.wal = database.value("wal", settings.wal);
+        settings.synchronous = database.value("synchronous", settings.synchronous);
+        settings.cache_size = database.value("cache_size", settings.cache_size);
+        settings.mmap_size = database.value("mmap_size", settings.mmap_size);
+        settings.busy_timeout_ms = database.value("busy_timeout_ms",
+                                                  settings.busy_timeout_ms);
+        settings.reader_pool_size = database.value("reader_pool_size",
+                                                   settings.reader_pool_size);
+        settings.profile = database.value("profile", settings.profile);
+        settings.slow_query_ms = database.value("slow_query_ms",
+                                                settings.slow_query_ms);
+        settings.slow_query_log = database.value("slow_query_log",
+                                                 settings.slow_query_log);
+        settings.memory_mirror = database.value("memory_mirror",
+                                                settings.memory_mirror);
+        settings.mirror_flush_ms = database.value("mirror_flush_ms",
+                                                  settings.mirror_flush_ms);
+        settings.identity_map_entries = databaseIdentityMapEntries();
+
+        for (auto& c : settings.synchronous)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+        return settings;
+    }
+
+    size_t ConfigManager::ingestThreads() const {
+        if (!_config_data.contains("ingest"))
+            return INGEST_THREADS_DEFAULT;
+
+        return _config_data["ingest"].value("threads",
+                                            static_cast<size_t>(INGEST_THREADS_DEFAULT));
+    }
+
+    size_t ConfigManager::ingestQueueSize() const {
+        if (!_config_data.contains("ingest"))
+            return INGEST_QUEUE_SIZE_DEFAULT;
+
+        return _config_data["ingest"].value("queue_size",
+                                            static_cast<size_t>(INGEST_QUEUE_SIZE_DEFAULT));
+    }
+
+    std::vector<std::string> ConfigManager::ingestExtensions() const {
+        static const std::vector<std::string> defaults = {
+            "mp3", "flac", "ogg", "oga", "opus", "wav", "m4a", "aac",
+            "wma", "aif", "aiff", "ape", "wv", "mpc"};
+
+        if (!_config_data.contains("ingest"))
+            return defaults;
+
+        return _config_data["ingest"].value("extensions", defaults);
+    }
+
+    bool ConfigManager::watchEnabled() const {
+        if (!_config_data.contains("watch"))
+            return false;
+
+        return _config_data["watch"].value("enabled", false);
+    }
+
+    size_t ConfigManager::watchDebounceMs() const {
+        if (!_config_data.contains("watch"))
+            return WATCH_DEBOUNCE_MS_DEFAULT;
+
+        return _config_data["watch"].value("debounce_ms",
+                                           static_cast<size_t>(WATCH_DEBOUNCE_MS_DEFAULT));
+    }
+
+    size_t ConfigManager::watchMaxBatch() const {
+        if (!_config_data.contains("watch"))
+            return WATCH_MAX_BATCH_DEFAULT;
+
+        return _config_data["watch"].value("max_batch",
+                                           static_cast<size_t>(WATCH_MAX_BATCH_DEFAULT));
+    }
+
     void ConfigManager::validateConfigPaths() const {
         if (!_config_data.contains("paths")) {
             throw std::runtime_error("Paths configuration not found");
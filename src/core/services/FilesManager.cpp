@@ -1,13 +1,78 @@
 #include "core/services/FilesManager.hpp"
 #include "core/bd/DatabaseManager.hpp"
 #include "core/bd/RepositoryFactory.hpp"
+#include "core/bd/UnitOfWork.hpp"
 #include "core/entities/User.hpp"
+#include "core/util/BoundedQueue.hpp"
+#include "core/util/DirectoryScanner.hpp"
 #include "core/util/UnicodeHelper.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <ostream>
+#include <thread>
+#include <unordered_set>
+#include <utility>
 
 namespace core {
+    namespace {
+        /**
+         * @brief Caminho em UTF-8, como gravado nas impressões
+         */
+        std::string pathString(const fs::path& path) {
+#ifdef _WIN32
+            // No Windows, path::string() pode não funcionar com Unicode
+            // Use path::u8string() ou converta via wstring
+            return UnicodeHelper::fromWide(path.wstring());
+#else
+            // No Linux/Mac, string() já é UTF-8
+            return path.string();
+#endif
+        }
+
+        /**
+         * @brief Prefixo dos caminhos dentro de um diretório, com separador final
+         */
+        std::string directoryPrefix(const fs::path& directory) {
+            std::string prefix = pathString(directory);
+            if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\')
+                prefix += static_cast<char>(fs::path::preferred_separator);
+            return prefix;
+        }
+
+        enum class FileChange {
+            Added,     /*!< @brief Nunca visto */
+            Modified,  /*!< @brief Conteúdo diferente */
+            Touched,   /*!< @brief Data ou inode diferentes, mesmo conteúdo */
+            Unchanged  /*!< @brief Mesmo stat() */
+        };
+
+        /**
+         * @brief Compara a impressão atual de um arquivo com a gravada
+         *
+         * Só lê o arquivo quando o tamanho é igual e a data ou o inode não:
+         * nesse caso preenche o hash da impressão atual. Um arquivo cuja
+         * importação falhou é lido de novo quando tocado. Não acessa o banco.
+         */
+        FileChange compareFingerprint(FileFingerprint& current, const FileFingerprint* stored) {
+            if (!stored)
+                return FileChange::Added;
+            if (stored->sameStat(current))
+                return FileChange::Unchanged;
+
+            // Mesmo tamanho com data ou inode diferentes: cópia ou touch
+            if (stored->size == current.size) {
+                current.hash_prefix = FileFingerprint::hashPrefix(current.path);
+                if (current.hash_prefix == stored->hash_prefix)
+                    return stored->failed ? FileChange::Modified : FileChange::Touched;
+            }
+
+            return FileChange::Modified;
+        }
+    }  // namespace
+
     FilesManager::FilesManager(ConfigManager& config,
                                std::shared_ptr<SongRepository> songRepo,
                                std::shared_ptr<ArtistRepository> artistRepo,
@@ -18,38 +83,44 @@ namespace core {
           _albumRepo(albumRepo),
           _usersManager(config) {
         DatabaseManager db_manager(_config.databasePath(),
-                                   _config.databaseSchemaPath());
+                                   _config.databaseSchemaPath(),
+                                   _config.databaseSettings());
 
-        RepositoryFactory repo_factory(db_manager.getDatabase());
+        _db = db_manager.getDatabase();
+        RepositoryFactory repo_factory(_db);
         _songRepo = repo_factory.createSongRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _albumRepo = repo_factory.createAlbumRepository();
         _userRepo = repo_factory.createUserRepository();
+        _scannedRepo = repo_factory.createScannedFileRepository();
     }
 
     FilesManager::FilesManager(ConfigManager& config)
         : _config(config),
           _usersManager(config) {
         DatabaseManager db_manager(_config.databasePath(),
-                                   _config.databaseSchemaPath());
+                                   _config.databaseSchemaPath(),
+                                   _config.databaseSettings());
 
-        RepositoryFactory repo_factory(db_manager.getDatabase());
+        _db = db_manager.getDatabase();
+        RepositoryFactory repo_factory(_db);
         _songRepo = repo_factory.createSongRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _albumRepo = repo_factory.createAlbumRepository();
         _userRepo = repo_factory.createUserRepository();
+        _scannedRepo = repo_factory.createScannedFileRepository();
     }
 
     FilesManager::FilesManager(ConfigManager& config, SQLite::Database& db)
         : _config(config),
           _usersManager(config, db) {
-        RepositoryFactory repo_factory(
-            std::shared_ptr<SQLite::Database>(&db, [](SQLite::Database*) {
-            }));
+        _db = std::shared_ptr<SQLite::Database>(&db, [](SQLite::Database*) {});
+        RepositoryFactory repo_factory(_db);
         _songRepo = repo_factory.createSongRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _albumRepo = repo_factory.createAlbumRepository();
         _userRepo = repo_factory.createUserRepository();
+        _scannedRepo = repo_factory.createScannedFileRepository();
     }
 
     std::string FilesManager::cleanString(const std::string& str) {
@@ -71,28 +142,39 @@ namespace core {
         }
     }
 
-    std::shared_ptr<Song>
-    FilesManager::readMetadata(TagLib::FileRef file,
-                               User& user,
-                               const std::string& sourceFilePath) {
-        if (file.isNull() || !file.tag()) {
+    std::optional<FilesManager::TrackMetadata>
+    FilesManager::readMetadata(const std::string& filePath) {
+        // Fast basta para duração e taxas; Average e Accurate podem ler o
+        // arquivo inteiro em MP3 sem cabeçalho Xing/VBRI
+        TagLib::FileRef file(filePath.c_str(), true, TagLib::AudioProperties::Fast);
+        if (file.isNull() || !file.audioProperties()) {
+            return std::nullopt;
+        }
+
+        if (!file.tag()) {
             throw std::invalid_argument("Arquivo sem metadados");
         }
 
         TagLib::Tag* tag = file.tag();
 
-        std::shared_ptr<Song> song = std::make_shared<Song>();
-
-        song->setTitle(tag->title().isEmpty() ? "Unknown Title"
-                                              : tag->title().toCString(true));
-        song->setGenre(tag->genre().isEmpty() ? "Unknown Genre"
-                                              : tag->genre().toCString());
-        song->setYear(tag->year() == 0 ? 1900 : tag->year());
-        song->setTrackNumber(tag->track() == 0 ? 1 : tag->track());
-        song->setUser(user);
-        song->setDuration(file.audioProperties()
-                              ? file.audioProperties()->lengthInSeconds()
-                              : 0);
+        TrackMetadata metadata;
+        metadata.sourceFilePath = filePath;
+        metadata.title = tag->title().isEmpty() ? "Unknown Title"
+                                                : tag->title().toCString(true);
+        metadata.genre = tag->genre().isEmpty() ? "Unknown Genre"
+                                                : tag->genre().toCString();
+        metadata.year = tag->year() == 0 ? 1900 : tag->year();
+        metadata.track = tag->track() == 0 ? 1 : tag->track();
+        TagLib::AudioProperties* properties = file.audioProperties();
+        metadata.duration = properties->lengthInSeconds();
+        metadata.bitrate = std::max(0, properties->bitrate());
+        metadata.sampleRate = std::max(0, properties->sampleRate());
+
+        std::error_code error;
+        uintmax_t size = fs::file_size(UnicodeHelper::toPath(filePath), error);
+        metadata.fileSize = error ? 0 : static_cast<uint64_t>(size);
+        metadata.albumTitle =
+            tag->album().isEmpty() ? "Singles" : tag->album().toCString(true);
 
         std::string artistNames = tag->artist().isEmpty()
                                       ? "Unknown Artist"
@@ -108,20 +190,42 @@ namespace core {
             }
         }
 
-        // Processa lista de artistas
         std::stringstream ss(artistNames);
         std::string artistName;
-        std::vector<std::shared_ptr<Artist>> featuring;
-        bool mainArtistDefined = false;
-
-        std::shared_ptr<Artist> mainArtist;
         while (std::getline(ss, artistName, '/')) {
             artistName = cleanString(artistName); // trim
 
-            if (artistName.empty()) {
-                continue;
+            if (!artistName.empty()) {
+                metadata.artistNames.push_back(artistName);
             }
+        }
+
+        return metadata;
+    }
+
+    std::shared_ptr<Song>
+    FilesManager::importTrack(const TrackMetadata& metadata, User& user) {
+        // Desfeita no destrutor se algo falhar antes do commit
+        UnitOfWork unit(_db);
+
+        std::shared_ptr<Song> song = std::make_shared<Song>();
+
+        song->setTitle(metadata.title);
+        song->setGenre(metadata.genre);
+        song->setYear(metadata.year);
+        song->setTrackNumber(metadata.track);
+        song->setUser(user);
+        song->setDuration(metadata.duration);
+        song->setBitrate(metadata.bitrate);
+        song->setSampleRate(metadata.sampleRate);
+        song->setFileSize(metadata.fileSize);
+
+        // Processa lista de artistas
+        std::vector<std::shared_ptr<Artist>> featuring;
+        bool mainArtistDefined = false;
 
+        std::shared_ptr<Artist> mainArtist;
+        for (const std::string& artistName : metadata.artistNames) {
             std::vector<std::shared_ptr<Artist>> artists =
                 _artistRepo->findByName(artistName);
             std::shared_ptr<Artist> artist;
@@ -147,8 +251,7 @@ namespace core {
             throw std::runtime_error("Nenhum artista encontrado nos metadados");
         }
 
-        std::string albumTitle =
-            tag->album().isEmpty() ? "Singles" : tag->album().toCString(true);
+        const std::string& albumTitle = metadata.albumTitle;
         std::vector<std::shared_ptr<Album>> albums =
             _albumRepo->findByArtist(mainArtist->getName());
         std::shared_ptr<Album> album;
@@ -168,7 +271,7 @@ namespace core {
             album = std::make_shared<Album>(
                 albumTitle, song->getGenre(), *mainArtist);
             album->setYear(song->getYear());
-            album->setUser(*song->getUser());
+            album->setUser(song->getUser());
 
             _albumRepo->save(*album);
             _albumRepo->setPrincipalArtist(
@@ -183,11 +286,24 @@ namespace core {
             _songRepo->addFeaturingArtist(*song, *feat, user);
         }
 
+        const std::string& sourceFilePath = metadata.sourceFilePath;
         std::string destinationPath = song->getAudioFilePath();
+
+        // O arquivo sai do diretório de entrada, o único que as varreduras
+        // consultam: nenhuma impressão é guardada para o destino
         if (!sourceFilePath.empty()) {
+            _scannedRepo->remove(sourceFilePath);
             move(sourceFilePath, destinationPath);
         }
 
+        try {
+            unit.commit();
+        } catch (const std::exception&) {
+            if (!sourceFilePath.empty())
+                move(destinationPath, sourceFilePath);
+            throw;
+        }
+
         return song;
     }
 
@@ -205,14 +321,287 @@ namespace core {
         }
     }
 
-    void FilesManager::update() {
+    size_t FilesManager::ingestThreadCount() const {
+        size_t threads = _config.ingestThreads();
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        return threads;
+    }
+
+    FilesManager::TrackMetadata FilesManager::readTrack(const std::string& filePath) {
+        TrackMetadata metadata;
+        try {
+            auto parsed = readMetadata(filePath);
+            if (parsed)
+                metadata = std::move(*parsed);
+            else
+                metadata.audio = false;
+        } catch (const std::exception& e) {
+            metadata.error = e.what();
+        }
+        metadata.sourceFilePath = filePath;
+
+        if (auto fingerprint = FileFingerprint::stat(filePath)) {
+            fingerprint->hash_prefix = FileFingerprint::hashPrefix(filePath);
+            metadata.fingerprint = std::move(*fingerprint);
+        }
+        return metadata;
+    }
+
+    void FilesManager::importRead(const TrackMetadata& metadata, User& user) {
+        // Não importado: só é lido de novo se o arquivo mudar, ou também se
+        // for tocado quando a causa foi um erro
+        auto remember = [&](bool failed) {
+            if (metadata.fingerprint.path.empty())
+                return;
+
+            FileFingerprint fingerprint = metadata.fingerprint;
+            fingerprint.failed = failed;
+            try {
+                _scannedRepo->save(fingerprint, user.getId());
+            } catch (const std::exception& e) {
+                std::cerr << "Erro ao registrar arquivo '" << metadata.sourceFilePath
+                          << "': " << e.what() << std::endl;
+            }
+        };
+
+        if (!metadata.audio || !metadata.error.empty()) {
+            if (!metadata.error.empty()) {
+                std::cerr << "Erro ao processar arquivo '" << metadata.sourceFilePath
+                          << "': " << metadata.error << std::endl;
+            }
+            remember(!metadata.error.empty());
+            return;
+        }
+
+        try {
+            if (!importTrack(metadata, user)) {
+                std::cerr << "Metadados insuficientes para arquivo '"
+                          << metadata.sourceFilePath << "', pulando." << std::endl;
+                remember(false);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao processar arquivo '" << metadata.sourceFilePath
+                      << "': " << e.what() << std::endl;
+            remember(true);
+        }
+    }
+
+    void FilesManager::ingest(const std::vector<std::string>& files, User& user) {
+        size_t threads = std::min(ingestThreadCount(), files.size());
+
+        if (threads <= 1) {
+            for (const auto& filePath : files)
+                importRead(readTrack(filePath), user);
+            return;
+        }
+
+        // Leitura das tags em paralelo; banco e arquivos só nesta thread, o
+        // que mantém a resolução de artistas e álbuns sem disputa
+        BoundedQueue<TrackMetadata> results(_config.ingestQueueSize());
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> running(threads);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([&]() {
+                for (size_t index = next++; index < files.size(); index = next++) {
+                    if (!results.push(readTrack(files[index])))
+                        break;
+                }
+
+                if (--running == 0)
+                    results.close();
+            });
+        }
+
+        try {
+            while (auto metadata = results.pop())
+                importRead(*metadata, user);
+        } catch (...) {
+            results.close();
+            for (auto& worker : workers)
+                worker.join();
+            throw;
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    void FilesManager::ingestDirectory(const std::string& inputDir, User& user) {
+        fs::path inputDirPath = UnicodeHelper::toPath(inputDir);
+        const auto known = _scannedRepo->findUnder(directoryPrefix(inputDirPath));
+
+        std::mutex seenMutex;
+        std::unordered_set<std::string> seen;
+        std::atomic<size_t> unchanged(0);
+
+        // Nas threads da varredura: só stat() e comparação com a impressão.
+        // Um arquivo tocado volta com refreshOnly e a impressão a regravar;
+        // um novo ou modificado volta só com o caminho, para ser lido
+        auto inspect = [&](const std::string& filePath) -> std::optional<TrackMetadata> {
+            auto current = FileFingerprint::stat(filePath);
+            if (!current)
+                return std::nullopt;
+
+            {
+                std::lock_guard<std::mutex> lock(seenMutex);
+                seen.insert(filePath);
+            }
+
+            TrackMetadata inspected;
+            inspected.sourceFilePath = filePath;
+
+            auto found = known.find(filePath);
+            switch (compareFingerprint(*current, found == known.end() ? nullptr : &found->second)) {
+                case FileChange::Unchanged:
+                    unchanged++;
+                    return std::nullopt;
+                case FileChange::Touched:
+                    inspected.refreshOnly = true;
+                    inspected.fingerprint = std::move(*current);
+                    break;
+                default:
+                    break;
+            }
+            return inspected;
+        };
+
+        // Nesta thread: banco e arquivos
+        auto record = [&](const TrackMetadata& metadata) {
+            if (metadata.refreshOnly) {
+                _scannedRepo->save(metadata.fingerprint, user.getId());
+                _lastScan.unchanged++;
+                return;
+            }
+
+            if (known.count(metadata.sourceFilePath))
+                _lastScan.modified++;
+            else
+                _lastScan.added++;
+            importRead(metadata, user);
+        };
+
+        size_t threads = ingestThreadCount();
+        DirectoryScanner scanner(_config.ingestExtensions(), threads);
+
+        if (threads <= 1) {
+            scanner.scan(inputDir, [&](const std::string& filePath) {
+                if (auto metadata = inspect(filePath))
+                    record(metadata->refreshOnly ? *metadata : readTrack(filePath));
+                return true;
+            });
+        } else {
+            // A varredura só compara impressões; os arquivos a ler vão para
+            // as threads de leitura das tags, de modo que um diretório plano,
+            // percorrido por uma única thread da varredura, também é lido em
+            // paralelo. Os resultados chegam aqui à medida que ficam prontos
+            BoundedQueue<std::string> toRead(_config.ingestQueueSize());
+            BoundedQueue<TrackMetadata> results(_config.ingestQueueSize());
+            std::atomic<size_t> running(threads + 1);
+            std::exception_ptr failure;
+
+            std::thread producer([&]() {
+                try {
+                    scanner.scan(inputDir, [&](const std::string& filePath) {
+                        auto metadata = inspect(filePath);
+                        if (!metadata)
+                            return true;
+                        if (metadata->refreshOnly)
+                            return results.push(std::move(*metadata));
+                        return toRead.push(filePath);
+                    });
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                toRead.close();
+
+                if (--running == 0)
+                    results.close();
+            });
+
+            std::vector<std::thread> readers;
+            readers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                readers.emplace_back([&]() {
+                    while (auto filePath = toRead.pop()) {
+                        // Importação interrompida: a varredura também para
+                        if (!results.push(readTrack(*filePath))) {
+                            toRead.close();
+                            break;
+                        }
+                    }
+
+                    if (--running == 0)
+                        results.close();
+                });
+            }
+
+            auto joinAll = [&]() {
+                producer.join();
+                for (auto& reader : readers)
+                    reader.join();
+            };
+
+            try {
+                while (auto metadata = results.pop())
+                    record(*metadata);
+            } catch (...) {
+                results.close();
+                joinAll();
+                throw;
+            }
+
+            joinAll();
+            if (failure)
+                std::rethrow_exception(failure);
+        }
+
+        _lastScan.unchanged += unchanged;
+
+        // O que não foi encontrado não está mais no diretório
+        UnitOfWork unit(_db);
+        for (const auto& [path, stored] : known) {
+            if (seen.count(path))
+                continue;
+            _scannedRepo->remove(path);
+            _lastScan.removed++;
+        }
+        unit.commit();
+    }
+
+    bool FilesManager::hasChanged(FileFingerprint& current,
+                                  const FileFingerprint* stored,
+                                  User& user) {
+        switch (compareFingerprint(current, stored)) {
+            case FileChange::Added:
+                _lastScan.added++;
+                return true;
+            case FileChange::Modified:
+                _lastScan.modified++;
+                return true;
+            case FileChange::Touched:
+                _scannedRepo->save(current, user.getId());
+                _lastScan.unchanged++;
+                return false;
+            case FileChange::Unchanged:
+                _lastScan.unchanged++;
+                return false;
+        }
+
+        return false;
+    }
+
+    std::vector<std::shared_ptr<User>> FilesManager::scanUsers() {
         std::vector<std::shared_ptr<User>> allUsers;
 
         if (_userRepo) {
             allUsers = _userRepo->getAll();
         } else {
             std::cerr << "ERRO: _userRepo é NULL!" << std::endl;
-            return;
+            return allUsers;
         }
 
         if (allUsers.empty()) {
@@ -229,11 +618,19 @@ namespace core {
             }
         }
 
-        for (const auto& user : allUsers) {
-            if (!user || user->getId() == 0) {
-                continue;
-            }
+        allUsers.erase(std::remove_if(allUsers.begin(), allUsers.end(),
+                                      [](const std::shared_ptr<User>& user) {
+                                          return !user || user->getId() == 0;
+                                      }),
+                       allUsers.end());
+        return allUsers;
+    }
 
+    void FilesManager::update() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _lastScan = ScanReport();
+
+        for (const auto& user : scanUsers()) {
             std::string inputDir = user->getInputPath();
 
             verifyDir(inputDir);
@@ -243,52 +640,68 @@ namespace core {
                 continue;
             }
 
-            int fileCount = 0;
-            for (const auto& entry : fs::directory_iterator(inputDirPath)) {
-                if (!fs::is_regular_file(entry.status())) {
+            ingestDirectory(inputDir, *user);
+        }
+    }
+
+    size_t FilesManager::importFiles(const std::vector<std::string>& files) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _lastScan = ScanReport();
+
+        DirectoryScanner filter(_config.ingestExtensions());
+        size_t read = 0;
+        for (const auto& user : scanUsers()) {
+            std::string prefix = directoryPrefix(UnicodeHelper::toPath(user->getInputPath()));
+
+            std::vector<std::string> changed;
+            UnitOfWork unit(_db);
+            for (const auto& filePath : files) {
+                // Só os arquivos dentro do diretório de entrada do usuário
+                if (filePath.size() <= prefix.size()
+                    || filePath.compare(0, prefix.size(), prefix) != 0
+                    || !filter.accepts(filePath)) {
                     continue;
                 }
 
-                fileCount++;
-
-                std::string filePath;
-#ifdef _WIN32
-                // No Windows, path::string() pode não funcionar com Unicode
-                // Use path::u8string() ou converta via wstring
-                filePath = UnicodeHelper::fromWide(entry.path().wstring());
-#else
-                // No Linux/Mac, string() já é UTF-8
-                filePath = entry.path().string();
-#endif
-
-                TagLib::FileRef probe(filePath.c_str());
-                if (probe.isNull() || !probe.audioProperties()) {
+                auto current = FileFingerprint::stat(filePath);
+                if (!current) {
                     continue;
                 }
 
-                TagLib::FileRef f(filePath.c_str());
-                if (!f.isNull()) {
-                    std::shared_ptr<Song> song;
-                    try {
-                        song = readMetadata(f, *user, filePath);
-
-                        if (!song) {
-                            std::cerr
-                                << "Metadados insuficientes para arquivo '"
-                                << filePath << "', pulando." << std::endl;
-                            continue;
-                        }
-                    } catch (const std::exception& e) {
-                        std::cerr << "Erro ao processar arquivo '" << filePath
-                                  << "': " << e.what() << std::endl;
-                        continue;
-                    }
+                auto stored = _scannedRepo->find(filePath);
+                if (hasChanged(*current, stored ? &*stored : nullptr, *user)) {
+                    changed.push_back(filePath);
                 }
             }
+            unit.commit();
+
+            read += changed.size();
+            ingest(changed, *user);
         }
+
+        return read;
+    }
+
+    std::vector<std::string> FilesManager::inputDirectories() {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::vector<std::string> directories;
+        for (const auto& user : scanUsers()) {
+            std::string inputDir = user->getInputPath();
+            verifyDir(inputDir);
+            directories.push_back(inputDir);
+        }
+
+        return directories;
+    }
+
+    FilesManager::ScanReport FilesManager::getLastScan() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _lastScan;
     }
 
     bool FilesManager::isUpdated() {
+        std::lock_guard<std::mutex> lock(_mutex);
         std::shared_ptr<User> currentUser = _usersManager.getCurrentUser();
         std::shared_ptr<User> publicUser = _usersManager.getPublicUser();
 
@@ -303,6 +716,7 @@ namespace core {
         verifyDir(publicInput);
 
         std::string inputDirs[] = {userInput, publicInput};
+        DirectoryScanner scanner(_config.ingestExtensions());
 
         for (const auto& dir : inputDirs) {
             fs::path dirPath = UnicodeHelper::toPath(dir);
@@ -311,10 +725,20 @@ namespace core {
                 continue;
             }
 
-            for (const auto& entry : fs::directory_iterator(dirPath)) {
-                if (fs::is_regular_file(entry.status())) {
-                    return false; // Encontrou arquivo novo
+            auto known = _scannedRepo->findUnder(directoryPrefix(dirPath));
+            bool updated = true;
+            scanner.scan(dir, [&](const std::string& filePath) {
+                auto found = known.find(filePath);
+                auto current = FileFingerprint::stat(filePath);
+                if (found == known.end() || !current
+                    || !found->second.sameStat(*current)) {
+                    updated = false; // Encontrou arquivo novo ou modificado
                 }
+                return updated;
+            });
+
+            if (!updated) {
+                return false;
             }
         }
 
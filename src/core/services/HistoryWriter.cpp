@@ -0,0 +1,169 @@
+/**
+ * @file HistoryWriter.cpp
+ * @brief Implementação do gravador assíncrono do histórico de reprodução
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-22
+ */
+
+#include "core/services/HistoryWriter.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace core {
+    HistoryWriter::HistoryWriter(
+        std::shared_ptr<HistoryPlaybackRepository> history_repo,
+        size_t capacity,
+        size_t batch_size,
+        std::chrono::milliseconds interval)
+        : _history_repo(history_repo),
+          _ring(capacity > 0 ? capacity : 1),
+          _head(0),
+          _count(0),
+          _batch_size(batch_size > 0 ? batch_size : 1),
+          _interval(interval),
+          _writing(false),
+          _flush_requested(false),
+          _stopping(false),
+          _stopped(false) {
+        _worker = std::thread(&HistoryWriter::run, this);
+    }
+
+    HistoryWriter::~HistoryWriter() {
+        stop();
+    }
+
+    void HistoryWriter::record(const HistoryPlayback& entry) {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // Buffer cheio: a thread de gravação é acordada e esvazia o buffer,
+        // inclusive se stop() tiver sido chamado nesse meio tempo
+        if (_count == _ring.size() && !_stopped) {
+            _wake.notify_one();
+            _space.wait(lock, [this]() {
+                return _count < _ring.size() || _stopped;
+            });
+        }
+
+        if (_stopped) {
+            // A thread já foi encerrada: grava diretamente
+            std::vector<HistoryPlayback> batch {entry};
+            lock.unlock();
+            writeDirect(batch);
+            return;
+        }
+
+        _ring[(_head + _count) % _ring.size()] = entry;
+        _count++;
+
+        if (_count >= _batch_size || _count == _ring.size())
+            _wake.notify_one();
+    }
+
+    std::vector<HistoryPlayback> HistoryWriter::takePending() {
+        std::vector<HistoryPlayback> batch;
+        batch.reserve(_count);
+
+        while (_count > 0) {
+            batch.push_back(std::move(_ring[_head]));
+            _ring[_head] = HistoryPlayback();
+            _head = (_head + 1) % _ring.size();
+            _count--;
+        }
+
+        return batch;
+    }
+
+    void HistoryWriter::writeBatch(std::vector<HistoryPlayback>& batch) {
+        if (batch.empty() || !_history_repo)
+            return;
+
+        try {
+            if (!_history_repo->insertMultipleHistoryPlaybacks(batch))
+                std::cerr << "Erro ao gravar o histórico de reprodução: "
+                          << batch.size() << " registros perdidos" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao gravar o histórico de reprodução: "
+                      << e.what() << std::endl;
+        }
+    }
+
+    void HistoryWriter::writeDirect(std::vector<HistoryPlayback>& batch) {
+        std::lock_guard<std::mutex> lock(_direct_mutex);
+        writeBatch(batch);
+    }
+
+    void HistoryWriter::run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _wake.wait_for(lock, _interval, [this]() {
+                return _stopping || _flush_requested || _count >= _batch_size
+                       || _count == _ring.size();
+            });
+
+            if (_count > 0) {
+                auto batch = takePending();
+                _writing = true;
+                _space.notify_all();
+                lock.unlock();
+
+                writeBatch(batch);
+
+                lock.lock();
+                _writing = false;
+            }
+
+            _flush_requested = false;
+            _drained.notify_all();
+
+            if (_stopping && _count == 0)
+                break;
+        }
+    }
+
+    void HistoryWriter::flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (_stopped)
+            return;
+
+        _flush_requested = true;
+        _wake.notify_one();
+        _drained.wait(lock, [this]() { return _count == 0 && !_writing; });
+    }
+
+    void HistoryWriter::stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping)
+                return;
+            _stopping = true;
+        }
+
+        _wake.notify_one();
+        if (_worker.joinable())
+            _worker.join();
+
+        // Registros recebidos entre a última verificação da thread e o fim
+        // dela ficaram no buffer; são gravados antes de qualquer gravação
+        // direta posterior
+        std::lock_guard<std::mutex> direct_lock(_direct_mutex);
+        std::vector<HistoryPlayback> batch;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+            batch = takePending();
+        }
+        _space.notify_all();
+        _drained.notify_all();
+        writeBatch(batch);
+    }
+
+    size_t HistoryWriter::pending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+}  // namespace core
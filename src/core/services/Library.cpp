@@ -15,6 +15,7 @@ namespace core
         _albumRepo = repo_factory.createAlbumRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _playlistRepo = repo_factory.createPlaylistRepository();
+        _summaryRepo = repo_factory.createSummaryRepository();
     }
 
     Library::Library(const User &user, SQLite::Database &db) : _user(std::make_shared<User>(user))
@@ -24,16 +25,32 @@ namespace core
         _albumRepo = repo_factory.createAlbumRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _playlistRepo = repo_factory.createPlaylistRepository();
+        _summaryRepo = repo_factory.createSummaryRepository();
+    }
+
+    Library::Library(std::shared_ptr<core::User> user, DatabaseManager &db_manager)
+        : _user(user), _writer_db(db_manager.getDatabase())
+    {
+        RepositoryFactory repo_factory(db_manager.getReader());
+        _songRepo = repo_factory.createSongRepository();
+        _albumRepo = repo_factory.createAlbumRepository();
+        _artistRepo = repo_factory.createArtistRepository();
+        _playlistRepo = repo_factory.createPlaylistRepository();
+        _summaryRepo = repo_factory.createSummaryRepository();
     }
 
     Library::Library(ConfigManager &config)
     {
-        DatabaseManager db_manager(config.databasePath(), config.databaseSchemaPath());
-        RepositoryFactory repo_factory(db_manager.getDatabase());
+        DatabaseManager db_manager(config.databasePath(),
+                                   config.databaseSchemaPath(),
+                                   config.databaseSettings());
+        _writer_db = db_manager.getDatabase();
+        RepositoryFactory repo_factory(db_manager.getReader());
         _songRepo = repo_factory.createSongRepository();
         _albumRepo = repo_factory.createAlbumRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _playlistRepo = repo_factory.createPlaylistRepository();
+        _summaryRepo = repo_factory.createSummaryRepository();
 
         UsersManager users_manager(config, *db_manager.getDatabase());
         _public_user = users_manager.getPublicUser();
@@ -47,6 +64,7 @@ namespace core
         _albumRepo = repo_factory.createAlbumRepository();
         _artistRepo = repo_factory.createArtistRepository();
         _playlistRepo = repo_factory.createPlaylistRepository();
+        _summaryRepo = repo_factory.createSummaryRepository();
 
         UsersManager users_manager(config, db);
         _public_user = users_manager.getPublicUser();
@@ -57,21 +75,29 @@ namespace core
 
     std::shared_ptr<core::SongRepository> Library::getSongRepository() const
     {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createSongRepository();
         return _songRepo;
     }
 
     std::shared_ptr<core::ArtistRepository> Library::getArtistRepository() const
     {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createArtistRepository();
         return _artistRepo;
     }
 
     std::shared_ptr<core::AlbumRepository> Library::getAlbumRepository() const
     {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createAlbumRepository();
         return _albumRepo;
     }
 
     std::shared_ptr<core::PlaylistRepository> Library::getPlaylistRepository() const
     {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createPlaylistRepository();
         return _playlistRepo;
     }
 
@@ -101,34 +127,66 @@ namespace core
     }
 
     std::vector<std::shared_ptr<core::Song>> Library::searchSong(const std::string &query) const {
-        return _songRepo->findByTitleAndUser(query, *_user);
+        return _songRepo->search(query, *_user);
     }
 
     std::vector<std::shared_ptr<core::Artist>> Library::searchArtist(const std::string &query) const {
-        return _artistRepo->findByNameAndUser(query, *_user);
+        return _artistRepo->search(query, *_user);
     }
 
     std::vector<std::shared_ptr<core::Album>> Library::searchAlbum(const std::string &query) const {
-        return _albumRepo->findByTitleAndUser(query, *_user);
+        return _albumRepo->search(query, *_user);
     }
 
     std::vector<std::shared_ptr<core::Playlist>> Library::searchPlaylist(const std::string &query) const {
-        return _playlistRepo->findByTitleAndUser(query, *_user);
+        return _playlistRepo->search(query, *_user);
+    }
+
+    size_t Library::forEachSong(const SongRepository::RowCallback &callback) const {
+        return _songRepo->forEachByUser(*_user, callback);
+    }
+
+    std::vector<core::SongSummary> Library::searchSongSummaries(const std::string &query) const {
+        return _summaryRepo->searchSongs(query, _user->getId());
+    }
+
+    std::vector<core::ArtistSummary> Library::searchArtistSummaries(const std::string &query) const {
+        return _summaryRepo->searchArtists(query, _user->getId());
+    }
+
+    std::vector<core::AlbumSummary> Library::searchAlbumSummaries(const std::string &query) const {
+        return _summaryRepo->searchAlbums(query, _user->getId());
+    }
+
+    std::vector<core::SongSummary> Library::getSongSummaries(const std::vector<unsigned> &ids) const {
+        return _summaryRepo->songsByIds(ids);
+    }
+
+    std::vector<core::SongSummary> Library::getPlaylistSongSummaries(unsigned playlist_id) const {
+        return _summaryRepo->playlistSongs(playlist_id);
     }
 
     bool Library::persist(Song &song) {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createSongRepository()->save(song);
         return _songRepo->save(song);
     }
 
     bool Library::persist(Artist &artist) {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createArtistRepository()->save(artist);
         return _artistRepo->save(artist);
     }
 
     bool Library::persist(Album &album) {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createAlbumRepository()->save(album);
         return _albumRepo->save(album);
     }
 
     bool Library::persist(Playlist &playlist) {
+        if (_writer_db)
+            return RepositoryFactory(_writer_db).createPlaylistRepository()->save(playlist);
         return _playlistRepo->save(playlist);
     }
 
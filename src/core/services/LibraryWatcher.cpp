@@ -0,0 +1,333 @@
+/**
+ * @file LibraryWatcher.cpp
+ * @brief Implementação do observador dos diretórios de entrada
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-12-04
+ */
+
+#include "core/services/LibraryWatcher.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#ifdef __linux__
+    #include <cerrno>
+    #include <cstdint>
+    #include <cstring>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+#include "core/util/UnicodeHelper.hpp"
+
+namespace core {
+#ifdef __linux__
+    namespace {
+        // IN_CREATE só interessa para diretórios: um arquivo criado ainda
+        // está sendo escrito e chega depois com IN_CLOSE_WRITE
+        const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+        /**
+         * @brief Observa um diretório e todos os seus subdiretórios
+         *
+         * Links simbólicos para diretórios não são seguidos.
+         *
+         * @param fd Descritor do inotify
+         * @param root Diretório a observar
+         * @param watches Recebe o diretório de cada descritor de observação
+         * @param files Se não for nulo, recebe os arquivos já presentes
+         * @return false se nem o próprio diretório pôde ser observado
+         */
+        bool watchTree(int fd, const std::string& root,
+                       std::unordered_map<int, std::string>& watches,
+                       std::vector<std::string>* files) {
+            auto watch = [&](const std::string& directory) {
+                int wd = ::inotify_add_watch(fd, directory.c_str(), WATCH_MASK);
+                if (wd < 0) {
+                    std::cerr << "Erro ao observar o diretório '" << directory
+                              << "': " << std::strerror(errno) << std::endl;
+                    return false;
+                }
+                watches[wd] = directory;
+                return true;
+            };
+
+            if (!watch(root))
+                return false;
+
+            std::error_code error;
+            std::filesystem::recursive_directory_iterator it(
+                UnicodeHelper::toPath(root),
+                std::filesystem::directory_options::skip_permission_denied, error);
+            for (; !error && it != std::filesystem::recursive_directory_iterator();
+                 it.increment(error)) {
+                auto status = it->symlink_status(error);
+                if (error)
+                    break;
+
+                if (std::filesystem::is_directory(status)) {
+                    if (!watch(it->path().string()))
+                        it.disable_recursion_pending();
+                } else if (files && std::filesystem::is_regular_file(status)) {
+                    files->push_back(it->path().string());
+                }
+            }
+            return true;
+        }
+    }  // namespace
+#endif
+
+    LibraryWatcher::LibraryWatcher(BatchHandler handler,
+                                   std::chrono::milliseconds debounce,
+                                   size_t max_batch)
+        : _handler(std::move(handler)),
+          _debounce(debounce),
+          _max_batch(max_batch > 0 ? max_batch : 1),
+          _inotify_fd(-1),
+          _wake_fd(-1),
+          _stopping(false),
+          _rescan_requested(false) {}
+
+    LibraryWatcher::~LibraryWatcher() {
+        stop();
+    }
+
+    bool LibraryWatcher::isSupported() {
+#ifdef __linux__
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool LibraryWatcher::start(const std::vector<std::string>& directories) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stopWorker();
+
+#ifdef __linux__
+        _inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotify_fd < 0) {
+            std::cerr << "Erro ao iniciar o inotify: " << std::strerror(errno)
+                      << std::endl;
+            return false;
+        }
+
+        _wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_wake_fd < 0) {
+            std::cerr << "Erro ao iniciar o inotify: " << std::strerror(errno)
+                      << std::endl;
+            stopWorker();
+            return false;
+        }
+
+        std::unordered_map<int, std::string> watches;
+        for (const auto& directory : directories) {
+            std::error_code error;
+            if (!std::filesystem::is_directory(UnicodeHelper::toPath(directory), error))
+                continue;
+
+            if (watchTree(_inotify_fd, directory, watches, nullptr))
+                _directories.push_back(directory);
+        }
+
+        if (watches.empty()) {
+            stopWorker();
+            return false;
+        }
+
+        _stopping = false;
+        _rescan_requested = false;
+        _worker = std::thread(&LibraryWatcher::run, this, std::move(watches));
+        return true;
+#else
+        (void)directories;
+        return false;
+#endif
+    }
+
+    void LibraryWatcher::stop() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stopWorker();
+    }
+
+    bool LibraryWatcher::requestRescan() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_worker.joinable())
+            return false;
+
+#ifdef __linux__
+        _rescan_requested = true;
+        uint64_t one = 1;
+        if (::write(_wake_fd, &one, sizeof(one)) < 0) {
+            std::cerr << "Erro ao pedir a varredura: " << std::strerror(errno)
+                      << std::endl;
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    void LibraryWatcher::stopWorker() {
+#ifdef __linux__
+        if (_worker.joinable()) {
+            _stopping = true;
+            uint64_t one = 1;
+            if (::write(_wake_fd, &one, sizeof(one)) < 0)
+                std::cerr << "Erro ao encerrar o inotify: " << std::strerror(errno)
+                          << std::endl;
+            _worker.join();
+        }
+
+        if (_inotify_fd >= 0)
+            ::close(_inotify_fd);
+        if (_wake_fd >= 0)
+            ::close(_wake_fd);
+#endif
+        _inotify_fd = -1;
+        _wake_fd = -1;
+        _directories.clear();
+    }
+
+    bool LibraryWatcher::isRunning() const {
+        return _worker.joinable();
+    }
+
+    const std::vector<std::string>& LibraryWatcher::getDirectories() const {
+        return _directories;
+    }
+
+    void LibraryWatcher::run(std::unordered_map<int, std::string> directories) {
+#ifdef __linux__
+        using clock = std::chrono::steady_clock;
+
+        std::vector<std::string> pending;
+        std::unordered_set<std::string> seen;
+        bool rescan = false;
+        auto deadline = clock::time_point::max();
+
+        alignas(struct inotify_event) char buffer[16 * 1024];
+
+        while (true) {
+            int timeout = -1;
+            if (!pending.empty() || rescan) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                     deadline - clock::now())
+                                     .count();
+                timeout = static_cast<int>(std::clamp<long long>(
+                    remaining, 0, std::numeric_limits<int>::max()));
+            }
+
+            struct pollfd fds[2] = {{_inotify_fd, POLLIN, 0}, {_wake_fd, POLLIN, 0}};
+            if (::poll(fds, 2, timeout) < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "Erro ao aguardar o inotify: " << std::strerror(errno)
+                          << std::endl;
+                break;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                uint64_t count;
+                if (::read(_wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+                    std::cerr << "Erro ao ler o aviso do observador: "
+                              << std::strerror(errno) << std::endl;
+                if (_stopping)
+                    break;
+                if (_rescan_requested.exchange(false)) {
+                    rescan = true;
+                    deadline = clock::now();
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                ssize_t length;
+                while ((length = ::read(_inotify_fd, buffer, sizeof(buffer))) > 0) {
+                    for (char* next = buffer; next < buffer + length;) {
+                        const auto* event = reinterpret_cast<const struct inotify_event*>(next);
+                        next += sizeof(struct inotify_event) + event->len;
+
+                        // Fila perdida: a varredura completa é recursiva
+                        if (event->mask & IN_Q_OVERFLOW) {
+                            rescan = true;
+                            continue;
+                        }
+                        // Diretório observado removido ou movido para fora
+                        if (event->mask & IN_IGNORED) {
+                            directories.erase(event->wd);
+                            continue;
+                        }
+                        if (event->len == 0)
+                            continue;
+
+                        auto directory = directories.find(event->wd);
+                        if (directory == directories.end())
+                            continue;
+
+                        std::string path =
+                            (std::filesystem::path(directory->second) / event->name).string();
+
+                        if (event->mask & IN_ISDIR) {
+                            if (!(event->mask & (IN_CREATE | IN_MOVED_TO)))
+                                continue;
+
+                            // Pasta criada: os arquivos escritos antes de a
+                            // observação começar são listados aqui. Pasta
+                            // movida para dentro (um álbum): varredura completa
+                            std::vector<std::string> files;
+                            watchTree(_inotify_fd, path, directories,
+                                      (event->mask & IN_MOVED_TO) ? nullptr : &files);
+                            if (event->mask & IN_MOVED_TO)
+                                rescan = true;
+
+                            for (auto& file : files) {
+                                if (seen.insert(file).second)
+                                    pending.push_back(std::move(file));
+                            }
+                            continue;
+                        }
+                        if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+                            continue;
+
+                        if (seen.insert(path).second)
+                            pending.push_back(std::move(path));
+                    }
+                }
+
+                // Cada rajada de eventos adia a entrega
+                deadline = clock::now() + _debounce;
+            }
+
+            bool ready = rescan || !pending.empty();
+            if (!ready || (pending.size() < _max_batch && clock::now() < deadline))
+                continue;
+
+            // A varredura completa cobre também os pendentes
+            std::vector<std::string> batch;
+            if (!rescan)
+                batch.swap(pending);
+            pending.clear();
+            seen.clear();
+            rescan = false;
+            deadline = clock::time_point::max();
+
+            try {
+                _handler(batch);
+            } catch (const std::exception& e) {
+                std::cerr << "Erro ao importar os arquivos observados: " << e.what()
+                          << std::endl;
+            }
+        }
+#else
+        (void)directories;
+#endif
+    }
+}  // namespace core
@@ -12,6 +12,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <ctime>
 #include <algorithm>
 #include <random>
 #include <memory>
@@ -24,32 +25,49 @@ namespace core {
         : _current(0),
         _max_size(MAX_SIZE_DEFAULT),
         _aleatory(false),
-        _history_repo(nullptr),
         _current_user(nullptr) {}
     PlaybackQueue::PlaybackQueue(std::shared_ptr<User> current_user,
-                            std::shared_ptr<HistoryPlaybackRepository> history_repo,
+                            std::shared_ptr<HistoryWriter> history_writer,
                             size_t max_size)
     : _current(0),
       _max_size(max_size),
       _aleatory(false),
       _loop(false), 
-      _history_repo(history_repo),
-      _current_user(current_user) {}
+      _current_user(current_user),
+      _history_writer(history_writer) {}
 
     PlaybackQueue::PlaybackQueue(std::shared_ptr<User> current_user,
                                 const IPlayable& playable,
-                                std::shared_ptr<HistoryPlaybackRepository> history_repo,
+                                std::shared_ptr<HistoryWriter> history_writer,
                                 size_t max_size)
         : _current(0),
         _max_size(max_size),
         _aleatory(false),
-        _history_repo(history_repo),
-        _current_user(current_user) {
+        _current_user(current_user),
+        _history_writer(history_writer) {
         add(playable);
     }
 
     PlaybackQueue::~PlaybackQueue() = default;
 
+    void PlaybackQueue::addToHistory(const Song& song, unsigned play_duration) {
+        if (!_history_writer || !_current_user || song.getId() == 0)
+            return;
+
+        HistoryPlayback entry;
+        entry.setUser(std::shared_ptr<const User>(_current_user));
+        entry.setSong(song);
+        entry.setPlayedAt(std::time(nullptr) - play_duration);
+        entry.setPlayDuration(play_duration);
+
+        _history_writer->record(entry);
+    }
+
+    void PlaybackQueue::flushHistory() {
+        if (_history_writer)
+            _history_writer->flush();
+    }
+
     size_t PlaybackQueue::getCurrentIndex() const {
         return _aleatory ? _indices_aleatory[_current] : _current;
     }
@@ -82,6 +100,28 @@ namespace core {
                                 new_indices.end());
     }
 
+    bool PlaybackQueue::push(const std::shared_ptr<Song>& song) {
+        if (!song || _queue.size() >= _max_size)
+            return false;
+
+        _queue.push_back(song);
+        _indices_aleatory.push_back(_queue.size() - 1);
+        return true;
+    }
+
+    size_t PlaybackQueue::add(
+        const std::function<size_t(const SongRepository::RowCallback&)>& source) {
+        size_t added = 0;
+        source([this, &added](const std::shared_ptr<Song>& song) {
+            if (!push(song))
+                return false;
+            added++;
+            return true;
+        });
+
+        return added;
+    }
+
     void PlaybackQueue::operator+=(const IPlayable& tracks) {
         add(tracks);
     }
@@ -51,7 +51,14 @@ namespace core {
         addPlaybackQueue(tracks);
     }
 
+    Player::Player(std::shared_ptr<User> user,
+                   std::shared_ptr<HistoryWriter> history_writer)
+        : Player() {
+        _queue = std::make_shared<core::PlaybackQueue>(user, history_writer);
+    }
+
     Player::~Player() {
+        recordCurrentPlayback();
         cleanupCurrentSound();
         if (_audioInitialized) {
             ma_engine_uninit(&_audioEngine);
@@ -88,6 +95,14 @@ namespace core {
         memset(&_currentSound, 0, sizeof(_currentSound));
     }
 
+    void Player::recordCurrentPlayback() {
+        if (!_queue || !_currentSong || _currentSound.pDataSource == nullptr) {
+            return;
+        }
+
+        _queue->addToHistory(*_currentSong, getElapsedTime());
+    }
+
     bool Player::loadCurrentSong() {
         if (!_audioInitialized) {
             throw std::runtime_error("Audio engine não inicializado");
@@ -102,6 +117,7 @@ namespace core {
             throw std::runtime_error("Índice inválido");
         }
 
+        recordCurrentPlayback();
         cleanupCurrentSound();
 
         _currentSong = _queue->getCurrentSong();
@@ -214,6 +230,7 @@ namespace core {
 
         if (!nextSong) {
             _playerState = PlayerState::STOPPED;
+            recordCurrentPlayback();
             cleanupCurrentSound();
             return;
         }
@@ -394,6 +411,7 @@ namespace core {
 
     void Player::clearPlaylist() {
         pause();
+        recordCurrentPlayback();
         cleanupCurrentSound();
         _queues.clear();
         _currentQueueIndex = -1;
@@ -156,7 +156,8 @@ namespace core {
         : _configManager(std::make_shared<ConfigManager>(configManager)) {
 
         DatabaseManager db_manager(_configManager->databasePath(),
-                                   _configManager->databaseSchemaPath());
+                                   _configManager->databaseSchemaPath(),
+                                   _configManager->databaseSettings());
         RepositoryFactory repo_factory(db_manager.getDatabase());
         _userRepository = repo_factory.createUserRepository();
 
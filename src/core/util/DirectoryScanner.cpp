@@ -0,0 +1,218 @@
+/**
+ * @file DirectoryScanner.cpp
+ * @brief Implementação da varredura de diretórios
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-05
+ */
+
+#include "core/util/DirectoryScanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+    #include <filesystem>
+    #include <system_error>
+
+    #include "core/util/UnicodeHelper.hpp"
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+namespace core {
+    namespace {
+        std::string lowercase(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+            return text;
+        }
+
+        /**
+         * @brief Lista as entradas de um diretório, separando subdiretórios e arquivos
+         */
+        void listDirectory(const std::string& directory,
+                           const DirectoryScanner& scanner,
+                           std::vector<std::string>& subdirectories,
+                           std::vector<std::string>& files) {
+#ifdef _WIN32
+            // No Windows o tipo vem junto da listagem, sem stat() adicional
+            std::error_code error;
+            std::filesystem::directory_iterator entries(UnicodeHelper::toPath(directory), error);
+            if (error)
+                return;
+
+            for (const auto& entry : entries) {
+                std::string path = UnicodeHelper::fromWide(entry.path().wstring());
+                if (entry.is_directory(error) && !entry.is_symlink(error)) {
+                    subdirectories.push_back(std::move(path));
+                } else if (entry.is_regular_file(error)
+                           && scanner.accepts(UnicodeHelper::fromWide(
+                               entry.path().filename().wstring()))) {
+                    files.push_back(std::move(path));
+                }
+            }
+#else
+            DIR* dir = ::opendir(directory.c_str());
+            if (!dir)
+                return;
+
+            std::string prefix = directory;
+            if (prefix.empty() || prefix.back() != '/')
+                prefix += '/';
+
+            while (const struct dirent* entry = ::readdir(dir)) {
+                const char* name = entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                    continue;
+
+    #ifdef DT_UNKNOWN
+                unsigned char type = entry->d_type;
+                if (type == DT_DIR) {
+                    subdirectories.push_back(prefix + name);
+                    continue;
+                }
+                if (type == DT_REG) {
+                    if (scanner.accepts(name))
+                        files.push_back(prefix + name);
+                    continue;
+                }
+                if (type != DT_LNK && type != DT_UNKNOWN)
+                    continue;  // FIFOs, sockets e dispositivos
+    #endif
+
+                // Link simbólico ou tipo não informado: só aqui há stat()
+                std::string path = prefix + name;
+                struct stat info;
+                if (::lstat(path.c_str(), &info) != 0)
+                    continue;
+
+                if (S_ISDIR(info.st_mode)) {
+                    subdirectories.push_back(std::move(path));
+                } else if (scanner.accepts(name)
+                           && (S_ISREG(info.st_mode)
+                               || (S_ISLNK(info.st_mode) && ::stat(path.c_str(), &info) == 0
+                                   && S_ISREG(info.st_mode)))) {
+                    files.push_back(std::move(path));
+                }
+            }
+
+            ::closedir(dir);
+#endif
+        }
+    }  // namespace
+
+    DirectoryScanner::DirectoryScanner(const std::vector<std::string>& extensions,
+                                       size_t threads)
+        : _threads(threads) {
+        for (const auto& extension : extensions) {
+            std::string normalized = lowercase(extension);
+            if (!normalized.empty() && normalized.front() == '.')
+                normalized.erase(0, 1);
+            if (!normalized.empty())
+                _extensions.push_back(std::move(normalized));
+        }
+
+        if (_threads == 0)
+            _threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    bool DirectoryScanner::accepts(const std::string& filename) const {
+        if (_extensions.empty())
+            return true;
+
+        size_t dot = filename.find_last_of('.');
+        size_t separator = filename.find_last_of("/\\");
+        if (dot == std::string::npos
+            || (separator != std::string::npos && dot < separator))
+            return false;
+
+        std::string extension = lowercase(filename.substr(dot + 1));
+        return std::find(_extensions.begin(), _extensions.end(), extension)
+               != _extensions.end();
+    }
+
+    size_t DirectoryScanner::scan(const std::string& root, const FileHandler& handler) const {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<std::string> pending {root}; // Diretórios ainda não listados
+        size_t busy = 0;                         // Threads listando um diretório
+        bool stopped = false;
+        std::exception_ptr failure;
+        std::atomic<size_t> delivered(0);
+
+        auto work = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [&]() { return stopped || !pending.empty() || busy == 0; });
+                if (stopped || pending.empty())
+                    break;  // Pilha vazia e ninguém listando: terminou
+
+                std::string directory = std::move(pending.back());
+                pending.pop_back();
+                busy++;
+                lock.unlock();
+
+                std::vector<std::string> subdirectories;
+                std::vector<std::string> files;
+                listDirectory(directory, *this, subdirectories, files);
+
+                // Subdiretórios publicados antes de tratar os arquivos, para
+                // as outras threads já começarem
+                if (!subdirectories.empty()) {
+                    lock.lock();
+                    for (auto& subdirectory : subdirectories)
+                        pending.push_back(std::move(subdirectory));
+                    lock.unlock();
+                    wake.notify_all();
+                }
+
+                bool keep = true;
+                try {
+                    for (const auto& file : files) {
+                        delivered++;
+                        if (!handler(file)) {
+                            keep = false;
+                            break;
+                        }
+                    }
+                } catch (...) {
+                    lock.lock();
+                    if (!failure)
+                        failure = std::current_exception();
+                    lock.unlock();
+                    keep = false;
+                }
+
+                lock.lock();
+                busy--;
+                if (!keep)
+                    stopped = true;
+                if (stopped || busy == 0)
+                    wake.notify_all();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(_threads - 1);
+        for (size_t i = 1; i < _threads; ++i)
+            workers.emplace_back(work);
+
+        work();
+        for (auto& worker : workers)
+            worker.join();
+
+        if (failure)
+            std::rethrow_exception(failure);
+        return delivered;
+    }
+}  // namespace core
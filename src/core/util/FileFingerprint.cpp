@@ -0,0 +1,79 @@
+/**
+ * @file FileFingerprint.cpp
+ * @brief Implementação da identificação de arquivos
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include "core/util/FileFingerprint.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
+
+#include "core/util/UnicodeHelper.hpp"
+
+namespace core {
+    std::optional<FileFingerprint> FileFingerprint::stat(const std::string& path) {
+        FileFingerprint fingerprint;
+        fingerprint.path = path;
+
+#ifdef _WIN32
+        std::error_code error;
+        std::filesystem::path file = UnicodeHelper::toPath(path);
+        auto size = std::filesystem::file_size(file, error);
+        if (error)
+            return std::nullopt;
+        auto modified = std::filesystem::last_write_time(file, error);
+        if (error)
+            return std::nullopt;
+
+        fingerprint.size = static_cast<uint64_t>(size);
+        fingerprint.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                modified.time_since_epoch())
+                                .count();
+#else
+        struct ::stat info;
+        if (::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode))
+            return std::nullopt;
+
+        fingerprint.size = static_cast<uint64_t>(info.st_size);
+        fingerprint.inode = static_cast<uint64_t>(info.st_ino);
+    #ifdef __APPLE__
+        fingerprint.mtime = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000
+                            + info.st_mtimespec.tv_nsec;
+    #else
+        fingerprint.mtime = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000
+                            + info.st_mtim.tv_nsec;
+    #endif
+#endif
+
+        return fingerprint;
+    }
+
+    uint64_t FileFingerprint::hashPrefix(const std::string& path) {
+        std::ifstream file(UnicodeHelper::toPath(path), std::ios::binary);
+        std::vector<char> buffer(FINGERPRINT_HASH_PREFIX_BYTES);
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        // FNV-1a de 64 bits
+        uint64_t hash = 14695981039346656037ULL;
+        for (std::streamsize i = 0; i < file.gcount(); ++i) {
+            hash ^= static_cast<unsigned char>(buffer[static_cast<size_t>(i)]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool FileFingerprint::sameStat(const FileFingerprint& other) const {
+        return size == other.size && mtime == other.mtime && inode == other.inode;
+    }
+}  // namespace core
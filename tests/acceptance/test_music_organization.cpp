@@ -1,5 +1,5 @@
 #include <filesystem>
-#include <filesystem>
+#include <fstream>
 #include <doctest/doctest.h>
 #include <memory>
 #include <string>
@@ -155,6 +155,46 @@ TEST_SUITE("HISTÓRIA DE USUÁRIO: Organização de Músicas") {
             clearTestEnvironment(user);
         }
 
+        SUBCASE("Organizar um álbum copiado como pasta") {
+            setup();
+            core::User user("usertest1",
+                            config.userMusicDirectory(),
+                            config.inputUserPath(),
+                            uid1001);
+            CHECK(user_repo->save(user));
+
+            auto song_mock1 =
+                media.getSongTestMock("Short_Song_Test_The_Testers");
+            auto song_mock2 =
+                media.getSongTestMock("Medium_Song_Test_The_Testers");
+
+            fs::path album_dir = fs::path(user.getInputPath()) / "Artista" / "Album";
+            fs::create_directories(album_dir);
+
+            fs::copy(song_mock1.path, album_dir / "01.mp3",
+                     fs::copy_options::overwrite_existing);
+            fs::copy(song_mock2.path, album_dir / "02.mp3",
+                     fs::copy_options::overwrite_existing);
+            {
+                std::ofstream cover(album_dir / "capa.jpg");
+                cover << "não é áudio";
+            }
+            manager->update();
+
+            CHECK(fs::exists(user.getHomePath() + song_mock1.artist + "/"
+                             + song_mock1.album + "/" + song_mock1.title + ".mp3"));
+            CHECK(fs::exists(user.getHomePath() + song_mock2.artist + "/"
+                             + song_mock2.album + "/" + song_mock2.title + ".mp3"));
+            checkSongInDatabase(song_mock1, user);
+            checkSongInDatabase(song_mock2, user);
+
+            // Fora da lista de extensões: nem lido, nem movido
+            CHECK(fs::exists(album_dir / "capa.jpg"));
+            CHECK_EQ(manager->getLastScan().added, 2);
+
+            clearTestEnvironment(user);
+        }
+
         SUBCASE("Atualizar um álbum existente") {
             setup();
             core::User user("usertest1",
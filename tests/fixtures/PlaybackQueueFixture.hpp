@@ -1,8 +1,8 @@
 #pragma once
 
-#include "core/bd/HistoryPlaybackRepository.hpp"
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
+#include "core/services/HistoryWriter.hpp"
 #include <memory>
 
 /**
@@ -11,11 +11,10 @@
 class PlaybackQueueFixture {
 public:
     std::shared_ptr<core::User> user;
-    std::shared_ptr<core::HistoryPlaybackRepository> history_repo;
+    std::shared_ptr<core::HistoryWriter> history_writer;
 
     PlaybackQueueFixture() {
         user = std::make_shared<core::User>("username");
-        std::shared_ptr<core::HistoryPlaybackRepository> history_repo = nullptr;
     };
 
     std::shared_ptr<core::Song> createSong(const std::string &title) {
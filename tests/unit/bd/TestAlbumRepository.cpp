@@ -0,0 +1,128 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - AlbumRepository") {
+    struct AlbumRepositoryFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        core::Artist artist;
+        core::Album album;
+
+        AlbumRepositoryFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("album_user");
+            core::UserRepository(db).save(user);
+
+            artist = core::Artist(0, "Os Mutantes", user);
+            core::ArtistRepository(db).save(artist);
+
+            album = core::Album(0, "A Divina Comédia", 1970, "Rock", artist);
+            album.setUser(user);
+            core::AlbumRepository album_repo(db);
+            album_repo.save(album);
+            album_repo.setPrincipalArtist(album, artist, user);
+
+            core::SongRepository song_repo(db);
+            for (const char* title : {"Ando meio desligado", "Quem tem medo de brincar de amor"}) {
+                core::Song song(0, title, artist.getId());
+                song.setDuration(180);
+                song.setUser(user);
+                song.setAlbumId(album.getId());
+                song_repo.save(song);
+            }
+        }
+    };
+
+    TEST_CASE_FIXTURE(AlbumRepositoryFixture,
+                      "AlbumRepository: carrega artista e contagem junto com o álbum") {
+        core::AlbumRepository repo(db);
+
+        auto albums = repo.findByUser(user);
+        REQUIRE(albums.size() == 1);
+
+        auto loaded = albums[0];
+        CHECK(loaded->getTitle() == "A Divina Comédia");
+        CHECK(loaded->getArtistId() == artist.getId());
+        CHECK(loaded->getSongsCount() == 2);
+        CHECK_FALSE(loaded->isSongsLoaded());
+
+        REQUIRE(loaded->getArtist());
+        CHECK(loaded->getArtist()->getName() == "Os Mutantes");
+        CHECK(loaded->getArtist() == core::ArtistRepository(db).findById(artist.getId()));
+    }
+
+    TEST_CASE_FIXTURE(AlbumRepositoryFixture,
+                      "AlbumRepository: buscas devolvem a mesma instância") {
+        core::AlbumRepository repo(db);
+
+        auto by_id = repo.findById(album.getId());
+        auto by_artist = repo.findByArtist("Mutantes");
+        REQUIRE(by_id);
+        REQUIRE(by_artist.size() == 1);
+        CHECK(by_artist[0] == by_id);
+        CHECK(repo.getAll().size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(AlbumRepositoryFixture,
+                      "AlbumRepository: álbum com dois artistas principais") {
+        core::Artist other(0, "Rita Lee", user);
+        core::ArtistRepository(db).save(other);
+
+        // setPrincipalArtist troca o principal; a segunda linha entra direto
+        SQLite::Statement insert(*db,
+                                 "INSERT INTO album_artists "
+                                 "(album_id, artist_id, user_id, is_principal) "
+                                 "VALUES (?, ?, ?, 1);");
+        insert.bind(1, album.getId());
+        insert.bind(2, other.getId());
+        insert.bind(3, user.getId());
+        REQUIRE(insert.exec() == 1);
+
+        core::AlbumRepository repo(db);
+
+        auto by_user = repo.findByUser(user);
+        REQUIRE(by_user.size() == 1);
+        CHECK(by_user[0]->getArtistId() == artist.getId());
+        REQUIRE(by_user[0]->getArtist());
+        CHECK(by_user[0]->getArtist()->getName() == "Os Mutantes");
+
+        CHECK(repo.findByTitleAndUser("Divina", user).size() == 1);
+        CHECK(repo.findByArtist("Mutantes").size() == 1);
+
+        auto by_other = repo.findByArtist("Rita");
+        REQUIRE(by_other.size() == 1);
+        CHECK(by_other[0] == by_user[0]);
+    }
+
+    TEST_CASE_FIXTURE(AlbumRepositoryFixture,
+                      "AlbumRepository: álbum sem artista principal") {
+        core::AlbumRepository repo(db);
+        core::Album single(0, "Avulso", 2001, "Pop", artist);
+        single.setUser(user);
+        repo.save(single);
+
+        auto loaded = repo.findById(single.getId());
+        REQUIRE(loaded);
+        CHECK(loaded->getSongsCount() == 0);
+        CHECK_FALSE(loaded->getArtist());
+    }
+}
@@ -0,0 +1,175 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DataLoader.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/RepositoryFactory.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - DataLoader") {
+    struct DataLoaderFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        std::vector<core::Artist> artists;
+        std::vector<core::Album> albums;
+        std::vector<core::Song> songs;
+
+        DataLoaderFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("loader_user");
+            core::UserRepository(db).save(user);
+
+            core::ArtistRepository artist_repo(db);
+            core::AlbumRepository album_repo(db);
+            core::SongRepository song_repo(db);
+            const std::vector<std::string> names = {"Novos Baianos", "Secos & Molhados", "Clube da Esquina"};
+            for (const auto& name : names) {
+                core::Artist artist(0, name, user);
+                artist_repo.save(artist);
+                artists.push_back(artist);
+
+                core::Album album(0, "Disco de " + name, 1973, "MPB", artist);
+                album.setUser(user);
+                album_repo.save(album);
+                album_repo.setPrincipalArtist(album, artist, user);
+                albums.push_back(album);
+
+                core::Song song(0, "Faixa de " + name, artist.getId());
+                song.setDuration(200);
+                song.setUser(user);
+                song.setAlbumId(album.getId());
+                song_repo.save(song);
+                songs.push_back(song);
+            }
+        }
+    };
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "DataLoader: artistas das músicas do escopo vêm em um lote") {
+        core::DataLoader loader(db);
+        core::DataLoader::Scope scope(loader);
+
+        auto loaded = core::SongRepository(db).findByUser(user, 0, songs.size());
+        REQUIRE(loaded.size() == songs.size());
+
+        for (const auto& song : loaded) {
+            auto artist = song->getArtist();
+            REQUIRE(artist);
+            CHECK(artist->getId() == song->getArtistId());
+        }
+        CHECK(loaded[0]->getArtist()->getName() == "Novos Baianos");
+        CHECK(loaded[2]->getArtist()->getName() == "Clube da Esquina");
+        CHECK(loader.getBatchCount() == 1);
+    }
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "DataLoader: álbuns e colaboradores são lidos em lote") {
+        core::SongRepository song_repo(db);
+        song_repo.addFeaturingArtist(songs[0], artists[1], user);
+        song_repo.addFeaturingArtist(songs[0], artists[2], user);
+
+        core::DataLoader loader(db);
+        core::DataLoader::Scope scope(loader);
+
+        auto loaded = song_repo.findByUser(user, 0, songs.size());
+        REQUIRE(loaded.size() == songs.size());
+
+        for (size_t i = 0; i < loaded.size(); ++i) {
+            auto album = loaded[i]->getAlbum();
+            REQUIRE(album);
+            CHECK(album->getTitle() == albums[i].getTitle());
+        }
+        CHECK(loader.getBatchCount() == 1);
+
+        auto featuring = loaded[0]->getFeaturingArtists();
+        REQUIRE(featuring.size() == 2);
+        CHECK(featuring[0]->getName() == "Clube da Esquina");
+        CHECK(featuring[1]->getName() == "Secos & Molhados");
+        CHECK(loaded[1]->getFeaturingArtists().empty());
+        CHECK(loader.getBatchCount() == 2);
+    }
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "DataLoader: prime registra músicas lidas fora do escopo") {
+        auto loaded = core::SongRepository(db).findByUser(user, 0, songs.size());
+        REQUIRE(loaded.size() == songs.size());
+
+        core::DataLoader loader(db);
+        core::DataLoader::Scope scope(loader);
+        loader.prime(loaded);
+
+        CHECK(loader.loadArtist(loaded[1]->getArtistId())->getName() == "Secos & Molhados");
+        CHECK(loaded[0]->getArtist()->getName() == "Novos Baianos");
+        CHECK(loaded[2]->getArtist()->getName() == "Clube da Esquina");
+        CHECK(loader.loadArtist(9999) == nullptr);
+        CHECK(loader.getBatchCount() == 2);
+    }
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "DataLoader: músicas do mapa de identidade entram no lote da fábrica") {
+        core::RepositoryFactory factory(db);
+        auto song_repo = factory.createSongRepository();
+        auto cached = song_repo->findById(songs[0].getId());
+        REQUIRE(cached);
+
+        auto loader = factory.createDataLoader();
+        core::DataLoader::Scope scope(*loader);
+        auto loaded = song_repo->findByIds({songs[2].getId(), songs[0].getId(),
+                                            songs[2].getId()});
+        REQUIRE(loaded.size() == 2);
+        CHECK(loaded[1] == cached);
+        loader->prime(loaded);
+
+        CHECK(loaded[0]->getArtist()->getName() == "Clube da Esquina");
+        CHECK(loaded[1]->getArtist()->getName() == "Novos Baianos");
+        CHECK(loader->getBatchCount() == 1);
+    }
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "DataLoader: sem escopo os loaders consultam uma música por vez") {
+        {
+            core::DataLoader loader(db);
+            core::DataLoader::Scope scope(loader);
+            CHECK(core::DataLoader::current(db) == &loader);
+        }
+        CHECK(core::DataLoader::current(db) == nullptr);
+
+        auto song = core::SongRepository(db).findById(songs[1].getId());
+        REQUIRE(song);
+        REQUIRE(song->getArtist());
+        CHECK(song->getArtist()->getName() == "Secos & Molhados");
+    }
+
+    TEST_CASE_FIXTURE(DataLoaderFixture,
+                      "SQLiteRepositoryBase: findByIds mantém a ordem e ignora ausentes") {
+        core::ArtistRepository repo(db);
+        auto cached = repo.findById(artists[0].getId());
+
+        auto found = repo.findByIds({artists[2].getId(), 9999, artists[0].getId(),
+                                     artists[2].getId()});
+        REQUIRE(found.size() == 2);
+        CHECK(found[0]->getName() == "Clube da Esquina");
+        CHECK(found[1] == cached);
+
+        auto album_found = core::AlbumRepository(db).findByIds({albums[1].getId()});
+        REQUIRE(album_found.size() == 1);
+        CHECK(album_found[0]->getArtistId() == artists[1].getId());
+    }
+}
@@ -0,0 +1,173 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "core/bd/DatabaseExecutor.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - DatabaseExecutor") {
+    struct DatabaseExecutorFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+
+        DatabaseExecutorFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+        }
+    };
+
+    /**
+     * @brief Segura a thread do executor até release() ser chamado
+     */
+    struct Gate {
+        std::promise<void> started;
+        std::promise<void> opened;
+        std::shared_future<void> wait = opened.get_future().share();
+
+        /**
+         * @brief Enfileira a requisição que segura o executor e espera ela começar
+         */
+        std::future<void> hold(core::DatabaseExecutor& executor) {
+            auto blocker = executor.submit(
+                [this, wait = wait](core::RepositoryFactory&) {
+                    started.set_value();
+                    wait.wait();
+                });
+            started.get_future().wait();
+            return blocker;
+        }
+
+        void release() { opened.set_value(); }
+    };
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: executa na thread do executor") {
+        core::DatabaseExecutor executor(db);
+
+        core::User user;
+        user.setUsername("async_user");
+        auto saved = executor.submit([&user](core::RepositoryFactory& factory) {
+            return factory.createUserRepository()->save(user);
+        });
+        CHECK(saved.get());
+
+        auto caller = std::this_thread::get_id();
+        auto found = executor.submit([&](core::RepositoryFactory& factory) {
+            CHECK(std::this_thread::get_id() != caller);
+            return factory.createUserRepository()->findById(user.getId());
+        });
+        auto loaded = found.get();
+        REQUIRE(loaded != nullptr);
+        CHECK(loaded->getUsername() == "async_user");
+    }
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: erros chegam pelo futuro") {
+        core::DatabaseExecutor executor(db);
+
+        auto failed = executor.submit([](core::RepositoryFactory&) -> int {
+            throw std::runtime_error("falhou");
+        });
+        CHECK_THROWS_AS(failed.get(), std::runtime_error);
+
+        // O executor continua atendendo depois de uma falha
+        auto ok = executor.submit([](core::RepositoryFactory&) { return 7; });
+        CHECK(ok.get() == 7);
+    }
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: requisição cancelada não executa") {
+        core::DatabaseExecutor executor(db);
+        Gate gate;
+        auto blocker = gate.hold(executor);
+
+        std::atomic<bool> ran {false};
+        core::CancellationToken token;
+        auto cancelled = executor.submit(
+            [&ran](core::RepositoryFactory&) { ran.store(true); }, token);
+        token.cancel();
+        gate.release();
+
+        CHECK_THROWS_AS(cancelled.get(), core::OperationCancelled);
+        CHECK_FALSE(ran.load());
+        blocker.get();
+    }
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: pedidos iguais na fila são agrupados") {
+        core::DatabaseExecutor executor(db);
+        Gate gate;
+        auto blocker = gate.hold(executor);
+
+        std::atomic<int> runs {0};
+        auto work = [&runs](core::RepositoryFactory&) { return ++runs; };
+        auto first = executor.submitCoalesced("contagem", work);
+        auto second = executor.submitCoalesced("contagem", work);
+        CHECK(executor.pending() == 1);
+
+        gate.release();
+        CHECK(first.get() == 1);
+        CHECK(second.get() == 1);
+        CHECK(runs.load() == 1);
+
+        // Depois de executado, a mesma chave consulta de novo
+        CHECK(executor.submitCoalesced("contagem", work).get() == 2);
+        blocker.get();
+    }
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: callbacks e requisições aninhadas") {
+        core::DatabaseExecutor executor(db);
+
+        std::promise<int> delivered;
+        executor.post(
+            [&executor](core::RepositoryFactory&) {
+                // Aninhada na thread do executor: executa na hora
+                return executor.submit([](core::RepositoryFactory&) { return 3; })
+                    .get();
+            },
+            [&delivered](int value) { delivered.set_value(value); });
+
+        auto result = delivered.get_future();
+        REQUIRE(result.wait_for(std::chrono::seconds(5))
+                == std::future_status::ready);
+        CHECK(result.get() == 3);
+    }
+
+    TEST_CASE_FIXTURE(DatabaseExecutorFixture,
+                      "DatabaseExecutor: pedidos durante stop ficam na fila") {
+        core::DatabaseExecutor executor(db);
+        Gate gate;
+        auto blocker = gate.hold(executor);
+
+        std::thread stopper([&executor]() { executor.stop(); });
+
+        auto caller = std::this_thread::get_id();
+        auto queued = executor.submit([caller](core::RepositoryFactory&) {
+            return std::this_thread::get_id() != caller;
+        });
+        gate.release();
+        stopper.join();
+
+        CHECK(queued.get());
+        blocker.get();
+
+        // Com a thread encerrada, executa na thread de quem chama
+        auto direct = executor.submit([caller](core::RepositoryFactory&) {
+            return std::this_thread::get_id() == caller;
+        });
+        CHECK(direct.get());
+    }
+}
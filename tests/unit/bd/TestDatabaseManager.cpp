@@ -0,0 +1,360 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <sqlite3.h>
+
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/UnitOfWork.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - DatabaseManager") {
+    struct FileDatabaseFixture {
+        ConfigFixture config;
+        std::filesystem::path db_path;
+
+        FileDatabaseFixture()
+            : db_path(std::filesystem::temp_directory_path()
+                      / "frankenstein_test_wal.db") {
+            removeFiles();
+        }
+
+        ~FileDatabaseFixture() {
+            removeFiles();
+        }
+
+        void removeFiles() {
+            std::filesystem::remove(db_path);
+            std::filesystem::remove(db_path.string() + "-wal");
+            std::filesystem::remove(db_path.string() + "-shm");
+        }
+    };
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: abre o banco em modo WAL") {
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath());
+
+        auto mode = db_manager.getDatabase()->execAndGet("PRAGMA journal_mode;")
+                        .getString();
+        CHECK(mode == "wal");
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: leitores veem gravações e não escrevem") {
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath());
+        core::UserRepository writer_repo(db_manager.getDatabase());
+
+        core::User user("usuario1");
+        #ifdef _WIN32
+            user.setUID("winuid1");
+        #else
+            user.setUID(101);
+        #endif
+        REQUIRE(writer_repo.save(user));
+
+        auto reader = db_manager.getReader();
+        CHECK(reader != db_manager.getDatabase());
+
+        core::UserRepository reader_repo(reader);
+        CHECK(reader_repo.findById(user.getId()) != nullptr);
+        CHECK_THROWS(reader->exec("DELETE FROM users"));
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: conexões de leitura voltam ao pool") {
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath());
+
+        SQLite::Database* first = nullptr;
+        {
+            auto reader = db_manager.getReader();
+            first = reader.get();
+        }
+
+        auto reader = db_manager.getReader();
+        CHECK(reader.get() == first);
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: conexão própria tem transação independente") {
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath());
+        auto writer = db_manager.openConnection();
+        REQUIRE(writer != db_manager.getDatabase());
+
+        db_manager.getDatabase()->exec("BEGIN;");
+        CHECK(sqlite3_get_autocommit(writer->getHandle()) != 0);
+        db_manager.getDatabase()->exec("ROLLBACK;");
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: mapa de identidade é de cada conexão") {
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath());
+        auto writer = db_manager.getDatabase();
+
+        core::User user("identidade");
+        #ifdef _WIN32
+            user.setUID("winuid6");
+        #else
+            user.setUID(106);
+        #endif
+        REQUIRE(core::UserRepository(writer).save(user));
+
+        core::Artist artist(0, "Original", user);
+        REQUIRE(core::ArtistRepository(writer).save(artist));
+
+        auto reader = db_manager.getReader();
+        core::ArtistRepository reader_repo(reader);
+        auto before = reader_repo.findById(artist.getId());
+        REQUIRE(before != nullptr);
+
+        {
+            // Linha ainda não confirmada não chega ao leitor
+            core::UnitOfWork unit(writer);
+            artist.setName("Alterado");
+            REQUIRE(core::ArtistRepository(writer).save(artist));
+            CHECK(core::ArtistRepository(writer).findById(artist.getId())->getName()
+                  == "Alterado");
+            CHECK(reader_repo.findById(artist.getId()) == before);
+            unit.commit();
+        }
+
+        // A confirmação muda o data_version do leitor e esvazia o seu mapa
+        auto after = reader_repo.findById(artist.getId());
+        REQUIRE(after != nullptr);
+        CHECK(after != before);
+        CHECK(after->getName() == "Alterado");
+
+        // O usuário compartilhado segue o mesmo data_version
+        core::UserRepository reader_users(reader);
+        auto shared = reader_users.findSharedById(user.getId());
+        REQUIRE(shared != nullptr);
+        user.setUsername("renomeada");
+        REQUIRE(core::UserRepository(writer).save(user));
+        auto renamed = reader_users.findSharedById(user.getId());
+        REQUIRE(renamed != nullptr);
+        CHECK(renamed != shared);
+        CHECK(renamed->getUsername() == "renomeada");
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: mapas de identidade usam a capacidade configurada") {
+        core::DatabaseSettings settings;
+        settings.identity_map_entries = 3;
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath(),
+                                         settings);
+
+        CHECK(core::IdentityMap<core::Artist>::forDatabase(db_manager.getDatabase())
+                  ->getCapacity() == 3);
+        CHECK(core::IdentityMap<core::Artist>::forDatabase(db_manager.getReader())
+                  ->getCapacity() == 3);
+        CHECK(core::IdentityMap<const core::User>::forDatabase(db_manager.openConnection())
+                  ->getCapacity() == 3);
+    }
+
+    TEST_CASE("DatabaseManager: banco em memória usa a conexão de escrita") {
+        ConfigFixture config;
+        core::DatabaseManager db_manager(config.databasePath(),
+                                         config.databaseSchemaPath());
+
+        CHECK(db_manager.getReader() == db_manager.getDatabase());
+    }
+
+    TEST_CASE("DatabaseManager: rejeita modo synchronous inválido") {
+        ConfigFixture config;
+        core::DatabaseSettings settings;
+        settings.synchronous = "NORMAL; DROP TABLE users";
+
+        CHECK_THROWS(core::DatabaseManager(config.databasePath(),
+                                           config.databaseSchemaPath(),
+                                           settings));
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: cópia em memória grava no arquivo") {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = true;
+        settings.mirror_flush_ms = 0;
+
+        core::User user("espelho");
+        #ifdef _WIN32
+            user.setUID("winuid2");
+        #else
+            user.setUID(102);
+        #endif
+
+        {
+            core::DatabaseManager db_manager(db_path.string(),
+                                             config.databaseSchemaPath(),
+                                             settings);
+            REQUIRE(db_manager.isMirrored());
+            CHECK(db_manager.getReader() != db_manager.getDatabase());
+            CHECK(db_manager.getDatabase()->getFilename() != db_path.string());
+
+            REQUIRE(core::UserRepository(db_manager.getDatabase()).save(user));
+
+            SQLite::Database disk(db_path.string(), SQLite::OPEN_READONLY);
+            auto count = [&disk]() {
+                return disk.execAndGet("SELECT COUNT(*) FROM users;").getInt();
+            };
+            CHECK(count() == 0);
+
+            db_manager.flushMirror();
+            CHECK(count() == 1);
+        }
+
+        // Reaberto sem a cópia, o arquivo tem o esquema e os dados
+        core::DatabaseManager reopened(db_path.string(),
+                                       config.databaseSchemaPath());
+        auto loaded = core::UserRepository(reopened.getDatabase()).findById(user.getId());
+        REQUIRE(loaded != nullptr);
+        CHECK(loaded->getUsername() == "espelho");
+        CHECK(reopened.getSchemaVersion() > 0);
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: cópia em memória não grava transação aberta") {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = true;
+        settings.mirror_flush_ms = 0;
+
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath(),
+                                         settings);
+        auto writer = db_manager.openConnection();
+        REQUIRE(writer != db_manager.getDatabase());
+
+        SQLite::Database disk(db_path.string(), SQLite::OPEN_READONLY);
+        auto count = [&disk]() {
+            return disk.execAndGet("SELECT COUNT(*) FROM users;").getInt();
+        };
+
+        core::User user("transacao");
+        #ifdef _WIN32
+            user.setUID("winuid5");
+        #else
+            user.setUID(105);
+        #endif
+        writer->exec("BEGIN;");
+        REQUIRE(core::UserRepository(writer).save(user));
+        db_manager.flushMirror();
+        CHECK(count() == 0);
+
+        writer->exec("COMMIT;");
+        db_manager.flushMirror();
+        CHECK(count() == 1);
+        CHECK(core::UserRepository(db_manager.getReader()).findById(user.getId()) != nullptr);
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: cópia em memória não sobrescreve outra conexão") {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = true;
+        settings.mirror_flush_ms = 0;
+
+        core::DatabaseManager db_manager(db_path.string(),
+                                         config.databaseSchemaPath(),
+                                         settings);
+
+        core::User external("externo");
+        core::User mirrored("espelhado");
+        #ifdef _WIN32
+            external.setUID("winuid7");
+            mirrored.setUID("winuid8");
+        #else
+            external.setUID(107);
+            mirrored.setUID(108);
+        #endif
+
+        auto disk = std::make_shared<SQLite::Database>(db_path.string(),
+                                                       SQLite::OPEN_READWRITE);
+        REQUIRE(core::UserRepository(disk).save(external));
+        REQUIRE(core::UserRepository(db_manager.getDatabase()).save(mirrored));
+
+        auto writer = db_manager.openConnection();
+        CHECK_THROWS_AS(db_manager.flushMirror(), std::runtime_error);
+        auto names = disk->execAndGet("SELECT group_concat(username) FROM users;");
+        CHECK(names.getString() == "externo");
+
+        // Depois da divergência a cópia não aceita escritas que seriam perdidas
+        core::User late("tardio");
+        #ifdef _WIN32
+            late.setUID("winuid9");
+        #else
+            late.setUID(109);
+        #endif
+        CHECK_THROWS_AS(core::UserRepository(db_manager.getDatabase()).save(late),
+                        SQLite::Exception);
+        CHECK_THROWS_AS(core::UserRepository(writer).save(late), SQLite::Exception);
+        CHECK_THROWS_AS(db_manager.flushMirror(), std::runtime_error);
+        CHECK(core::UserRepository(db_manager.getReader()).findById(mirrored.getId())
+              != nullptr);
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: cópia em memória é gravada ao fechar") {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = true;
+
+        {
+            core::DatabaseManager db_manager(db_path.string(),
+                                             config.databaseSchemaPath(),
+                                             settings);
+            core::User user("fechamento");
+            #ifdef _WIN32
+                user.setUID("winuid3");
+            #else
+                user.setUID(103);
+            #endif
+            REQUIRE(core::UserRepository(db_manager.getDatabase()).save(user));
+        }
+
+        SQLite::Database disk(db_path.string(), SQLite::OPEN_READONLY);
+        CHECK(disk.execAndGet("SELECT COUNT(*) FROM users;").getInt() == 1);
+    }
+
+    TEST_CASE_FIXTURE(FileDatabaseFixture,
+                      "DatabaseManager: gerenciadores do mesmo arquivo compartilham a cópia") {
+        core::DatabaseSettings settings;
+        settings.memory_mirror = true;
+        settings.mirror_flush_ms = 0;
+
+        std::shared_ptr<SQLite::Database> connection;
+        {
+            core::DatabaseManager first(db_path.string(),
+                                        config.databaseSchemaPath(),
+                                        settings);
+            core::DatabaseManager second(db_path.string(),
+                                         config.databaseSchemaPath(),
+                                         settings);
+            CHECK(first.getDatabase() == second.getDatabase());
+
+            // Como os serviços, que guardam só a conexão do gerenciador
+            connection = second.getDatabase();
+        }
+
+        core::User user("compartilhado");
+        #ifdef _WIN32
+            user.setUID("winuid4");
+        #else
+            user.setUID(104);
+        #endif
+        REQUIRE(core::UserRepository(connection).save(user));
+        connection.reset();
+
+        SQLite::Database disk(db_path.string(), SQLite::OPEN_READONLY);
+        CHECK(disk.execAndGet("SELECT COUNT(*) FROM users;").getInt() == 1);
+    }
+}
@@ -0,0 +1,76 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/EntityTraits.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/HistoryPlayback.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - EntityTraits") {
+    using ArtistColumns = core::EntityTraits<core::Artist>;
+    using SongColumns = core::EntityTraits<core::Song>;
+
+    // O SQL é gerado durante a compilação
+    static constexpr core::SqlText ARTIST_SELECT = ArtistColumns::select();
+    static_assert(ARTIST_SELECT.view() == "SELECT id, name, user_id FROM artists");
+
+    template <typename Traits>
+    void checkAgainstSchema(SQLite::Database& db) {
+        static constexpr core::SqlText select = Traits::select();
+        SQLite::Statement query(db, select.c_str());
+        REQUIRE(query.getColumnCount() == Traits::ColumnCount);
+        for (int i = 0; i < Traits::ColumnCount; ++i)
+            CHECK(std::string_view(query.getColumnName(i)) == Traits::columns[i]);
+
+        static constexpr core::SqlText insert = Traits::insert();
+        static constexpr core::SqlText update = Traits::update();
+        CHECK_NOTHROW(SQLite::Statement(db, insert.c_str()));
+        CHECK_NOTHROW(SQLite::Statement(db, update.c_str()));
+    }
+
+    TEST_CASE("EntityTraits: gera INSERT e UPDATE com as colunas declaradas") {
+        static constexpr core::SqlText insert = ArtistColumns::insert();
+        static constexpr core::SqlText update = ArtistColumns::update();
+
+        CHECK(insert.view() == "INSERT INTO artists (name, user_id) VALUES (?, ?);");
+        CHECK(update.view() == "UPDATE artists SET name = ?, user_id = ? WHERE id = ?;");
+        CHECK(SongColumns::columnList("s").view().rfind("s.id, s.title, ", 0) == 0);
+    }
+
+    TEST_CASE("EntityTraits: colunas conferem com o esquema do banco") {
+        ConfigFixture config;
+        core::DatabaseManager db_manager(config.databasePath(),
+                                         config.databaseSchemaPath());
+        auto db = db_manager.getDatabase();
+
+        checkAgainstSchema<core::EntityTraits<core::User>>(*db);
+        checkAgainstSchema<core::EntityTraits<core::Artist>>(*db);
+        checkAgainstSchema<core::EntityTraits<core::Album>>(*db);
+        checkAgainstSchema<core::EntityTraits<core::Song>>(*db);
+        checkAgainstSchema<core::EntityTraits<core::Playlist>>(*db);
+        checkAgainstSchema<core::EntityTraits<core::HistoryPlayback>>(*db);
+    }
+
+    TEST_CASE("EntityTraits: lê as colunas pelo ordinal com o tipo declarado") {
+        SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        SQLite::Statement query(db, "SELECT 7, 'Gilberto Gil', 3;");
+        REQUIRE(query.executeStep());
+
+        unsigned id = ArtistColumns::read<ArtistColumns::Id>(query);
+        std::string name = ArtistColumns::read<ArtistColumns::Name>(query);
+        unsigned user_id = ArtistColumns::read<ArtistColumns::UserId>(query);
+
+        CHECK(id == 7);
+        CHECK(name == "Gilberto Gil");
+        CHECK(user_id == 3);
+    }
+}
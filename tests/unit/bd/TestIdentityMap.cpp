@@ -0,0 +1,72 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+
+#include "core/bd/IdentityMap.hpp"
+#include "core/entities/User.hpp"
+
+TEST_SUITE("Unit Tests - IdentityMap") {
+    TEST_CASE("IdentityMap: mantém a primeira instância registrada") {
+        core::IdentityMap<core::User> map;
+
+        auto first = std::make_shared<core::User>("usuario1");
+        auto second = std::make_shared<core::User>("usuario1");
+
+        CHECK(map.insert(1, first).get() == first.get());
+        CHECK(map.insert(1, second).get() == first.get());
+        CHECK(map.find(1).get() == first.get());
+        CHECK(map.find(2) == nullptr);
+
+        auto stats = map.getStats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.size == 1);
+    }
+
+    TEST_CASE("IdentityMap: descarta a entidade usada há mais tempo") {
+        core::IdentityMap<core::User> map(2);
+
+        map.insert(1, std::make_shared<core::User>("u1"));
+        map.insert(2, std::make_shared<core::User>("u2"));
+        CHECK(map.find(1) != nullptr);
+
+        map.insert(3, std::make_shared<core::User>("u3"));
+
+        CHECK(map.find(1) != nullptr);
+        CHECK(map.find(2) == nullptr);
+        CHECK(map.find(3) != nullptr);
+        CHECK(map.getStats().evictions == 1);
+    }
+
+    TEST_CASE("IdentityMap: capacidade zero desativa o mapa") {
+        core::IdentityMap<core::User> map(0);
+
+        auto user = std::make_shared<core::User>("u1");
+        CHECK(map.insert(1, user).get() == user.get());
+        CHECK(map.find(1) == nullptr);
+        CHECK(map.size() == 0);
+    }
+
+    TEST_CASE("IdentityMap: invalidate remove a entidade") {
+        core::IdentityMap<core::User> map;
+
+        map.insert(1, std::make_shared<core::User>("u1"));
+        map.invalidate(1);
+
+        CHECK(map.find(1) == nullptr);
+        CHECK(map.size() == 0);
+    }
+
+    TEST_CASE("IdentityMap: sync esvazia o mapa quando a versão muda") {
+        core::IdentityMap<core::User> map;
+
+        map.sync(1);
+        map.insert(1, std::make_shared<core::User>("u1"));
+
+        CHECK_FALSE(map.sync(1));
+        CHECK(map.find(1) != nullptr);
+
+        CHECK(map.sync(2));
+        CHECK(map.find(1) == nullptr);
+    }
+}
@@ -0,0 +1,200 @@
+#include <doctest/doctest.h>
+
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/ListeningStats.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/HistoryPlayback.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - ListeningStats") {
+    // 2023-11-14 00:00:00 UTC
+    const std::time_t DAY_START = 1699920000;
+
+    struct ListeningStatsFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        core::Artist first_artist;
+        core::Artist second_artist;
+
+        ListeningStatsFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("stats_user");
+            core::UserRepository(db).save(user);
+
+            first_artist = core::Artist(0, "Gal Costa", user);
+            second_artist = core::Artist(0, "Tim Maia", user);
+            core::ArtistRepository artist_repo(db);
+            artist_repo.save(first_artist);
+            artist_repo.save(second_artist);
+        }
+
+        core::Song saveSong(const std::string& title, const core::Artist& artist) {
+            core::Song song(0, title, artist.getId());
+            song.setDuration(200);
+            song.setUser(user);
+            core::SongRepository(db).save(song);
+            return song;
+        }
+
+        core::HistoryPlayback play(core::Song& song,
+                                   std::time_t played_at,
+                                   unsigned play_duration) {
+            core::HistoryPlayback entry;
+            entry.setUser(user);
+            entry.setSong(song);
+            entry.setPlayedAt(played_at);
+            entry.setPlayDuration(play_duration);
+            core::HistoryPlaybackRepository(db).save(entry);
+            return entry;
+        }
+    };
+
+    TEST_CASE_FIXTURE(ListeningStatsFixture,
+                      "ListeningStats: ranking de músicas e artistas") {
+        auto first = saveSong("Baby", first_artist);
+        auto second = saveSong("Vapor barato", first_artist);
+        auto third = saveSong("Azul da cor do mar", second_artist);
+
+        play(first, DAY_START, 100);
+        play(second, DAY_START + 10, 100);
+        play(second, DAY_START + 20, 100);
+        play(third, DAY_START + 30, 50);
+
+        core::ListeningStats stats(db);
+
+        auto songs = stats.topSongs(user.getId());
+        REQUIRE(songs.size() == 3);
+        CHECK(songs[0].id == second.getId());
+        CHECK(songs[0].play_count == 2);
+        CHECK(songs[0].listen_seconds == 200);
+
+        auto artists = stats.topArtists(user.getId(), 1);
+        REQUIRE(artists.size() == 1);
+        CHECK(artists[0].id == first_artist.getId());
+        CHECK(artists[0].play_count == 3);
+
+        core::HistoryPlaybackRepository history_repo(db);
+        CHECK(history_repo.countPlaybacksBySongAndUser(second, user) == 2);
+        CHECK(stats.playCount(user.getId(), third.getId()) == 1);
+    }
+
+    TEST_CASE_FIXTURE(ListeningStatsFixture,
+                      "ListeningStats: tempo ouvido por período") {
+        auto song = saveSong("Índia", first_artist);
+
+        play(song, DAY_START + 3600, 120);
+        play(song, DAY_START + 7200, 60);
+        play(song, DAY_START + STATS_SECONDS_PER_DAY + 60, 30);
+
+        core::ListeningStats stats(db);
+
+        auto days = stats.listeningByDay(user.getId(),
+                                         DAY_START,
+                                         DAY_START + 2 * STATS_SECONDS_PER_DAY);
+        REQUIRE(days.size() == 2);
+        CHECK(days[0].day == DAY_START);
+        CHECK(days[0].play_count == 2);
+        CHECK(days[0].listen_seconds == 180);
+        CHECK(days[1].listen_seconds == 30);
+
+        CHECK(stats.listeningTime(user.getId(),
+                                  DAY_START,
+                                  DAY_START + STATS_SECONDS_PER_DAY) == 180);
+        CHECK(stats.listeningTime(user.getId(),
+                                  DAY_START,
+                                  DAY_START + 2 * STATS_SECONDS_PER_DAY) == 210);
+    }
+
+    TEST_CASE_FIXTURE(ListeningStatsFixture,
+                      "ListeningStats: remover histórico desconta os totais") {
+        auto song = saveSong("Meu bem, meu mal", first_artist);
+        play(song, DAY_START, 100);
+        auto last = play(song, DAY_START + 60, 40);
+
+        core::HistoryPlaybackRepository history_repo(db);
+        REQUIRE(history_repo.remove(last.getId()));
+
+        core::ListeningStats stats(db);
+        CHECK(stats.playCount(user.getId(), song.getId()) == 1);
+        CHECK(stats.topArtists(user.getId())[0].listen_seconds == 100);
+
+        core::SongRepository(db).remove(song.getId());
+        CHECK(stats.topSongs(user.getId()).empty());
+        CHECK(stats.topArtists(user.getId()).empty());
+        CHECK(stats.listeningTime(user.getId(),
+                                  DAY_START,
+                                  DAY_START + STATS_SECONDS_PER_DAY) == 0);
+    }
+
+    TEST_CASE_FIXTURE(ListeningStatsFixture,
+                      "ListeningStats: editar histórico move os totais") {
+        core::Album album(0, "Fa-Tal", 1971, "MPB", first_artist);
+        album.setUser(user);
+        core::AlbumRepository(db).save(album);
+
+        core::Song first(0, "Vapor barato", first_artist.getId());
+        first.setDuration(200);
+        first.setUser(user);
+        first.setAlbumId(album.getId());
+        core::SongRepository(db).save(first);
+        auto second = saveSong("Primavera", second_artist);
+
+        auto entry = play(first, DAY_START, 100);
+        entry.setSong(second);
+        entry.setPlayedAt(DAY_START + STATS_SECONDS_PER_DAY + 60);
+        entry.setPlayDuration(40);
+        REQUIRE(core::HistoryPlaybackRepository(db).save(entry));
+
+        core::ListeningStats stats(db);
+        CHECK(stats.playCount(user.getId(), first.getId()) == 0);
+        CHECK(stats.playCount(user.getId(), second.getId()) == 1);
+
+        auto songs = stats.topSongs(user.getId());
+        REQUIRE(songs.size() == 1);
+        CHECK(songs[0].id == second.getId());
+        CHECK(songs[0].listen_seconds == 40);
+
+        auto artists = stats.topArtists(user.getId());
+        REQUIRE(artists.size() == 1);
+        CHECK(artists[0].id == second_artist.getId());
+        CHECK(artists[0].play_count == 1);
+        CHECK(artists[0].listen_seconds == 40);
+
+        CHECK(stats.topAlbums(user.getId()).empty());
+
+        auto days = stats.listeningByDay(user.getId(),
+                                         DAY_START,
+                                         DAY_START + 2 * STATS_SECONDS_PER_DAY);
+        REQUIRE(days.size() == 1);
+        CHECK(days[0].day == DAY_START + STATS_SECONDS_PER_DAY);
+        CHECK(days[0].play_count == 1);
+        CHECK(days[0].listen_seconds == 40);
+
+        auto play_count = [this](const core::Song& song) {
+            SQLite::Statement query(*db, "SELECT play_count FROM songs WHERE id = ?;");
+            query.bind(1, song.getId());
+            REQUIRE(query.executeStep());
+            return query.getColumn(0).getInt();
+        };
+        CHECK(play_count(first) == 0);
+        CHECK(play_count(second) == 1);
+    }
+}
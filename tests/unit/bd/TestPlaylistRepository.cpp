@@ -0,0 +1,192 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - PlaylistRepository") {
+    struct PlaylistRepositoryFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        std::vector<core::Song> songs;
+        core::Playlist playlist;
+
+        PlaylistRepositoryFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("playlist_user");
+            core::UserRepository(db).save(user);
+
+            core::Artist artist(0, "Novos Baianos", user);
+            core::ArtistRepository(db).save(artist);
+
+            core::SongRepository song_repo(db);
+            for (int i = 1; i <= 8; ++i) {
+                core::Song song(0, "Faixa " + std::to_string(i), artist.getId());
+                song.setUser(user);
+                song_repo.save(song);
+                songs.push_back(song);
+            }
+
+            playlist = core::Playlist(0, "Acabou Chorare", user);
+            for (const auto& song : songs)
+                playlist.addSong(song);
+            core::PlaylistRepository(db).save(playlist);
+        }
+
+        std::vector<unsigned> loadedOrder(core::PlaylistRepository& repo) {
+            std::vector<unsigned> ids;
+            auto loaded = repo.findById(playlist.getId());
+            REQUIRE(loaded);
+            for (const auto& song : loaded->getSongs())
+                ids.push_back(song->getId());
+            return ids;
+        }
+
+        std::map<unsigned, int64_t> storedPositions() {
+            std::map<unsigned, int64_t> positions;
+            SQLite::Statement query(*db,
+                                    "SELECT song_id, position FROM playlist_songs "
+                                    "WHERE playlist_id = ?;");
+            query.bind(1, playlist.getId());
+            while (query.executeStep())
+                positions[query.getColumn(0).getUInt()] = query.getColumn(1).getInt64();
+            return positions;
+        }
+
+        static size_t changedRows(const std::map<unsigned, int64_t>& before,
+                                  const std::map<unsigned, int64_t>& after) {
+            size_t changed = 0;
+            for (const auto& [song_id, position] : after) {
+                auto found = before.find(song_id);
+                if (found == before.end() || found->second != position)
+                    ++changed;
+            }
+            for (const auto& entry : before)
+                if (!after.count(entry.first))
+                    ++changed;
+            return changed;
+        }
+    };
+
+    TEST_CASE_FIXTURE(PlaylistRepositoryFixture,
+                      "PlaylistRepository: músicas são carregadas na ordem da playlist") {
+        core::PlaylistRepository repo(db);
+
+        std::vector<unsigned> expected;
+        for (const auto& song : songs)
+            expected.push_back(song.getId());
+
+        CHECK(loadedOrder(repo) == expected);
+        CHECK_FALSE(playlist.hasSongChanges());
+    }
+
+    TEST_CASE_FIXTURE(PlaylistRepositoryFixture,
+                      "PlaylistRepository: mover uma música grava só a própria linha") {
+        core::PlaylistRepository repo(db);
+        auto before = storedPositions();
+
+        auto loaded = repo.findById(playlist.getId());
+        REQUIRE(loaded);
+        loaded->moveSong(7, 0);
+        CHECK(loaded->hasSongChanges());
+        REQUIRE(repo.save(*loaded));
+        CHECK_FALSE(loaded->hasSongChanges());
+
+        CHECK(changedRows(before, storedPositions()) == 1);
+
+        std::vector<unsigned> expected {songs[7].getId()};
+        for (size_t i = 0; i < 7; ++i)
+            expected.push_back(songs[i].getId());
+        CHECK(loadedOrder(repo) == expected);
+    }
+
+    TEST_CASE_FIXTURE(PlaylistRepositoryFixture,
+                      "PlaylistRepository: inserções e remoções gravam só as linhas afetadas") {
+        core::PlaylistRepository repo(db);
+        auto before = storedPositions();
+
+        auto loaded = repo.findById(playlist.getId());
+        REQUIRE(loaded);
+        REQUIRE(loaded->removeSong(songs[2].getId()));
+        REQUIRE(loaded->removeSong(songs[5].getId()));
+        REQUIRE(repo.save(*loaded));
+
+        CHECK(changedRows(before, storedPositions()) == 2);
+
+        before = storedPositions();
+        loaded = repo.findById(playlist.getId());
+        REQUIRE(loaded);
+        REQUIRE(loaded->insert(songs[2], 1));
+        REQUIRE(repo.save(*loaded));
+
+        CHECK(changedRows(before, storedPositions()) == 1);
+
+        std::vector<unsigned> expected {songs[0].getId(), songs[2].getId(),
+                                        songs[1].getId(), songs[3].getId(),
+                                        songs[4].getId(), songs[6].getId(),
+                                        songs[7].getId()};
+        CHECK(loadedOrder(repo) == expected);
+    }
+
+    TEST_CASE_FIXTURE(PlaylistRepositoryFixture,
+                      "PlaylistRepository: renumera quando não há espaço entre posições") {
+        core::PlaylistRepository repo(db);
+
+        // Posições consecutivas, como as gravadas antes do espaçamento
+        SQLite::Statement compact(*db,
+                                  "UPDATE playlist_songs SET position = position / ? "
+                                  "WHERE playlist_id = ?;");
+        compact.bind(1, PLAYLIST_POSITION_GAP);
+        compact.bind(2, playlist.getId());
+        compact.exec();
+
+        auto loaded = repo.findById(playlist.getId());
+        REQUIRE(loaded);
+        loaded->moveSong(0, 3);
+        REQUIRE(repo.save(*loaded));
+
+        std::vector<unsigned> expected {songs[1].getId(), songs[2].getId(),
+                                        songs[3].getId(), songs[0].getId(),
+                                        songs[4].getId(), songs[5].getId(),
+                                        songs[6].getId(), songs[7].getId()};
+        CHECK(loadedOrder(repo) == expected);
+
+        auto positions = storedPositions();
+        for (size_t i = 0; i < expected.size(); ++i)
+            CHECK(positions[expected[i]] == static_cast<int64_t>(i + 1) * PLAYLIST_POSITION_GAP);
+    }
+
+    TEST_CASE_FIXTURE(PlaylistRepositoryFixture,
+                      "PlaylistRepository: atualizar o título não regrava as músicas") {
+        core::PlaylistRepository repo(db);
+        auto before = storedPositions();
+
+        auto loaded = repo.findById(playlist.getId());
+        REQUIRE(loaded);
+        loaded->setTitle("Preta Pretinha");
+        CHECK_FALSE(loaded->hasSongChanges());
+        REQUIRE(repo.save(*loaded));
+
+        CHECK(changedRows(before, storedPositions()) == 0);
+        CHECK(repo.findById(playlist.getId())->getTitle() == "Preta Pretinha");
+    }
+}
@@ -0,0 +1,126 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/QueryProfiler.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - QueryProfiler") {
+    struct QueryProfilerFixture {
+        ConfigFixture config;
+        std::string log_path;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+
+        QueryProfilerFixture() {
+            log_path = config.databasePath() + ".slow.log";
+            std::remove(log_path.c_str());
+
+            core::DatabaseSettings settings;
+            settings.profile = true;
+            settings.slow_query_ms = 0;
+            settings.slow_query_log = log_path;
+
+            core::QueryProfiler::instance().reset();
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath(), settings);
+            db = db_manager->getDatabase();
+        }
+
+        ~QueryProfilerFixture() {
+            auto& profiler = core::QueryProfiler::instance();
+            profiler.setSlowThreshold(
+                std::chrono::milliseconds(QUERY_PROFILER_SLOW_MS_DEFAULT));
+            profiler.setSlowQueryLog("");
+            profiler.reset();
+            std::remove(log_path.c_str());
+        }
+
+        const core::QueryProfiler::SqlStats* find(
+            const std::vector<core::QueryProfiler::SqlStats>& stats,
+            const std::string& sql) {
+            for (const auto& s : stats)
+                if (s.sql == sql)
+                    return &s;
+            return nullptr;
+        }
+    };
+
+    TEST_CASE_FIXTURE(QueryProfilerFixture,
+                      "QueryProfiler: agrega execuções e linhas por SQL") {
+        core::UserRepository repo(db);
+        core::userid uid = 1000;
+        for (const char* name : {"ana", "bia", "caio"}) {
+            core::User user;
+            user.setUsername(name);
+            user.setUID(uid++);
+            repo.save(user);
+        }
+
+        const std::string sql = "SELECT username FROM users ORDER BY username;";
+        for (int i = 0; i < 2; ++i) {
+            SQLite::Statement query(*db, sql);
+            while (query.executeStep()) {
+            }
+        }
+
+        auto stats = core::QueryProfiler::instance().snapshot();
+        auto* entry = find(stats, sql);
+        REQUIRE(entry != nullptr);
+        CHECK(entry->calls == 2);
+        CHECK(entry->rows == 6);
+        CHECK(entry->slow_calls == 2);
+
+        uint64_t bucketed = 0;
+        for (auto count : entry->histogram)
+            bucketed += count;
+        CHECK(bucketed == entry->calls);
+    }
+
+    TEST_CASE_FIXTURE(QueryProfilerFixture,
+                      "QueryProfiler: consultas lentas registram o plano") {
+        const std::string sql = "SELECT COUNT(*) FROM songs WHERE title = 'x';";
+        {
+            SQLite::Statement query(*db, sql);
+            query.executeStep();
+        }
+
+        auto& profiler = core::QueryProfiler::instance();
+        profiler.capturePending(*db);
+
+        auto stats = profiler.snapshot();
+        auto* entry = find(stats, sql);
+        REQUIRE(entry != nullptr);
+        CHECK(entry->plan.find("songs") != std::string::npos);
+
+        std::ifstream log(log_path);
+        std::string contents((std::istreambuf_iterator<char>(log)),
+                             std::istreambuf_iterator<char>());
+        CHECK(contents.find(sql) != std::string::npos);
+
+        // O próprio EXPLAIN não entra nas estatísticas
+        for (const auto& s : stats)
+            CHECK(s.sql.rfind("EXPLAIN", 0) != 0);
+
+        CHECK(profiler.report(stats.size()).find(sql) != std::string::npos);
+    }
+
+    TEST_CASE_FIXTURE(QueryProfilerFixture,
+                      "QueryProfiler: reset descarta as estatísticas") {
+        db->exec("SELECT 1;");
+        auto& profiler = core::QueryProfiler::instance();
+        CHECK_FALSE(profiler.snapshot().empty());
+
+        profiler.reset();
+        CHECK(profiler.snapshot().empty());
+    }
+}
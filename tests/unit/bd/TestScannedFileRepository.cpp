@@ -0,0 +1,121 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/ScannedFileRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/User.hpp"
+#include "core/util/FileFingerprint.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - ScannedFileRepository") {
+    struct ScannedFileFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+
+        ScannedFileFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("scan_user");
+            core::UserRepository(db).save(user);
+        }
+
+        core::FileFingerprint fingerprint(const std::string& path, uint64_t size) {
+            core::FileFingerprint result;
+            result.path = path;
+            result.size = size;
+            result.mtime = 1700000000000000000;
+            result.inode = 42;
+            result.hash_prefix = 0xFEDCBA9876543210ULL;
+            return result;
+        }
+    };
+
+    TEST_CASE_FIXTURE(ScannedFileFixture,
+                      "ScannedFileRepository: busca só os arquivos do diretório") {
+        core::ScannedFileRepository repo(db);
+
+        REQUIRE(repo.save(fingerprint("/input/ana/a.mp3", 100), user.getId()));
+        REQUIRE(repo.save(fingerprint("/input/ana/b.flac", 200), user.getId()));
+        REQUIRE(repo.save(fingerprint("/input/ana2/c.ogg", 300), user.getId()));
+
+        auto found = repo.findUnder("/input/ana/");
+        REQUIRE(found.size() == 2);
+        CHECK(found.count("/input/ana2/c.ogg") == 0);
+
+        const auto& stored = found.at("/input/ana/b.flac");
+        CHECK(stored.size == 200);
+        CHECK(stored.mtime == 1700000000000000000);
+        CHECK(stored.inode == 42);
+        CHECK(stored.hash_prefix == 0xFEDCBA9876543210ULL);
+        CHECK_FALSE(stored.failed);
+
+        REQUIRE(repo.find("/input/ana/b.flac"));
+        CHECK(repo.find("/input/ana/b.flac")->size == 200);
+        CHECK_FALSE(repo.find("/input/ana/z.mp3"));
+
+        auto changed = fingerprint("/input/ana/a.mp3", 150);
+        REQUIRE(repo.save(changed, user.getId()));
+        CHECK(repo.findUnder("/input/ana/").at("/input/ana/a.mp3").size == 150);
+
+        CHECK(repo.remove("/input/ana/a.mp3"));
+        CHECK_FALSE(repo.remove("/input/ana/a.mp3"));
+        CHECK(repo.findUnder("/input/ana/").size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(ScannedFileFixture,
+                      "ScannedFileRepository: guarda a falha de importação") {
+        core::ScannedFileRepository repo(db);
+
+        auto failed = fingerprint("/input/ana/quebrado.mp3", 100);
+        failed.failed = true;
+        REQUIRE(repo.save(failed, user.getId()));
+        REQUIRE(repo.find(failed.path));
+        CHECK(repo.find(failed.path)->failed);
+
+        // Lido de novo e rejeitado, o arquivo deixa de ser uma falha
+        failed.failed = false;
+        REQUIRE(repo.save(failed, user.getId()));
+        CHECK_FALSE(repo.findUnder("/input/ana/").at(failed.path).failed);
+
+        auto status = db->execAndGet("SELECT status FROM scanned_files WHERE path = "
+                                     "'/input/ana/quebrado.mp3';");
+        CHECK(status.getString() == "rejected");
+    }
+
+    TEST_CASE("FileFingerprint: detecta mudança de conteúdo com o mesmo tamanho") {
+        auto path = (std::filesystem::temp_directory_path()
+                     / "frankenstein_fingerprint_test.bin")
+                        .string();
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "conteudo original";
+        }
+
+        auto first = core::FileFingerprint::stat(path);
+        REQUIRE(first);
+        CHECK(first->size == 17);
+        CHECK(first->sameStat(*core::FileFingerprint::stat(path)));
+        uint64_t hash = core::FileFingerprint::hashPrefix(path);
+        CHECK(hash == core::FileFingerprint::hashPrefix(path));
+
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "conteudo alterado";
+        }
+        CHECK(core::FileFingerprint::stat(path)->size == first->size);
+        CHECK(core::FileFingerprint::hashPrefix(path) != hash);
+
+        std::filesystem::remove(path);
+        CHECK_FALSE(core::FileFingerprint::stat(path));
+    }
+}
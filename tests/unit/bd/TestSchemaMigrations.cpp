@@ -0,0 +1,112 @@
+#include <doctest/doctest.h>
+
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/SchemaMigrations.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - SchemaMigrations") {
+    /**
+     * @brief Junta espaços e quebras de linha seguidos em um só espaço
+     */
+    std::string normalizeSql(const std::string& sql) {
+        std::string normalized;
+        bool space = false;
+        for (char c : sql) {
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                space = !normalized.empty();
+                continue;
+            }
+            if (space)
+                normalized += ' ';
+            normalized += c;
+            space = false;
+        }
+        return normalized;
+    }
+
+    /**
+     * @brief Lista cada objeto do esquema com o SQL que o criou
+     */
+    std::vector<std::string> schemaObjects(SQLite::Database& db) {
+        std::vector<std::string> objects;
+        SQLite::Statement query(
+            db, "SELECT type || ' ' || name, COALESCE(sql, '') FROM sqlite_master "
+                "ORDER BY type, name;");
+        while (query.executeStep())
+            objects.push_back(query.getColumn(0).getString() + ": "
+                              + normalizeSql(query.getColumn(1).getString()));
+        return objects;
+    }
+
+    TEST_CASE("SchemaMigrations: banco novo fica na versão mais recente") {
+        ConfigFixture config;
+        core::DatabaseManager db_manager(config.databasePath(),
+                                         config.databaseSchemaPath());
+
+        CHECK(db_manager.getSchemaVersion()
+              == core::SchemaMigrations::latestVersion());
+        CHECK(core::SchemaMigrations::migrate(*db_manager.getDatabase()) == 0);
+    }
+
+    TEST_CASE("SchemaMigrations: banco sem versão é atualizado sem perder dados") {
+        SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        db.exec(core::SchemaMigrations::all().front().sql);
+        db.exec("INSERT INTO users (username, uid, home_path, input_path) "
+                "VALUES ('antigo', '1', '/home', '/input');");
+
+        CHECK(core::SchemaMigrations::currentVersion(db) == 0);
+        CHECK(core::SchemaMigrations::migrate(db)
+              == core::SchemaMigrations::latestVersion());
+        CHECK(db.execAndGet("SELECT COUNT(*) FROM users;").getInt() == 1);
+    }
+
+    TEST_CASE("SchemaMigrations: recusa banco de versão mais nova") {
+        SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        db.exec("PRAGMA user_version = "
+                + std::to_string(core::SchemaMigrations::latestVersion() + 1));
+
+        CHECK_THROWS(core::SchemaMigrations::migrate(db));
+    }
+
+    TEST_CASE("SchemaMigrations: migrações batem com o esquema de referência") {
+        ConfigFixture config;
+        std::ifstream file(config.databaseSchemaPath());
+        REQUIRE(file);
+        std::stringstream schema;
+        schema << file.rdbuf();
+
+        SQLite::Database reference(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        reference.exec(schema.str());
+
+        SQLite::Database migrated(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        core::SchemaMigrations::migrate(migrated);
+
+        auto migrated_objects = schemaObjects(migrated);
+        auto reference_objects = schemaObjects(reference);
+        REQUIRE(migrated_objects.size() == reference_objects.size());
+        for (size_t i = 0; i < migrated_objects.size(); ++i)
+            CHECK(migrated_objects[i] == reference_objects[i]);
+    }
+
+    TEST_CASE("SchemaMigrations: cabeçalho do esquema de referência traz a versão mais recente") {
+        ConfigFixture config;
+        std::ifstream file(config.databaseSchemaPath());
+        REQUIRE(file);
+        std::string header;
+        std::getline(file, header);
+
+        const std::string marker = "PRAGMA user_version = ";
+        auto at = header.find(marker);
+        REQUIRE(at != std::string::npos);
+        CHECK(std::stoi(header.substr(at + marker.size()))
+              == core::SchemaMigrations::latestVersion());
+    }
+}
@@ -0,0 +1,114 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SearchIndex.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - SearchIndex") {
+    struct SearchIndexFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        core::Artist artist;
+
+        SearchIndexFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("search_user");
+            core::UserRepository(db).save(user);
+
+            artist = core::Artist(0, "Caetano Veloso", user);
+            core::ArtistRepository(db).save(artist);
+        }
+
+        core::Song saveSong(const std::string& title) {
+            core::Song song(0, title, artist.getId());
+            song.setDuration(100);
+            song.setUser(user);
+            core::SongRepository(db).save(song);
+            return song;
+        }
+    };
+
+    TEST_CASE("SearchIndex: expressão MATCH com termos por prefixo") {
+        CHECK(core::SearchIndex::toMatchExpression("sozinho") == "\"sozinho\"*");
+        CHECK(core::SearchIndex::toMatchExpression("  meu  bem ")
+              == "\"meu\"* \"bem\"*");
+        CHECK(core::SearchIndex::toMatchExpression("a\"b OR") == "\"ab\"* \"OR\"*");
+        CHECK(core::SearchIndex::toMatchExpression(" - \"\" ").empty());
+    }
+
+    TEST_CASE_FIXTURE(SearchIndexFixture,
+                      "SearchIndex: triggers mantêm o índice das músicas") {
+        core::SongRepository repo(db);
+        auto song = saveSong("Você não entende nada");
+
+        auto found = repo.search("voce nao", user);
+        REQUIRE(found.size() == 1);
+        CHECK(found[0]->getId() == song.getId());
+
+        CHECK(repo.remove(song.getId()));
+        CHECK(repo.search("voce", user).empty());
+    }
+
+    TEST_CASE_FIXTURE(SearchIndexFixture,
+                      "SearchIndex: título pesa mais que o artista") {
+        core::SongRepository repo(db);
+        saveSong("Nine out of ten");
+        auto by_title = saveSong("Veloso");
+
+        auto found = repo.search("veloso", user);
+        REQUIRE(found.size() == 2);
+        CHECK(found[0]->getId() == by_title.getId());
+    }
+
+    TEST_CASE_FIXTURE(SearchIndexFixture,
+                      "SearchIndex: artista principal do álbum acompanha a relação") {
+        core::AlbumRepository albums(db);
+        core::Album album(0, "Tropicália", 1968, "MPB", artist);
+        REQUIRE(albums.save(album));
+        albums.setPrincipalArtist(album, artist, user);
+        CHECK(albums.search("caetano", user).size() == 1);
+
+        core::Artist other(0, "Gilberto Gil", user);
+        core::ArtistRepository(db).save(other);
+        std::string album_id = std::to_string(album.getId());
+        db->exec("UPDATE album_artists SET artist_id = " + std::to_string(other.getId())
+                 + " WHERE album_id = " + album_id + ";");
+        CHECK(albums.search("caetano", user).empty());
+        CHECK(albums.search("gilberto", user).size() == 1);
+
+        db->exec("DELETE FROM album_artists WHERE album_id = " + album_id + ";");
+        CHECK(albums.search("gilberto", user).empty());
+        CHECK(albums.search("tropicalia", user).size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(SearchIndexFixture,
+                      "SearchIndex: busca de playlists sem termos lista todas") {
+        core::PlaylistRepository repo(db);
+        core::Playlist first(0, "Playlist de Teste", user);
+        core::Playlist second(0, "Outra", user);
+        repo.save(first);
+        repo.save(second);
+
+        CHECK(repo.search("teste", user).size() == 1);
+        CHECK(repo.search("", user).size() == 2);
+    }
+}
@@ -177,4 +177,117 @@ TEST_SUITE("Unit Tests - core::SongRepository") {
         }
         CHECK(found_song3);
     }
+
+    TEST_CASE_FIXTURE(SongRepositoryFixture, "SongRepository: findById usa o mapa de identidade") {
+        core::SongRepository repo(db);
+        core::SongRepository other_repo(db);
+
+        core::User user;
+        user.setUsername("test_user");
+
+        core::Artist artist(0, "Artist 1", user);
+        setupUserAndArtist(user, artist);
+
+        core::Song song(0, "Música teste 1", artist.getId());
+        song.setDuration(100);
+        song.setUser(user);
+        CHECK(repo.save(song) == true);
+
+        auto first = repo.findById(song.getId());
+        auto second = other_repo.findById(song.getId());
+        REQUIRE(first != nullptr);
+        CHECK(first.get() == second.get());
+        CHECK(repo.getIdentityMapStats().hits >= 1);
+
+        song.setTitle("Título novo");
+        CHECK(repo.save(song) == true);
+
+        auto updated = other_repo.findById(song.getId());
+        REQUIRE(updated != nullptr);
+        CHECK(updated.get() != first.get());
+        CHECK(updated->getTitle() == "Título novo");
+
+        CHECK(repo.remove(song.getId()) == true);
+        CHECK(other_repo.findById(song.getId()) == nullptr);
+    }
+
+    TEST_CASE_FIXTURE(SongRepositoryFixture, "SongRepository: leitura incremental e paginação por chave") {
+        core::SongRepository repo(db);
+
+        core::User user;
+        user.setUsername("test_user");
+
+        core::Artist artist(0, "Artist 1", user);
+        setupUserAndArtist(user, artist);
+
+        for (int i = 0; i < 5; i++) {
+            core::Song song(0, "Música " + std::to_string(i), artist.getId());
+            song.setDuration(100);
+            song.setUser(user);
+            REQUIRE(repo.save(song) == true);
+        }
+
+        size_t seen = repo.forEachByUser(user, [](const std::shared_ptr<core::Song>&) {
+            return true;
+        });
+        CHECK(seen == 5);
+
+        size_t visited = 0;
+        repo.forEach([&visited](const std::shared_ptr<core::Song>&) {
+            return ++visited < 2;
+        });
+        CHECK(visited == 2);
+
+        auto first_page = repo.findByUser(user, 0, 2);
+        REQUIRE(first_page.size() == 2);
+        auto second_page = repo.findByUser(user, first_page.back()->getId(), 2);
+        REQUIRE(second_page.size() == 2);
+        CHECK(second_page.front()->getId() > first_page.back()->getId());
+        auto last_page = repo.getPage(second_page.back()->getId(), 2);
+        CHECK(last_page.size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(SongRepositoryFixture, "SongRepository: grava as propriedades do arquivo de áudio") {
+        core::SongRepository repo(db);
+
+        core::User user;
+        user.setUsername("test_user");
+
+        core::Artist artist(0, "Artist 1", user);
+        setupUserAndArtist(user, artist);
+
+        core::Song probed(0, "Com propriedades", artist.getId());
+        probed.setDuration(240);
+        probed.setUser(user);
+        probed.setBitrate(320);
+        probed.setSampleRate(44100);
+        probed.setFileSize(9600000);
+        REQUIRE(repo.save(probed));
+
+        core::Song unknown(0, "Sem propriedades", artist.getId());
+        unknown.setDuration(100);
+        unknown.setUser(user);
+        REQUIRE(repo.save(unknown));
+
+        SQLite::Statement query(*db, "SELECT file_size, bitrate, sample_rate FROM songs WHERE id = ?;");
+        query.bind(1, probed.getId());
+        REQUIRE(query.executeStep());
+        CHECK(query.getColumn(0).getInt64() == 9600000);
+        CHECK(query.getColumn(1).getInt() == 320);
+        CHECK(query.getColumn(2).getInt() == 44100);
+
+        query.reset();
+        query.bind(1, unknown.getId());
+        REQUIRE(query.executeStep());
+        CHECK(query.getColumn(0).isNull());
+        CHECK(query.getColumn(1).isNull());
+
+        auto loaded = repo.findByUser(user, 0, 2);
+        REQUIRE(loaded.size() == 2);
+        CHECK(loaded[0]->getBitrate() == 320);
+        CHECK(loaded[0]->getSampleRate() == 44100);
+        CHECK(loaded[0]->getFileSize() == 9600000);
+        CHECK(loaded[1]->getBitrate() == 0);
+        CHECK(loaded[1]->getFileSize() == 0);
+    }
 }
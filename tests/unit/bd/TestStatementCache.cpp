@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <sqlite3.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/StatementCache.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - StatementCache") {
+    std::unique_ptr<core::DatabaseManager> createTempDB() {
+        ConfigFixture config;
+        return std::unique_ptr<core::DatabaseManager>(new core::DatabaseManager(
+            config.databasePath(), config.databaseSchemaPath()));
+    }
+
+    TEST_CASE("StatementCache: reutiliza declarações pelo texto SQL") {
+        auto db_manager = createTempDB();
+        core::StatementCache cache(db_manager->getDatabase());
+
+        {
+            auto query = cache.acquire("SELECT COUNT(1) FROM users");
+            CHECK(query->executeStep());
+        }
+        {
+            auto query = cache.acquire("SELECT COUNT(1) FROM users");
+            CHECK(query->executeStep());
+        }
+
+        auto stats = cache.getStats();
+        CHECK(stats.misses == 1);
+        CHECK(stats.hits == 1);
+        CHECK(stats.size == 1);
+    }
+
+    TEST_CASE("StatementCache: consultas aninhadas recebem declarações distintas") {
+        auto db_manager = createTempDB();
+        core::StatementCache cache(db_manager->getDatabase());
+
+        auto outer = cache.acquire("SELECT COUNT(1) FROM users");
+        auto inner = cache.acquire("SELECT COUNT(1) FROM users");
+
+        CHECK(outer.get() != inner.get());
+        CHECK(cache.getStats().size == 1);
+    }
+
+    TEST_CASE("StatementCache: destruir o cache finaliza declarações emprestadas") {
+        auto db_manager = createTempDB();
+        auto db = db_manager->getDatabase();
+
+        auto open_statements = [&db]() {
+            size_t count = 0;
+            for (sqlite3_stmt* statement = sqlite3_next_stmt(db->getHandle(), nullptr);
+                 statement != nullptr;
+                 statement = sqlite3_next_stmt(db->getHandle(), statement))
+                count++;
+            return count;
+        };
+        size_t before = open_statements();
+
+        auto cache = std::make_unique<core::StatementCache>(db);
+        auto cached = cache->acquire("SELECT COUNT(1) FROM users");
+        auto nested = cache->acquire("SELECT COUNT(1) FROM users");
+        CHECK(cached->executeStep());
+        CHECK(nested->executeStep());
+        CHECK(open_statements() == before + 2);
+
+        cache.reset();
+        CHECK(open_statements() == before);
+
+        // Liberar os ponteiros depois do cache não toca na conexão
+        cached.reset();
+        nested.reset();
+        CHECK(open_statements() == before);
+    }
+
+    TEST_CASE("StatementCache: respeita a capacidade") {
+        auto db_manager = createTempDB();
+        core::StatementCache cache(db_manager->getDatabase(), 2);
+
+        cache.acquire("SELECT 1");
+        cache.acquire("SELECT 2");
+        cache.acquire("SELECT 3");
+
+        auto stats = cache.getStats();
+        CHECK(stats.size == 2);
+        CHECK(stats.evictions == 1);
+    }
+
+    TEST_CASE("StatementCache: consulta IDs em lotes de potência de dois") {
+        auto db_manager = createTempDB();
+        core::StatementCache cache(db_manager->getDatabase());
+
+        std::vector<unsigned> rows;
+        cache.forEachIdBatch(
+            {2, 3, 5},
+            "WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n "
+            "WHERE x < 10) SELECT x FROM n WHERE x IN (",
+            " ORDER BY x;",
+            [&rows](SQLite::Statement& query) {
+                rows.push_back(static_cast<unsigned>(query.getColumn(0).getInt()));
+            });
+
+        // Três IDs usam quatro marcadores, com o último ID repetido
+        CHECK(rows == std::vector<unsigned> {2, 3, 5});
+        CHECK(cache.getStats().size == 1);
+    }
+
+    TEST_CASE("StatementCache: repositórios da mesma conexão compartilham o cache") {
+        auto db_manager = createTempDB();
+        core::UserRepository repo(db_manager->getDatabase());
+        core::UserRepository other_repo(db_manager->getDatabase());
+
+        core::User user("usuario1");
+        #ifdef _WIN32
+            user.setUID("winuid1");
+        #else
+            user.setUID(101);
+        #endif
+        CHECK(repo.save(user) == true);
+
+        auto before = repo.getStatementCacheStats();
+        CHECK(repo.findById(user.getId()) != nullptr);
+        CHECK(other_repo.findById(user.getId()) != nullptr);
+        auto after = other_repo.getStatementCacheStats();
+
+        CHECK(after.hits > before.hits);
+    }
+}
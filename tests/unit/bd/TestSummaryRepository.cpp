@@ -0,0 +1,148 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/SummaryRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - SummaryRepository") {
+    struct SummaryRepositoryFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        core::User user;
+        core::Artist artist;
+        core::Album album;
+        core::Song first;
+        core::Song second;
+
+        SummaryRepositoryFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+
+            user.setUsername("summary_user");
+            core::UserRepository(db).save(user);
+
+            artist = core::Artist(0, "Jorge Ben", user);
+            core::ArtistRepository(db).save(artist);
+
+            album = core::Album(0, "África Brasil", 1976, "Samba rock", artist);
+            album.setUser(user);
+            core::AlbumRepository album_repo(db);
+            album_repo.save(album);
+            album_repo.setPrincipalArtist(album, artist, user);
+
+            first = saveSong("Taj Mahal", 200, album.getId());
+            second = saveSong("Ponta de lança africano", 250, 0);
+        }
+
+        core::Song saveSong(const std::string& title,
+                            unsigned duration,
+                            unsigned album_id) {
+            core::Song song(0, title, artist.getId());
+            song.setDuration(duration);
+            song.setUser(user);
+            if (album_id != 0)
+                song.setAlbumId(album_id);
+            core::SongRepository(db).save(song);
+            return song;
+        }
+    };
+
+    TEST_CASE_FIXTURE(SummaryRepositoryFixture,
+                      "SummaryRepository: busca de músicas traz artista e álbum") {
+        core::SummaryRepository repo(db);
+
+        auto songs = repo.searchSongs("taj", user.getId());
+        REQUIRE(songs.size() == 1);
+        CHECK(songs[0].id == first.getId());
+        CHECK(songs[0].title == "Taj Mahal");
+        CHECK(songs[0].artist == "Jorge Ben");
+        CHECK(songs[0].album == "África Brasil");
+        CHECK(songs[0].duration == 200);
+
+        CHECK(repo.searchSongs("", user.getId()).size() == 2);
+    }
+
+    TEST_CASE_FIXTURE(SummaryRepositoryFixture,
+                      "SummaryRepository: resumos de álbuns e artistas") {
+        core::SummaryRepository repo(db);
+
+        auto albums = repo.searchAlbums("africa", user.getId());
+        REQUIRE(albums.size() == 1);
+        CHECK(albums[0].artist == "Jorge Ben");
+        CHECK(albums[0].year == 1976);
+        CHECK(albums[0].songs_count == 1);
+
+        auto artists = repo.searchArtists("jorge", user.getId());
+        REQUIRE(artists.size() == 1);
+        CHECK(artists[0].songs_count == 2);
+    }
+
+    TEST_CASE_FIXTURE(SummaryRepositoryFixture,
+                      "SummaryRepository: álbum com dois artistas principais") {
+        core::Artist other(0, "Gilberto Gil", user);
+        core::ArtistRepository(db).save(other);
+
+        // setPrincipalArtist troca o principal; a segunda linha entra direto
+        SQLite::Statement insert(*db,
+                                 "INSERT INTO album_artists "
+                                 "(album_id, artist_id, user_id, is_principal) "
+                                 "VALUES (?, ?, ?, 1);");
+        insert.bind(1, album.getId());
+        insert.bind(2, other.getId());
+        insert.bind(3, user.getId());
+        REQUIRE(insert.exec() == 1);
+
+        core::SummaryRepository repo(db);
+
+        auto albums = repo.searchAlbums("africa", user.getId());
+        REQUIRE(albums.size() == 1);
+        CHECK(albums[0].artist == "Jorge Ben");
+        CHECK(albums[0].songs_count == 1);
+
+        CHECK(repo.searchAlbums("", user.getId()).size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(SummaryRepositoryFixture,
+                      "SummaryRepository: resumos por IDs mantêm a ordem") {
+        core::SummaryRepository repo(db);
+
+        std::vector<unsigned> ids {second.getId(), 9999, first.getId(), second.getId()};
+        auto songs = repo.songsByIds(ids);
+        REQUIRE(songs.size() == 3);
+        CHECK(songs[0].id == second.getId());
+        CHECK(songs[0].album.empty());
+        CHECK(songs[1].id == first.getId());
+        CHECK(songs[2].id == second.getId());
+    }
+
+    TEST_CASE_FIXTURE(SummaryRepositoryFixture,
+                      "SummaryRepository: músicas da playlist na ordem") {
+        core::Playlist playlist(0, "Favoritas", user);
+        playlist.addSong(second);
+        playlist.addSong(first);
+        core::PlaylistRepository(db).save(playlist);
+
+        core::SummaryRepository repo(db);
+        auto songs = repo.playlistSongs(playlist.getId());
+        REQUIRE(songs.size() == 2);
+        CHECK(songs[0].id == second.getId());
+        CHECK(songs[1].id == first.getId());
+    }
+}
@@ -0,0 +1,114 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <sqlite3.h>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/RepositoryFactory.hpp"
+#include "core/bd/UnitOfWork.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - UnitOfWork") {
+    struct UnitOfWorkFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        std::unique_ptr<core::RepositoryFactory> factory;
+        core::User user;
+
+        UnitOfWorkFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+            factory = std::make_unique<core::RepositoryFactory>(db);
+
+            user.setUsername("uow_user");
+            factory->createUserRepository()->save(user);
+        }
+
+        int countRows(const std::string& table) {
+            return db->execAndGet("SELECT COUNT(*) FROM " + table + ";").getInt();
+        }
+
+        void importSong(const std::string& artistName, const std::string& title) {
+            core::Artist artist(0, artistName, user);
+            REQUIRE(factory->createArtistRepository()->save(artist));
+
+            core::Song song(0, title, artist.getId());
+            song.setUser(user);
+            REQUIRE(factory->createSongRepository()->save(song));
+        }
+    };
+
+    TEST_CASE_FIXTURE(UnitOfWorkFixture,
+                      "UnitOfWork: confirma as escritas de vários repositórios") {
+        auto unit = factory->createUnitOfWork();
+        CHECK_FALSE(unit->isNested());
+
+        importSong("Gal Costa", "Baby");
+        unit->commit();
+
+        CHECK_FALSE(unit->isActive());
+        CHECK(countRows("artists") == 1);
+        CHECK(countRows("songs") == 1);
+        CHECK_THROWS_AS(unit->commit(), std::runtime_error);
+    }
+
+    TEST_CASE_FIXTURE(UnitOfWorkFixture,
+                      "UnitOfWork: desfaz no destrutor quando não é confirmada") {
+        try {
+            core::UnitOfWork unit(db);
+            importSong("Caetano Veloso", "Alegria, Alegria");
+            throw std::runtime_error("falha no meio da importação");
+        } catch (const std::runtime_error&) {
+        }
+
+        CHECK(countRows("artists") == 0);
+        CHECK(countRows("songs") == 0);
+        CHECK(sqlite3_get_autocommit(db->getHandle()) != 0);
+    }
+
+    TEST_CASE_FIXTURE(UnitOfWorkFixture,
+                      "UnitOfWork: unidades aninhadas usam savepoints") {
+        core::UnitOfWork batch(db);
+        importSong("Jorge Ben", "Taj Mahal");
+
+        {
+            core::UnitOfWork file(db);
+            CHECK(file.isNested());
+            importSong("Tim Maia", "Azul da Cor do Mar");
+            file.rollback();
+        }
+
+        {
+            core::UnitOfWork file(db);
+            importSong("Elis Regina", "Como Nossos Pais");
+            file.commit();
+        }
+
+        batch.commit();
+
+        CHECK(countRows("songs") == 2);
+        CHECK(db->execAndGet("SELECT COUNT(*) FROM artists WHERE name = 'Tim Maia';")
+                  .getInt() == 0);
+    }
+
+    TEST_CASE_FIXTURE(UnitOfWorkFixture,
+                      "UnitOfWork: desfazer a unidade de fora descarta as de dentro") {
+        {
+            core::UnitOfWork batch(db);
+            core::UnitOfWork file(db);
+            importSong("Chico Buarque", "Construção");
+            file.commit();
+        }
+
+        CHECK(countRows("songs") == 0);
+    }
+}
@@ -7,6 +7,7 @@
 #include <cstdio>
 
 #include "core/bd/DatabaseManager.hpp"
+#include "core/bd/UnitOfWork.hpp"
 #include "core/bd/UserRepository.hpp"
 #include "core/entities/User.hpp"
 
@@ -187,4 +188,99 @@ TEST_SUITE("Unit Tests - UserRepository") {
         CHECK(found_user != nullptr);
         CHECK(found_user->getUsername() == "usuario1");
     }
+
+    TEST_CASE("UserRepository: findSharedById compartilha a instância na conexão") {
+        auto db_manager = createTempDB();
+        core::UserRepository repo(db_manager->getDatabase());
+        core::UserRepository other_repo(db_manager->getDatabase());
+
+        core::User user("usuario1");
+        #ifdef _WIN32
+            user.setUID("winuid1");
+        #else
+            user.setUID(101);
+        #endif
+        CHECK(repo.save(user) == true);
+
+        auto first = repo.findSharedById(user.getId());
+        auto second = other_repo.findSharedById(user.getId());
+        REQUIRE(first != nullptr);
+        CHECK(first.get() == second.get());
+
+        user.setUsername("renomeado");
+        CHECK(repo.save(user) == true);
+
+        auto updated = other_repo.findSharedById(user.getId());
+        REQUIRE(updated != nullptr);
+        CHECK(updated.get() != first.get());
+        CHECK(updated->getUsername() == "renomeado");
+
+        CHECK(repo.remove(user.getId()) == true);
+        CHECK(other_repo.findSharedById(user.getId()) == nullptr);
+    }
+
+    TEST_CASE("UserRepository: findSharedById descarta o usuário desfeito") {
+        auto db_manager = createTempDB();
+        auto db = db_manager->getDatabase();
+        core::UserRepository repo(db);
+
+        core::User user("usuario1");
+        #ifdef _WIN32
+            user.setUID("winuid1");
+        #else
+            user.setUID(101);
+        #endif
+        CHECK(repo.save(user) == true);
+
+        {
+            core::UnitOfWork unit(db);
+            user.setUsername("provisorio");
+            CHECK(repo.save(user) == true);
+            CHECK(repo.findSharedById(user.getId())->getUsername() == "provisorio");
+            unit.rollback();
+        }
+
+        auto shared = repo.findSharedById(user.getId());
+        REQUIRE(shared != nullptr);
+        CHECK(shared->getUsername() == "usuario1");
+    }
+
+    TEST_CASE("UserRepository: insertMany grava em lote e devolve os IDs") {
+        core::UserRepository repo(createTempDB()->getDatabase());
+
+        std::vector<core::User> users;
+        for (int i = 0; i < 3; ++i) {
+            core::User user("lote" + std::to_string(i));
+            #ifdef _WIN32
+                user.setUID("winuid" + std::to_string(i));
+            #else
+                user.setUID(300 + i);
+            #endif
+            users.push_back(user);
+        }
+
+        CHECK(repo.insertMany(users) == true);
+        CHECK(repo.count() == 3);
+        for (const auto& user : users)
+            CHECK(user.getId() != 0);
+    }
+
+    TEST_CASE("UserRepository: saveMany desfaz o lote inteiro em caso de erro") {
+        core::UserRepository repo(createTempDB()->getDatabase());
+
+        std::vector<std::shared_ptr<core::User>> users;
+        for (int i = 0; i < 2; ++i) {
+            auto user = std::make_shared<core::User>("repetido");
+            #ifdef _WIN32
+                user->setUID("winuid" + std::to_string(i));
+            #else
+                user->setUID(400 + i);
+            #endif
+            users.push_back(user);
+        }
+
+        CHECK_THROWS(repo.saveMany(users));
+        CHECK(repo.count() == 0);
+        CHECK(users[0]->getId() == 0);
+    }
 }
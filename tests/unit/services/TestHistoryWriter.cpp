@@ -0,0 +1,113 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/bd/UserRepository.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/HistoryPlayback.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/HistoryWriter.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - HistoryWriter") {
+    struct HistoryWriterFixture {
+        ConfigFixture config;
+        std::unique_ptr<core::DatabaseManager> db_manager;
+        std::shared_ptr<SQLite::Database> db;
+        std::shared_ptr<core::HistoryPlaybackRepository> history_repo;
+        core::User user;
+        core::Song song;
+
+        HistoryWriterFixture() {
+            db_manager = std::make_unique<core::DatabaseManager>(
+                config.databasePath(), config.databaseSchemaPath());
+            db = db_manager->getDatabase();
+            history_repo = std::make_shared<core::HistoryPlaybackRepository>(db);
+
+            user.setUsername("history_user");
+            core::UserRepository user_repo(db);
+            user_repo.save(user);
+
+            core::Artist artist(0, "The Void", user);
+            core::ArtistRepository artist_repo(db);
+            artist_repo.save(artist);
+
+            song = core::Song(0, "Música teste", artist.getId());
+            song.setDuration(100);
+            song.setUser(user);
+            core::SongRepository song_repo(db);
+            song_repo.save(song);
+        }
+
+        core::HistoryPlayback createEntry(unsigned play_duration) {
+            core::HistoryPlayback entry;
+            entry.setUser(user);
+            entry.setSong(song);
+            entry.setPlayedAt(std::time(nullptr));
+            entry.setPlayDuration(play_duration);
+            return entry;
+        }
+    };
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture,
+                      "HistoryWriter: flush grava os registros pendentes") {
+        core::HistoryWriter writer(history_repo, 16, 8,
+                                   std::chrono::milliseconds(60000));
+
+        writer.record(createEntry(30));
+        writer.record(createEntry(45));
+        writer.flush();
+
+        CHECK(writer.pending() == 0);
+
+        auto history = history_repo->findByUser(user);
+        REQUIRE(history.size() == 2);
+        CHECK(history[0]->getPlayDuration() + history[1]->getPlayDuration()
+              == 75);
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture,
+                      "HistoryWriter: buffer cheio espera a gravação sem descartar") {
+        core::HistoryWriter writer(history_repo, 2, 8,
+                                   std::chrono::milliseconds(60000));
+
+        for (unsigned i = 1; i <= 5; ++i)
+            writer.record(createEntry(i));
+
+        writer.stop();
+        CHECK(history_repo->findByUser(user).size() == 5);
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture,
+                      "HistoryWriter: destrutor grava o que estiver pendente") {
+        {
+            core::HistoryWriter writer(history_repo, 16, 8,
+                                       std::chrono::milliseconds(60000));
+            writer.record(createEntry(10));
+        }
+
+        CHECK(history_repo->findByUser(user).size() == 1);
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture,
+                      "HistoryWriter: registro após stop é gravado diretamente") {
+        core::HistoryWriter writer(history_repo, 16, 8,
+                                   std::chrono::milliseconds(60000));
+        writer.record(createEntry(10));
+        writer.stop();
+
+        writer.record(createEntry(20));
+        writer.flush();
+
+        CHECK(writer.pending() == 0);
+        CHECK(history_repo->findByUser(user).size() == 2);
+    }
+}
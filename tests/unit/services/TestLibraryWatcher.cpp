@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/services/LibraryWatcher.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_SUITE("Unit Tests - LibraryWatcher") {
+    struct LibraryWatcherFixture {
+        fs::path directory;
+        std::mutex mutex;
+        std::condition_variable received;
+        std::vector<std::vector<std::string>> batches;
+
+        LibraryWatcherFixture() {
+            directory = fs::temp_directory_path() / "frankenstein_watcher_test";
+            fs::remove_all(directory);
+            fs::create_directories(directory);
+        }
+
+        ~LibraryWatcherFixture() {
+            fs::remove_all(directory);
+        }
+
+        core::LibraryWatcher::BatchHandler handler() {
+            return [this](const std::vector<std::string>& batch) {
+                std::lock_guard<std::mutex> lock(mutex);
+                batches.push_back(batch);
+                received.notify_all();
+            };
+        }
+
+        bool waitBatches(size_t count) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return received.wait_for(lock, std::chrono::seconds(5),
+                                     [&]() { return batches.size() >= count; });
+        }
+
+        void write(const fs::path& path, const std::string& content) {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << content;
+        }
+    };
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: agrupa os arquivos recebidos em um lote") {
+        if (!core::LibraryWatcher::isSupported())
+            return;
+
+        core::LibraryWatcher watcher(handler(), std::chrono::milliseconds(100));
+        REQUIRE(watcher.start({directory.string(), (directory / "inexistente").string()}));
+        CHECK(watcher.isRunning());
+        CHECK(watcher.getDirectories().size() == 1);
+
+        write(directory / "a.mp3", "primeira");
+        write(directory / "b.mp3", "segunda");
+        write(directory / "a.mp3", "reescrita");
+        fs::create_directory(directory / "album");
+
+        // Movido de fora: IN_MOVED_TO
+        auto outside = fs::temp_directory_path() / "frankenstein_watcher_c.mp3";
+        write(outside, "terceira");
+        fs::rename(outside, directory / "c.mp3");
+
+        REQUIRE(waitBatches(1));
+        watcher.stop();
+        CHECK_FALSE(watcher.isRunning());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        REQUIRE(batches.size() == 1);
+        auto batch = batches.front();
+        std::sort(batch.begin(), batch.end());
+        CHECK(batch == std::vector<std::string> {(directory / "a.mp3").string(),
+                                                 (directory / "b.mp3").string(),
+                                                 (directory / "c.mp3").string()});
+    }
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: lote cheio é entregue sem esperar o intervalo") {
+        if (!core::LibraryWatcher::isSupported())
+            return;
+
+        core::LibraryWatcher watcher(handler(), std::chrono::hours(1), 2);
+        REQUIRE(watcher.start({directory.string()}));
+
+        write(directory / "a.mp3", "a");
+        write(directory / "b.mp3", "b");
+
+        REQUIRE(waitBatches(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(batches.front().size() >= 2);
+    }
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: observa os subdiretórios") {
+        if (!core::LibraryWatcher::isSupported())
+            return;
+
+        fs::create_directories(directory / "Artista" / "Album");
+
+        core::LibraryWatcher watcher(handler(), std::chrono::milliseconds(100));
+        REQUIRE(watcher.start({directory.string()}));
+
+        // Subdiretório existente e subdiretório criado depois de start()
+        write(directory / "Artista" / "Album" / "a.mp3", "a");
+        fs::create_directories(directory / "Novo" / "Disco 1");
+        write(directory / "Novo" / "Disco 1" / "b.mp3", "b");
+
+        REQUIRE(waitBatches(1));
+        watcher.stop();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        REQUIRE(batches.size() == 1);
+        auto batch = batches.front();
+        std::sort(batch.begin(), batch.end());
+        CHECK(batch
+              == std::vector<std::string> {
+                  (directory / "Artista" / "Album" / "a.mp3").string(),
+                  (directory / "Novo" / "Disco 1" / "b.mp3").string()});
+    }
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: pasta movida pede varredura completa") {
+        if (!core::LibraryWatcher::isSupported())
+            return;
+
+        auto album = fs::temp_directory_path() / "frankenstein_watcher_album";
+        fs::remove_all(album);
+        fs::create_directories(album);
+        write(album / "faixa.mp3", "faixa");
+
+        core::LibraryWatcher watcher(handler(), std::chrono::milliseconds(50));
+        REQUIRE(watcher.start({directory.string()}));
+
+        write(directory / "solta.mp3", "solta");
+        fs::rename(album, directory / "album");
+
+        REQUIRE(waitBatches(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(batches.front().empty());
+    }
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: varredura pedida chega como lote vazio") {
+        if (!core::LibraryWatcher::isSupported())
+            return;
+
+        core::LibraryWatcher watcher(handler(), std::chrono::hours(1));
+        CHECK_FALSE(watcher.requestRescan());
+        REQUIRE(watcher.start({directory.string()}));
+
+        write(directory / "a.mp3", "a");
+        REQUIRE(watcher.requestRescan());
+
+        // Entregue sem esperar o intervalo, cobrindo o arquivo pendente
+        REQUIRE(waitBatches(1));
+        CHECK(watcher.isRunning());
+        watcher.stop();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        REQUIRE(batches.size() == 1);
+        CHECK(batches.front().empty());
+    }
+
+    TEST_CASE_FIXTURE(LibraryWatcherFixture,
+                      "LibraryWatcher: não observa diretórios inexistentes") {
+        core::LibraryWatcher watcher(handler());
+        CHECK_FALSE(watcher.start({(directory / "inexistente").string()}));
+        CHECK_FALSE(watcher.isRunning());
+        watcher.stop();
+    }
+}
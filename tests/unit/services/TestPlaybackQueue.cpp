@@ -18,7 +18,7 @@
 // CONSTRUTORES
 TEST_CASE_FIXTURE(PlaybackQueueFixture,
                   "PlaybackQueue - Construtor sem músicas cria fila vazia") {
-    core::PlaybackQueue queue(user, history_repo);
+    core::PlaybackQueue queue(user, history_writer);
 
     CHECK(queue.empty());
     CHECK(queue.size() == 0);
@@ -32,7 +32,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
         createSong("Song A"), createSong("Song B"), createSong("Song C")};
     MockPlayable playable(initial_songs);
 
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     CHECK_FALSE(queue.empty());
     CHECK(queue.size() == 3);
@@ -43,7 +43,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
 // TESTES DE ADIÇÃO
 TEST_CASE_FIXTURE(PlaybackQueueFixture,
                   "PlaybackQueue - Adicionar músicas via add()") {
-    core::PlaybackQueue queue(user, history_repo);
+    core::PlaybackQueue queue(user, history_writer);
 
     std::vector<std::shared_ptr<core::Song>> songs_to_add = {
         createSong("New Song 1"), createSong("New Song 2")};
@@ -57,7 +57,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
 
 TEST_CASE_FIXTURE(PlaybackQueueFixture,
                   "PlaybackQueue - Operador += adiciona músicas") {
-    core::PlaybackQueue queue(user, history_repo);
+    core::PlaybackQueue queue(user, history_writer);
 
     std::vector<std::shared_ptr<core::Song>> songs_to_add = {
         createSong("Song X"), createSong("Song Y")};
@@ -75,7 +75,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
     std::vector<std::shared_ptr<core::Song>> songs = {
         createSong("First"), createSong("Second"), createSong("Third")};
     MockPlayable playable(songs);
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     SUBCASE("Música inicial") {
         CHECK(queue.getCurrentSong()->getTitle() == "First");
@@ -109,7 +109,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
     std::vector<std::shared_ptr<core::Song>> songs = {
         createSong("Song 1"), createSong("Song 2"), createSong("Song 3")};
     MockPlayable playable(songs);
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     SUBCASE("Remover índice válido") {
         CHECK(queue.remove(1) == true);
@@ -133,7 +133,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
 
     std::vector<std::shared_ptr<core::Song>> songs = {song1, song2, song3};
     MockPlayable playable(songs);
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     SUBCASE("Encontrar próxima ocorrência") {
         //TODO Talvez trocar implementacao
@@ -159,7 +159,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
         songs.push_back(createSong("Song " + std::to_string(i)));
     }
     MockPlayable playable(songs);
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     SUBCASE("Visualização ao redor da música atual") {
         queue.next();
@@ -192,7 +192,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture,
     std::vector<std::shared_ptr<core::Song>> songs = {
         createSong("A"), createSong("B"), createSong("C")};
     MockPlayable playable(songs);
-    core::PlaybackQueue queue(user, playable, history_repo);
+    core::PlaybackQueue queue(user, playable, history_writer);
 
     SUBCASE("Ativar e desativar modo aleatório") {
         queue.setAleatory(true);
@@ -218,7 +218,7 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture, "PlaybackQueue - Limpar fila") {
     SUBCASE("Happy path") {
         MockPlayable playable(songs);
 
-        core::PlaybackQueue queue(user, playable, history_repo);
+        core::PlaybackQueue queue(user, playable, history_writer);
 
         CHECK(queue.size() == 2);
         queue.clear();
@@ -228,8 +228,29 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture, "PlaybackQueue - Limpar fila") {
     }
     SUBCASE("Playable vazio") {
         MockPlayable emptyPlayable(emptySong);
-        core::PlaybackQueue queue(user, emptyPlayable, history_repo);
+        core::PlaybackQueue queue(user, emptyPlayable, history_writer);
         //queue.empty retorna true se vazia
         CHECK(queue.empty());
     }
 }
+
+TEST_CASE_FIXTURE(PlaybackQueueFixture,
+                  "PlaybackQueue - Adicionar de uma consulta para quando a fila enche") {
+    core::PlaybackQueue queue(user, history_writer, 2);
+    size_t offered = 0;
+
+    size_t added = queue.add(
+        [this, &offered](const core::SongRepository::RowCallback& callback) {
+            for (int i = 0; i < 5; i++) {
+                offered++;
+                if (!callback(createSong("Song " + std::to_string(i))))
+                    break;
+            }
+            return offered;
+        });
+
+    CHECK(added == 2);
+    CHECK(offered == 3);
+    CHECK(queue.size() == 2);
+    CHECK_FALSE(queue.push(createSong("Extra")));
+}
@@ -0,0 +1,70 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/util/BoundedQueue.hpp"
+
+TEST_SUITE("Unit Tests - BoundedQueue") {
+    TEST_CASE("BoundedQueue: entrega os itens de vários produtores") {
+        core::BoundedQueue<int> queue(4);
+        std::atomic<int> running(3);
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < 3; ++p) {
+            producers.emplace_back([&queue, &running, p]() {
+                for (int i = 1; i <= 100; ++i)
+                    queue.push(p * 1000 + i);
+                if (--running == 0)
+                    queue.close();
+            });
+        }
+
+        long sum = 0;
+        size_t count = 0;
+        while (auto item = queue.pop()) {
+            CHECK(queue.size() <= 4);
+            sum += *item;
+            count++;
+        }
+
+        for (auto& producer : producers)
+            producer.join();
+
+        CHECK(count == 300);
+        CHECK(sum == 3 * 5050 + 100 * (1000 + 2000));
+    }
+
+    TEST_CASE("BoundedQueue: push espera enquanto a fila está cheia") {
+        core::BoundedQueue<int> queue(1);
+        REQUIRE(queue.push(1));
+
+        std::atomic<bool> pushed(false);
+        std::thread producer([&]() {
+            queue.push(2);
+            pushed = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK_FALSE(pushed);
+        CHECK(*queue.pop() == 1);
+
+        producer.join();
+        CHECK(pushed);
+        CHECK(*queue.pop() == 2);
+    }
+
+    TEST_CASE("BoundedQueue: fechada recusa itens e esvazia o restante") {
+        core::BoundedQueue<int> queue(2);
+        queue.push(7);
+        queue.close();
+
+        CHECK_FALSE(queue.push(8));
+        auto item = queue.pop();
+        REQUIRE(item);
+        CHECK(*item == 7);
+        CHECK_FALSE(queue.pop());
+    }
+}
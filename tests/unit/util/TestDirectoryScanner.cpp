@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "core/util/DirectoryScanner.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_SUITE("Unit Tests - DirectoryScanner") {
+    struct DirectoryScannerFixture {
+        fs::path root;
+
+        DirectoryScannerFixture() {
+            root = fs::temp_directory_path() / "frankenstein_scanner_test";
+            fs::remove_all(root);
+
+            // 3 artistas x 4 álbuns x (5 faixas + capa)
+            for (int artist = 0; artist < 3; ++artist) {
+                for (int album = 0; album < 4; ++album) {
+                    auto dir = root / ("Artista " + std::to_string(artist))
+                               / ("Album " + std::to_string(album));
+                    fs::create_directories(dir);
+                    for (int track = 0; track < 5; ++track)
+                        touch(dir / ("faixa" + std::to_string(track) + ".mp3"));
+                    touch(dir / "capa.JPG");
+                }
+            }
+            touch(root / "solta.FLAC");
+            touch(root / "leiame.txt");
+        }
+
+        ~DirectoryScannerFixture() {
+            fs::remove_all(root);
+        }
+
+        void touch(const fs::path& path) {
+            std::ofstream file(path);
+            file << "x";
+        }
+
+        std::set<std::string> scan(const core::DirectoryScanner& scanner) {
+            std::mutex mutex;
+            std::set<std::string> found;
+            size_t delivered = scanner.scan(root.string(), [&](const std::string& path) {
+                std::lock_guard<std::mutex> lock(mutex);
+                found.insert(path);
+                return true;
+            });
+            CHECK(delivered == found.size());
+            return found;
+        }
+    };
+
+    TEST_CASE_FIXTURE(DirectoryScannerFixture,
+                      "DirectoryScanner: percorre os subdiretórios filtrando as extensões") {
+        core::DirectoryScanner scanner({"mp3", ".flac"});
+        auto found = scan(scanner);
+
+        CHECK(found.size() == 3 * 4 * 5 + 1);
+        CHECK(found.count((root / "solta.FLAC").string()) == 1);
+        CHECK(found.count((root / "Artista 2" / "Album 3" / "faixa4.mp3").string()) == 1);
+        CHECK(found.count((root / "leiame.txt").string()) == 0);
+    }
+
+    TEST_CASE_FIXTURE(DirectoryScannerFixture,
+                      "DirectoryScanner: mesmo resultado com várias threads") {
+        auto sequential = scan(core::DirectoryScanner({"mp3"}, 1));
+        auto parallel = scan(core::DirectoryScanner({"mp3"}, 4));
+
+        CHECK(sequential.size() == 3 * 4 * 5);
+        CHECK(sequential == parallel);
+        CHECK(scan(core::DirectoryScanner({}, 4)).size() == 3 * 4 * 6 + 2);
+    }
+
+    TEST_CASE_FIXTURE(DirectoryScannerFixture,
+                      "DirectoryScanner: não segue links para diretórios") {
+        std::error_code error;
+        fs::create_directory_symlink(root / "Artista 0", root / "atalho", error);
+        if (error)
+            return;  // Sistema sem links simbólicos
+
+        CHECK(scan(core::DirectoryScanner({"mp3"}, 2)).size() == 3 * 4 * 5);
+    }
+
+    TEST_CASE_FIXTURE(DirectoryScannerFixture,
+                      "DirectoryScanner: tratador interrompe a varredura") {
+        core::DirectoryScanner scanner({"mp3"}, 4);
+        std::mutex mutex;
+        size_t calls = 0;
+        scanner.scan(root.string(), [&](const std::string&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return ++calls < 3;
+        });
+        CHECK(calls < 3 * 4 * 5);
+
+        CHECK_THROWS_AS(scanner.scan(root.string(),
+                                     [](const std::string&) -> bool {
+                                         throw std::runtime_error("falha");
+                                     }),
+                        std::runtime_error);
+        CHECK(scanner.scan((root / "inexistente").string(),
+                           [](const std::string&) { return true; })
+              == 0);
+    }
+
+    TEST_CASE("DirectoryScanner: compara extensões sem diferenciar maiúsculas") {
+        core::DirectoryScanner scanner({"MP3", ".ogg"});
+        CHECK(scanner.accepts("/musicas/faixa.mp3"));
+        CHECK(scanner.accepts("Faixa.OGG"));
+        CHECK_FALSE(scanner.accepts("capa.jpg"));
+        CHECK_FALSE(scanner.accepts("/pasta.mp3/arquivo"));
+        CHECK(core::DirectoryScanner().accepts("qualquer"));
+    }
+}